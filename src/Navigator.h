@@ -4,6 +4,7 @@
 // Dependencies within Micromouse
 #include "data.h"
 #include "driver.h"
+#include "user_interaction/Trace.h"
 
 // Everything in this file MUST be portable code.
 //
@@ -37,6 +38,16 @@ class Navigator
     Driver &driver;
     Maze<16, 16> maze;
 
+    // Confidence of the reading behind each wall decision, 0 to 255, for the
+    // north and east side of every cell. 0 means the wall has not been seen.
+    uint8_t wall_confidence_[16][16][2];
+
+    uint8_t& wallConfidence(int x, int y, Compass8 dir);
+
+    // Records what the driver sees in the given direction, unless an earlier
+    // reading of the same wall was more confident
+    void senseWall(Compass8 dir);
+
   public:
     Navigator();
 
@@ -67,31 +78,92 @@ class Navigator
 template <typename driver_type>
 Navigator<driver_type>::Navigator() : derived_driver(), driver(derived_driver)
 {
+  for (int y = 0; y < 16; y++) {
+    for (int x = 0; x < 16; x++) {
+      wall_confidence_[y][x][0] = 0;
+      wall_confidence_[y][x][1] = 0;
+    }
+  }
 }
 
 template <typename driver_type>
-void Navigator<driver_type>::updateMaze()
+uint8_t& Navigator<driver_type>::wallConfidence(int x, int y, Compass8 dir)
 {
-  if (driver.isWall(kNorth)) {
-    maze.addWall(driver.getX(), driver.getY(), kNorth);
-    driver.updateState(maze, driver.getX(), driver.getY() + 1);
+  // south and west walls are stored as the north and east walls of the
+  // neighboring cell
+  switch (dir) {
+    case kSouth:
+      return wall_confidence_[y - 1][x][0];
+    case kWest:
+      return wall_confidence_[y][x - 1][1];
+    case kEast:
+      return wall_confidence_[y][x][1];
+    default:
+      return wall_confidence_[y][x][0];
   }
+}
 
-  if (driver.isWall(kSouth)) {
-    maze.addWall(driver.getX(), driver.getY(), kSouth);
-    driver.updateState(maze, driver.getX(), driver.getY() - 1);
+template <typename driver_type>
+void Navigator<driver_type>::senseWall(Compass8 dir)
+{
+  int x = driver.getX();
+  int y = driver.getY();
+  int next_x = x;
+  int next_y = y;
+
+  switch (dir) {
+    case kNorth:
+      next_y++;
+      break;
+    case kSouth:
+      next_y--;
+      break;
+    case kEast:
+      next_x++;
+      break;
+    case kWest:
+      next_x--;
+      break;
+    default:
+      return;
   }
 
-  if (driver.isWall(kEast)) {
-    maze.addWall(driver.getX(), driver.getY(), kEast);
-    driver.updateState(maze, driver.getX() + 1, driver.getY());
-  }
+  bool is_wall = driver.isWall(dir);
 
-  if (driver.isWall(kWest)) {
-    maze.addWall(driver.getX(), driver.getY(), kWest);
-    driver.updateState(maze, driver.getX() - 1, driver.getY());
+  // the outside walls are never in doubt
+  if (next_x < 0 || next_x >= 16 || next_y < 0 || next_y >= 16)
+    return;
+
+  uint8_t confidence = 255 * driver.wallConfidence(dir);
+  uint8_t& old_confidence = wallConfidence(x, y, dir);
+
+  // a shaky reading never overrides a better one, and a confident reading
+  // corrects an earlier misread
+  if (confidence == 0 || confidence < old_confidence)
+    return;
+
+  old_confidence = confidence;
+
+  if (is_wall == maze.isWall(x, y, dir))
+    return;
+
+  if (is_wall) {
+    maze.addWall(x, y, dir);
+  } else {
+    maze.removeWall(x, y, dir);
   }
 
+  driver.updateState(maze, next_x, next_y);
+}
+
+template <typename driver_type>
+void Navigator<driver_type>::updateMaze()
+{
+  senseWall(kNorth);
+  senseWall(kSouth);
+  senseWall(kEast);
+  senseWall(kWest);
+
   maze.visit(driver.getX(), driver.getY());
   driver.updateState(maze, driver.getX(), driver.getY());
 }
@@ -150,11 +222,13 @@ void Navigator<driver_type>::findBox(int x, int y)
   while (driver.getX() != x || driver.getY() != y) {
     updateMaze();
 
+    TRACE_BEGIN("solve", 16 * driver.getX() + driver.getY());
     FloodFillPath<16, 16>
       flood_path(maze, driver.getX(), driver.getY(), x, y);
 
     KnownPath<16, 16>
       known_path(maze, driver.getX(), driver.getY(), x, y, flood_path);
+    TRACE_END("solve");
 
     if (known_path.isEmpty())
       break;
@@ -164,7 +238,9 @@ void Navigator<driver_type>::findBox(int x, int y)
 
   updateMaze();
 
+  TRACE_BEGIN("solve", 16 * driver.getX() + driver.getY());
   FloodFillPath<16, 16> path(maze, 0, 0, 0, 0);
+  TRACE_END("solve");
   driver.move(path);
 }
 
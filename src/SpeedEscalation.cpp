@@ -0,0 +1,93 @@
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "device/Orientation.h"
+#include "device/PersistantStorage.h"
+#include "user_interaction/Log.h"
+#include "conf.h"
+#include "driver.h"
+#include "SpeedEscalation.h"
+
+SpeedEscalation::RunReport SpeedEscalation::measureLastRun()
+{
+  Orientation& orientation = Orientation::getInstance();
+
+  RunReport report;
+  report.max_forward_accel = orientation.getMaxForwardAccel();
+  report.max_forward_decel = orientation.getMaxForwardDecel();
+  report.max_radial_accel = orientation.getMaxRadialAccel();
+  report.max_heading_error = KaosDriver::getMaxHeadingError();
+  report.max_position_error = KaosDriver::getMaxPositionError();
+  return report;
+}
+
+float SpeedEscalation::escalate(float limit, float usage, float low,
+                                float high)
+{
+  if (usage < ESCALATION_HEADROOM) {
+    limit *= 1 + ESCALATION_STEP;
+  } else if (usage > 1) {
+    limit *= 1 - ESCALATION_STEP;
+  }
+
+  return constrain(limit, low, high);
+}
+
+void SpeedEscalation::afterRun(const RunReport& report)
+{
+  float accel_usage = report.max_forward_accel / ESCALATION_TRACTION_LIMIT;
+  float decel_usage = report.max_forward_decel / ESCALATION_TRACTION_LIMIT;
+  float tracking_usage = report.max_position_error
+                         / ESCALATION_MAX_POSITION_ERROR;
+  float turn_usage = report.max_radial_accel / ESCALATION_TRACTION_LIMIT;
+  float heading_usage = report.max_heading_error
+                        / ESCALATION_MAX_HEADING_ERROR;
+  if (heading_usage > turn_usage) {
+    turn_usage = heading_usage;
+  }
+
+  LOG("Run peaks: %.2f m/s/s accel, %.2f m/s/s decel, %.2f m/s/s radial, "
+      "%.1f deg, %.1f mm\n",
+      report.max_forward_accel, report.max_forward_decel,
+      report.max_radial_accel, report.max_heading_error,
+      report.max_position_error);
+
+  PersistantStorage::setKaosAccel(escalate(
+      PersistantStorage::getKaosAccel(), accel_usage,
+      ESCALATION_MIN_ACCEL, ESCALATION_MAX_ACCEL));
+  PersistantStorage::setKaosDecel(escalate(
+      PersistantStorage::getKaosDecel(), decel_usage,
+      ESCALATION_MIN_ACCEL, ESCALATION_MAX_ACCEL));
+  PersistantStorage::setKaosForwardVelocity(escalate(
+      PersistantStorage::getKaosForwardVelocity(), tracking_usage,
+      ESCALATION_MIN_VELOCITY, ESCALATION_MAX_VELOCITY));
+  PersistantStorage::setKaosDiagVelocity(escalate(
+      PersistantStorage::getKaosDiagVelocity(), tracking_usage,
+      ESCALATION_MIN_VELOCITY, ESCALATION_MAX_VELOCITY));
+  PersistantStorage::setKaosTurnVelocity(escalate(
+      PersistantStorage::getKaosTurnVelocity(), turn_usage,
+      ESCALATION_MIN_VELOCITY, ESCALATION_MAX_VELOCITY));
+}
+
+void SpeedEscalation::afterCrash()
+{
+  const float backoff = 1 - ESCALATION_CRASH_BACKOFF;
+
+  LOG("Backing off speeds after a crash\n");
+
+  PersistantStorage::setKaosAccel(constrain(
+      PersistantStorage::getKaosAccel() * backoff,
+      ESCALATION_MIN_ACCEL, ESCALATION_MAX_ACCEL));
+  PersistantStorage::setKaosDecel(constrain(
+      PersistantStorage::getKaosDecel() * backoff,
+      ESCALATION_MIN_ACCEL, ESCALATION_MAX_ACCEL));
+  PersistantStorage::setKaosForwardVelocity(constrain(
+      PersistantStorage::getKaosForwardVelocity() * backoff,
+      ESCALATION_MIN_VELOCITY, ESCALATION_MAX_VELOCITY));
+  PersistantStorage::setKaosDiagVelocity(constrain(
+      PersistantStorage::getKaosDiagVelocity() * backoff,
+      ESCALATION_MIN_VELOCITY, ESCALATION_MAX_VELOCITY));
+  PersistantStorage::setKaosTurnVelocity(constrain(
+      PersistantStorage::getKaosTurnVelocity() * backoff,
+      ESCALATION_MIN_VELOCITY, ESCALATION_MAX_VELOCITY));
+}
@@ -0,0 +1,60 @@
+#ifndef MICROMOUSE_SPEED_ESCALATION_H_
+#define MICROMOUSE_SPEED_ESCALATION_H_
+
+// Raises the stored Kaos speeds between speed runs, and backs them off again
+// when a run goes past what the robot can follow
+//
+// Each limit is judged by what the last run measured:
+//
+//   accel                   peak forward acceleration against the traction
+//                           limit
+//   decel                   peak braking against the traction limit
+//   forward, diag velocity  worst wheel tracking error against
+//                           ESCALATION_MAX_POSITION_ERROR
+//   turn velocity           peak radial acceleration against the traction
+//                           limit, and worst heading error against
+//                           ESCALATION_MAX_HEADING_ERROR
+//
+// The accelerations are peaks of the moving average kept by AccelPeaks, so a
+// bump that lasts a packet or two does not back a speed off.
+//
+// A limit whose run stayed under ESCALATION_HEADROOM of its allowance is
+// raised by ESCALATION_STEP, and one that went over it is lowered by the same
+// share. A crash lowers all of them by ESCALATION_CRASH_BACKOFF. The results
+// are stored in PersistantStorage, so the next KaosDriver uses them.
+//
+//   Orientation::getInstance().resetMaxForwardAccel();
+//   Orientation::getInstance().resetMaxRadialAccel();
+//   driver.execute(moves);
+//   SpeedEscalation::afterRun(SpeedEscalation::measureLastRun());
+//
+class SpeedEscalation
+{
+  public:
+    struct RunReport {
+      float max_forward_accel; // m/s/s
+      float max_forward_decel; // m/s/s
+      float max_radial_accel; // m/s/s
+      float max_heading_error; // degrees
+      float max_position_error; // mm
+    };
+
+    // Collects the peaks of the last KaosDriver run from Orientation and
+    // KaosDriver
+    static RunReport measureLastRun();
+
+    // Moves every speed limit by how close the run came to its allowance
+    static void afterRun(const RunReport& report);
+
+    // Lowers every speed limit after a run that did not finish
+    static void afterCrash();
+
+  private:
+    // Returns the new value of a limit given the share of its allowance the
+    // last run used
+    static float escalate(float limit, float usage, float low, float high);
+
+    SpeedEscalation();
+};
+
+#endif
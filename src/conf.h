@@ -59,6 +59,7 @@
 // RANGE SENSOR OPTIONS
 
 // Translation formula constants. distance = a * (reading - b)^c + d
+// Run tools/make_range_table.py after changing these.
 #define RANGE_DIAG_LEFT_TRANSLATION { 204279.127508, -140.177058331, -1.17485565668, 4.26428490432, -0.0004, 774., 2.29, 68., 774.051196698, 0 }
 #define RANGE_DIAG_RIGHT_TRANSLATION { 1599.06663151, 27.8878612466, -0.225900340991, -274.178607786, -0.0007, 745., 2.29, 85., 746.880064643, 0 }
 #define RANGE_FRONT_LEFT_TRANSLATION { 982.981088769, 3.01477552114, -0.290806601873, -105.008228929, -0.0006, 880, 2.4, 33, 880.068342392, 0 }
@@ -74,6 +75,11 @@
 #define FRONT_RIGHT_LOW_THRESHOLD 201
 #define FRONT_RIGHT_HIGH_THRESHOLD 201
 
+// Wall evidence is gathered over this many mm before the point where a cell's
+// walls are judged. A reading this many mm past the threshold is a full vote.
+#define WALL_EVIDENCE_WINDOW 40
+#define WALL_EVIDENCE_MARGIN 40
+
 // Range sensor middle readings
 #define RANGE_DIAG_LEFT_MIDDLE 185
 #define RANGE_DIAG_RIGHT_MIDDLE 209
@@ -84,11 +90,20 @@
 // Gyro parameters
 #define GYRO_LSB_PER_DEG_PER_S 16.295
 
-// target 1 sigma confidence interval on calibrated gyro offset, calibration
-// time goes like square of inverse of this
-#define GYRO_CALIBRATION_TARGET_UNCERTAINTY 0.01
 #define GYRO_OFFSET_SETTING -62
-#define GYRO_SECONDARY_OFFSET 0.3563
+#define GYRO_SECONDARY_OFFSET 0.3563 // starting guess for the online bias
+
+// Online gyro bias, see GyroBiasEstimator. Readings are in LSB.
+#define GYRO_BIAS_INITIAL_VARIANCE 1 // LSB^2 around GYRO_SECONDARY_OFFSET
+#define GYRO_BIAS_DRIFT_VARIANCE 0.0001 // LSB^2 per second
+#define GYRO_NOISE_VARIANCE 4 // LSB^2 of a single reading
+#define GYRO_BIAS_STILL_THRESHOLD 20 // LSB from the bias, further means the robot moved
+#define GYRO_BIAS_SETTLE_TIME 200000 // us still before readings are used
+
+// IMU FIFO reads, see ImuAcquisition
+#define IMU_SAMPLE_PERIOD 2000 // us between FIFO packets, 500Hz from setRate(1) with the DLPF on
+#define IMU_MAX_BURST 8 // most FIFO packets read in one I2C transfer
+#define IMU_ACCEL_PEAK_WINDOW 8 // FIFO packets averaged before taking peak accelerations, 16 ms
 
 // Range sensor delays in us
 #define RANGE_SENSOR_ON_TIME 50 // length of LED pulse
@@ -96,6 +111,7 @@
 
 // Accelerometer parameters
 #define ACCEL_LSB_PER_G 2048
+#define STANDARD_GRAVITY 9.80665 // m/s/s
 
 // Magnetometer parameters
 #define MAG_CYCLES_PER_UPDATE 5
@@ -104,7 +120,7 @@
 // Motor stop failsafe parameters
 #define FAILSAFE_GYRO_THRESHOLD 100 // in deg/s
 #define FAILSAFE_GYRO_ANGLE 20 // in deg
-#define FAILSAFE_ACCEL_THRESHOLD 10// in mg
+#define FAILSAFE_ACCEL_THRESHOLD 10 // in g
 
 // Display control parameters
 #define DISPLAY_SIZE 4
@@ -124,7 +140,7 @@
 #define HAND_SWIPE_DIAG_RANGE 85
 
 // Logging configuration
-#define LOG_SIZE 1
+#define LOG_RESERVED_MEMORY 16384 // bytes left free for the stack when the flight recorder takes the rest
 
 // EEPROM save location
 #define EEPROM_MAZE_LOCATION 2
@@ -142,11 +158,16 @@
 #define EEPROM_TARGET_Y_LOCATION 517
 #define EEPROM_NUM_RUNS_LOCATION 520
 #define EEPROM_STATE_LOCATION 522
+#define EEPROM_DRIVETRAIN_FLAG_LOCATION 524
+#define EEPROM_DRIVETRAIN_STATIC_LOCATION 526
+#define EEPROM_DRIVETRAIN_VELOCITY_LOCATION 528
+#define EEPROM_DRIVETRAIN_ACCEL_LOCATION 530
 
 // Storage settings
 // Number of digits stored after the decimal point
 #define PERSISTANT_STORAGE_VELOCITY_DIGITS 2
 #define PERSISTANT_STORAGE_ACCEL_DIGITS 1
+#define PERSISTANT_STORAGE_DRIVETRAIN_DIGITS 4
 
 // Motion control paremeters
 #define MM_PER_BLOCK 180
@@ -154,6 +175,69 @@
 #define MM_PER_STEP 0.653868
 #define MOTION_COLLECT_MM_PER_READING 1
 
+// Rate of the timer driven control loop
+#define CONTROL_LOOP_RATE_HZ 1000
+
+// Speed run setpoint table
+// Shortest time between table entries, in microseconds. The tick is stretched
+// for runs that would not fit in the table.
+#define TRAJECTORY_TICK_US 10000
+#define TRAJECTORY_TABLE_SIZE 768
+
+// Wheel slip detection
+// Slip is the largest of the front to back wheel speed difference on either
+// side and the difference between the yaw rate from the wheels and the gyro,
+// each over its tolerance, low pass filtered. Above SLIP_THRESHOLD the
+// TrajectoryExecutor plays its setpoints back slower, which scales its
+// acceleration down by the square of the playback rate.
+#define SLIP_FRONT_BACK_TOLERANCE 0.15 // m/s
+#define SLIP_YAW_RATE_TOLERANCE 90 // deg/s
+#define SLIP_FILTER_GAIN 0.2 // share of each new cycle in the filtered slip
+#define SLIP_THRESHOLD 1
+#define SLIP_MIN_PLAYBACK_RATE 0.6
+#define SLIP_PLAYBACK_SLEW 2 // per second, how fast the playback rate changes
+
+// Pose estimation
+// x is east and y is north in mm from the center of cell (0, 0), and the
+// heading is degrees clockwise from north. Variances grow with distance
+// driven and angle turned, and shrink with each wall seen.
+#define POSE_DISTANCE_VARIANCE 0.02 // mm^2 along the heading per mm driven
+#define POSE_LATERAL_VARIANCE 0.01 // mm^2 across the heading per mm driven
+#define POSE_DRIFT_VARIANCE 0.002 // deg^2 per mm driven
+#define POSE_ROTATION_VARIANCE 0.01 // deg^2 per degree turned
+#define POSE_SIDE_WALL_VARIANCE 16 // mm^2
+#define POSE_FRONT_WALL_VARIANCE 9 // mm^2
+#define POSE_ALIGNED_VARIANCE 1 // deg^2, heading after holding against a wall
+#define POSE_LATERAL_PER_DIAG_RANGE 0.707 // mm across the cell per mm of diagonal range
+#define POSE_FRONT_RANGE_AT_CENTER MOTION_RESET_HOLD_DISTANCE // front range with the robot centered in front of a wall
+#define POSE_FRONT_RANGE_MAX 120 // mm, further front readings are not used
+#define POSE_WALL_HEADING_TOLERANCE 10 // degrees from north, east, south or west for walls to be used
+#define POSE_GATE 3 // standard deviations, further observations are ignored
+#define POSE_CONFIDENT_POSITION 5 // mm standard deviation, below which realignment is skipped
+#define POSE_CONFIDENT_HEADING 2 // degrees standard deviation
+
+// Post detection on straights
+// A diagonal range sensor steps from short to long readings where a side wall
+// ends at a post, and back where one starts. Where it steps, the robot center
+// is POST_EDGE_LOOKAHEAD behind the post, give or take half the post.
+#define POST_EDGE_WALL_RANGE 240 // mm, diagonal readings below this are a wall
+#define POST_EDGE_OPEN_RANGE 280 // mm, diagonal readings above this are no wall
+#define POST_EDGE_LOOKAHEAD 60 // mm ahead of the center the diagonal sensors meet the side walls
+#define POST_HALF_WIDTH 6 // mm
+#define POSE_POST_VARIANCE 9 // mm^2 along the heading
+
+// Straight before and after each swept turn while searching. With a post seen
+// within TURN_ENTRY_POST_RANGE before the turn, the straight before it is
+// lengthened or shortened by up to TURN_LEAD_IN_MAX_SHIFT so that the turn
+// starts TURN_LEAD_IN past the cell edge.
+#define TURN_LEAD_IN 12 // mm
+#define TURN_LEAD_IN_MAX_SHIFT 10 // mm
+#define TURN_ENTRY_POST_RANGE MM_PER_BLOCK // mm driven since the post
+
+// Run the PID controllers and motor output math in Q16 fixed point instead of
+// float. See motion/Fixed.h.
+#define CONTROL_FIXED_POINT false
+
 // PID tuning parameters
 #define KP_POSITION 35
 #define KI_POSITION 0
@@ -188,11 +272,16 @@
 #define MM_BETWEEN_WHEELS_ROTATE 70
 #define NUMBER_OF_MOTORS 4
 #define STEPS_PER_MOTOR_REV 12// the number of encoder steps we get per wheel revolution
-#define BATTERY_VOLTAGE 8.1 // Volts
+#define BATTERY_VOLTAGE 8.1 // Volts, the motor feedforward is scaled from this to the measured voltage
 #define BATTERY_VOLTAGE_WARNING 7.7 // Volts
+#define BATTERY_VOLTAGE_MIN 6.0 // Volts, measured voltages are limited to this range for the feedforward
+#define BATTERY_VOLTAGE_MAX 8.6 // Volts
+#define BATTERY_SAMPLE_PERIOD 5000 // us between battery voltage samples
+#define BATTERY_FILTER_GAIN 0.1 // share of each new sample in the voltage estimate, 50 ms time constant
 #define MAX_COEFFICIENT_FRICTION 1
 #define MAX_ACCEL_STRAIGHT 7 // m/s/s
 #define MAX_DECEL_STRAIGHT -5 // m/s/s
+#define MAX_JERK_STRAIGHT 200 // m/s/s/s, how fast straights ramp their acceleration
 #define MAX_ACCEL_ROTATE 2 // m/s/s
 #define MAX_DECEL_ROTATE -2 // m/s/s
 #define MAX_ACCEL_CORNER 3 // m/s/s
@@ -217,6 +306,16 @@
 #define VELOCITY_PER_VBEMF (RATED_RPM_PER_VBEMF * STEPS_PER_MOTOR_REV * GEAR_RATIO * MM_PER_STEP / (60000)) // 60000 is for mm to m and s to min
 #define FRICTION_FORCE (RATED_FREERUN_CURRENT * FORCE_PER_AMP + 0.10) // Newtons (0.08 calculated Newtons from motor/gearbox)  amount of force opposing motion in robot including rolling resistance, sliding, gearing
 
+// Drivetrain identification (SYID in the options menu)
+// Motor feedforward measured on the robot replaces the constants above once
+// it has been saved. Each duty cycle is driven forward, coasted, driven
+// backward and coasted, so the robot ends up close to where it started.
+#define SYSID_DUTY_CYCLES { 0.08, 0.12, 0.16 }
+#define SYSID_STEP_TIME 200000 // us spent driving at each duty cycle
+#define SYSID_COAST_TIME 300000 // us spent coasting after each step
+#define SYSID_SAMPLE_PERIOD 1000 // us
+#define SYSID_MIN_VELOCITY 0.05 // m/s, slower samples are left out of the fit
+
 //  TODO precompile, calculate max velocity based on turn radius and max accel, which will then limit max velocity through centripital force.
 //  if this max velocity is higher than max straight velocity then use max straight velocity
 #define MAX_VEL_ROTATE .5 // m/s
@@ -230,6 +329,7 @@
 // highest reliable max angular accel is most accurate turn
 //  max angular accel can be calculated with below equation
 //  max angular accel = (max linear accel) * 90000 * ROBOT_MASS * MM_BETWEEN_WHEELS / (robot rot. inertia)
+// Run tools/make_turn_tables.py after changing these or the robot characteristics.
 #define SWEPT_TURN_45_FORWARD_SPEED 0.87
 #define SWEPT_TURN_45_ANGLE 45.0
 
@@ -248,6 +348,22 @@
 
 #define NUM_RUNS 5
 
+// Speed escalation between speed runs in autoMode
+// After each run every Kaos speed limit is raised by ESCALATION_STEP while
+// the run stayed below ESCALATION_HEADROOM of its limits, and lowered by
+// ESCALATION_STEP once it went over them. A crash lowers every speed by
+// ESCALATION_CRASH_BACKOFF.
+#define ESCALATION_TRACTION_LIMIT (MAX_COEFFICIENT_FRICTION * STANDARD_GRAVITY) // m/s/s, peak accelerations are measured against this
+#define ESCALATION_MAX_POSITION_ERROR 10 // mm of wheel tracking error
+#define ESCALATION_MAX_HEADING_ERROR 10 // degrees
+#define ESCALATION_HEADROOM 0.8
+#define ESCALATION_STEP 0.1
+#define ESCALATION_CRASH_BACKOFF 0.2
+#define ESCALATION_MIN_VELOCITY SEARCH_VELOCITY // m/s
+#define ESCALATION_MAX_VELOCITY 3.0 // m/s
+#define ESCALATION_MIN_ACCEL 1.0 // m/s/s
+#define ESCALATION_MAX_ACCEL 15.0 // m/s/s
+
 
 
 #endif
@@ -0,0 +1,73 @@
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "AccelPeaks.h"
+
+// m/s/s for a sum of a full window of raw readings
+static const float kAccelPerSum = STANDARD_GRAVITY / ACCEL_LSB_PER_G
+                                  / AccelPeaks::kWindow;
+
+AccelPeaks::AccelPeaks()
+{
+  clear();
+}
+
+void AccelPeaks::clear()
+{
+  for (size_t i = 0; i < kWindow; i++) {
+    forward_[i] = 0;
+    radial_[i] = 0;
+  }
+  next_ = 0;
+  forward_sum_ = 0;
+  radial_sum_ = 0;
+  resetForward();
+  resetRadial();
+}
+
+void AccelPeaks::resetForward()
+{
+  max_forward_sum_ = 0;
+  min_forward_sum_ = 0;
+}
+
+void AccelPeaks::resetRadial()
+{
+  max_radial_sum_ = 0;
+}
+
+void AccelPeaks::add(int16_t forward, int16_t radial)
+{
+  forward_sum_ += forward - forward_[next_];
+  radial_sum_ += radial - radial_[next_];
+  forward_[next_] = forward;
+  radial_[next_] = radial;
+  next_ = next_ + 1 < kWindow ? next_ + 1 : 0;
+
+  // the radial sign is the direction of the turn, so it is averaged before
+  // taking the size, which keeps noise from adding up
+  int32_t radial_size = radial_sum_ < 0 ? -radial_sum_ : radial_sum_;
+
+  if (forward_sum_ > max_forward_sum_)
+    max_forward_sum_ = forward_sum_;
+  if (forward_sum_ < min_forward_sum_)
+    min_forward_sum_ = forward_sum_;
+  if (radial_size > max_radial_sum_)
+    max_radial_sum_ = radial_size;
+}
+
+float AccelPeaks::getMaxForwardAccel() const
+{
+  return max_forward_sum_ * kAccelPerSum;
+}
+
+float AccelPeaks::getMaxForwardDecel() const
+{
+  return -min_forward_sum_ * kAccelPerSum;
+}
+
+float AccelPeaks::getMaxRadialAccel() const
+{
+  return max_radial_sum_ * kAccelPerSum;
+}
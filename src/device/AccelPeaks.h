@@ -0,0 +1,62 @@
+#ifndef MICROMOUSE_ACCEL_PEAKS_H_
+#define MICROMOUSE_ACCEL_PEAKS_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Peak forward and radial accelerations, taken from a moving average of the
+// accelerometer
+//
+// A single packet can read far past what the robot is doing, from a bump or
+// a wheel hitting a post, and SpeedEscalation would back off a speed for it.
+// The peaks are instead taken over the mean of the last
+// IMU_ACCEL_PEAK_WINDOW packets, which a spike moves by only a fraction of
+// its height, while an acceleration held for that long still counts in
+// full. The sums are of the raw readings, so they are exact and cheap enough
+// for the I2C interrupt.
+//
+//   AccelPeaks peaks;
+//   peaks.add(sample.accel_y, sample.accel_x);
+//   if (peaks.getMaxRadialAccel() > limit) ...
+//
+class AccelPeaks
+{
+  public:
+    static const size_t kWindow = IMU_ACCEL_PEAK_WINDOW;
+
+  private:
+    // raw readings in the window, oldest at next_
+    int16_t forward_[kWindow];
+    int16_t radial_[kWindow];
+    size_t next_;
+
+    // sums of the window, and their peaks since the last reset
+    int32_t forward_sum_;
+    int32_t radial_sum_;
+    int32_t max_forward_sum_;
+    int32_t min_forward_sum_;
+    int32_t max_radial_sum_;
+
+  public:
+    AccelPeaks();
+
+    // Forgets the readings and the peaks
+    void clear();
+
+    // Forgets the peaks but not the readings in the window
+    void resetForward();
+    void resetRadial();
+
+    // Adds one packet. forward is positive when speeding up, radial can be
+    // either sign, both raw.
+    void add(int16_t forward, int16_t radial);
+
+    // m/s/s, not negative
+    float getMaxForwardAccel() const;
+    float getMaxForwardDecel() const;
+    float getMaxRadialAccel() const;
+};
+
+#endif
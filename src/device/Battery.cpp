@@ -0,0 +1,78 @@
+#include <Arduino.h>
+#include "../conf.h"
+#include "Battery.h"
+#include "RangeAcquisition.h"
+
+// voltage divider and ADC scaling, same as UserInterface has always used
+static const float kVoltsPerCount = (8.225 / 6.330) * (26 / 10) * (3.3 / 1023);
+
+bool Battery::has_estimate_ = false;
+uint32_t Battery::last_sample_time_ = 0;
+float Battery::voltage_ = BATTERY_VOLTAGE;
+float Battery::compensation_ = 1;
+Q16 Battery::compensation_fixed_ = Q16::fromInt(1);
+
+float Battery::toVolts(int raw)
+{
+  return kVoltsPerCount * raw;
+}
+
+float Battery::read()
+{
+  int reading;
+
+  // the range sensor interrupt also uses the ADC
+  uint8_t old_SREG = SREG;
+  noInterrupts();
+  reading = analogRead(BATTERY_PIN);
+  SREG = old_SREG;
+
+  return toVolts(reading);
+}
+
+void Battery::update()
+{
+  uint32_t now = micros();
+
+  if (has_estimate_ && now - last_sample_time_ < BATTERY_SAMPLE_PERIOD)
+    return;
+
+  last_sample_time_ = now;
+
+  float sample;
+  RangeAcquisition::Sample sweep;
+  if (RangeAcquisition::getLatest(sweep)) {
+    sample = toVolts(sweep.battery);
+  } else {
+    sample = read();
+  }
+
+  if (has_estimate_) {
+    voltage_ += (sample - voltage_) * BATTERY_FILTER_GAIN;
+  } else {
+    voltage_ = sample;
+    has_estimate_ = true;
+  }
+
+  float limited = constrain(voltage_, BATTERY_VOLTAGE_MIN, BATTERY_VOLTAGE_MAX);
+  compensation_ = BATTERY_VOLTAGE / limited;
+  compensation_fixed_ = Q16::fromFloat(compensation_);
+}
+
+float Battery::getVoltage()
+{
+  update();
+  return voltage_;
+}
+
+float Battery::getCompensation()
+{
+  update();
+  return compensation_;
+}
+
+Q16 Battery::getCompensationFixed()
+{
+  update();
+  return compensation_fixed_;
+}
@@ -0,0 +1,51 @@
+#ifndef MICROMOUSE_BATTERY_H_
+#define MICROMOUSE_BATTERY_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "../motion/Fixed.h"
+
+// Filtered estimate of the battery voltage, for the motor feedforward
+//
+// The motor constants in conf.h give PWM duty cycles at BATTERY_VOLTAGE. As
+// the pack sags the same duty cycle gives less current, so Motor::Set scales
+// its output by getCompensation(), BATTERY_VOLTAGE over the measured voltage.
+//
+// A new sample is taken at most once every BATTERY_SAMPLE_PERIOD and run
+// through a first order low pass filter. While RangeAcquisition is running
+// the sample comes from its last sweep, since its interrupt owns the ADC.
+// Otherwise BATTERY_PIN is read directly.
+//
+//   speed *= Battery::getCompensation();
+//
+class Battery
+{
+  private:
+    static bool has_estimate_;
+    static uint32_t last_sample_time_;
+    static float voltage_;
+    static float compensation_;
+    static Q16 compensation_fixed_;
+
+  public:
+    // Converts a raw reading of BATTERY_PIN to volts
+    static float toVolts(int raw);
+
+    // Reads BATTERY_PIN once and returns the voltage, unfiltered
+    static float read();
+
+    // Takes a new sample if one is due
+    static void update();
+
+    // Returns the filtered voltage
+    static float getVoltage();
+
+    // Returns BATTERY_VOLTAGE divided by the filtered voltage, limited to
+    // the range between BATTERY_VOLTAGE_MIN and BATTERY_VOLTAGE_MAX
+    static float getCompensation();
+    static Q16 getCompensationFixed();
+};
+
+#endif
@@ -6,7 +6,8 @@ Encoder gEncoderRF(8, 7);
 Encoder gEncoderLB(5, 6);
 Encoder gEncoderRB(9, 10);
 
-Encoder::Encoder(uint8_t pin1, uint8_t pin2) : encoder_(pin1, pin2)
+Encoder::Encoder(uint8_t pin1, uint8_t pin2)
+    : encoder_(pin1, pin2), odometer_offset_(0)
 {}
 
 double Encoder::count()
@@ -16,7 +17,15 @@ double Encoder::count()
 
 void Encoder::count(double value)
 {
-  encoder_.write(nearbyint(value));
+  int32_t count = nearbyint(value);
+  odometer_offset_ += encoder_.read() - count;
+  encoder_.write(count);
+}
+
+void Encoder::shift(int32_t counts)
+{
+  odometer_offset_ -= counts;
+  encoder_.write(encoder_.read() + counts);
 }
 
 double Encoder::countsPerSecond()
@@ -24,6 +33,11 @@ double Encoder::countsPerSecond()
   return encoder_.stepRate();
 }
 
+double Encoder::odometer()
+{
+  return odometer_offset_ + encoder_.read();
+}
+
 EncoderPittMicromouse &Encoder::innerObject()
 {
   return encoder_;
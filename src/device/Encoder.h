@@ -13,12 +13,21 @@ class Encoder
     double count();
     void count(double value);
 
+    // moves the count by counts, without changing the odometer
+    void shift(int32_t counts);
+
     double countsPerSecond();
 
+    // counts since startup, not changed by setting the count
+    double odometer();
+
     EncoderPittMicromouse &innerObject();
 
   private:
     EncoderPittMicromouse encoder_;
+
+    // counts written over by count(value)
+    int32_t odometer_offset_;
 };
 
 extern Encoder gEncoderLF, gEncoderRF, gEncoderLB, gEncoderRB;
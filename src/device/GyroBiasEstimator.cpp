@@ -0,0 +1,57 @@
+#include <cmath>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "GyroBiasEstimator.h"
+
+GyroBiasEstimator::GyroBiasEstimator(float bias, float variance)
+    : bias_(bias), variance_(variance), stationary_(false),
+      has_sample_(false), still_since_(0), last_time_(0)
+{}
+
+void GyroBiasEstimator::setStationary(bool stationary, uint32_t time)
+{
+  stationary_ = stationary;
+  still_since_ = time;
+}
+
+bool GyroBiasEstimator::isStationary() const
+{
+  return stationary_;
+}
+
+bool GyroBiasEstimator::addSample(float reading, uint32_t time)
+{
+  if (has_sample_) {
+    variance_ += GYRO_BIAS_DRIFT_VARIANCE
+                 * (int32_t) (time - last_time_) / 1000000.0;
+  }
+  has_sample_ = true;
+  last_time_ = time;
+
+  if (!stationary_)
+    return false;
+
+  if (fabs(reading - bias_) > GYRO_BIAS_STILL_THRESHOLD) {
+    still_since_ = time;
+    return false;
+  }
+
+  if ((int32_t) (time - still_since_) < GYRO_BIAS_SETTLE_TIME)
+    return false;
+
+  float gain = variance_ / (variance_ + GYRO_NOISE_VARIANCE);
+  bias_ += gain * (reading - bias_);
+  variance_ *= 1 - gain;
+  return true;
+}
+
+float GyroBiasEstimator::getBias() const
+{
+  return bias_;
+}
+
+float GyroBiasEstimator::getUncertainty() const
+{
+  return sqrt(variance_);
+}
@@ -0,0 +1,54 @@
+#ifndef MICROMOUSE_GYRO_BIAS_ESTIMATOR_H_
+#define MICROMOUSE_GYRO_BIAS_ESTIMATOR_H_
+
+#include <cstdint>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Tracks the gyro reading that means no rotation while the robot is still
+//
+// The bias is a one state Kalman filter. Its variance grows by
+// GYRO_BIAS_DRIFT_VARIANCE per second all the time, and each reading taken
+// while the robot is known to be stationary pulls the bias towards it,
+// weighted by GYRO_NOISE_VARIANCE. Readings only count once the robot has
+// been still for GYRO_BIAS_SETTLE_TIME, and any reading further than
+// GYRO_BIAS_STILL_THRESHOLD from the bias means it was moved after all and
+// starts the settling over.
+//
+//   GyroBiasEstimator bias (GYRO_SECONDARY_OFFSET, GYRO_BIAS_INITIAL_VARIANCE);
+//   bias.setStationary(true, micros());
+//   if (bias.addSample(reading, time))
+//     offset = bias.getBias();
+//
+class GyroBiasEstimator
+{
+  private:
+    float bias_;
+    float variance_;
+
+    bool stationary_;
+    bool has_sample_;
+    uint32_t still_since_;
+    uint32_t last_time_;
+
+  public:
+    // Starts from a bias and its variance in LSB^2
+    GyroBiasEstimator(float bias, float variance);
+
+    // Marks the robot as stationary or not from time on, in microseconds
+    void setStationary(bool stationary, uint32_t time);
+
+    bool isStationary() const;
+
+    // Takes a raw reading and the time it was read in microseconds. Returns
+    // true if the bias changed.
+    bool addSample(float reading, uint32_t time);
+
+    float getBias() const;
+
+    // Standard deviation of the bias in LSB
+    float getUncertainty() const;
+};
+
+#endif
@@ -0,0 +1,297 @@
+#include <Arduino.h>
+#include <atomic>
+#include <i2c_t3.h>
+#include <MPU9150PittMicromouse.h>
+#include "../conf.h"
+#include "../user_interaction/FreakOut.h"
+#include "../user_interaction/Trace.h"
+#include "ImuAcquisition.h"
+
+// accel x, y and z then gyro z, all big endian
+static const uint8_t kPacketSize = 8;
+static const uint16_t kFIFOSize = 1024;
+
+// longest stop() waits for a transfer to finish
+static const uint32_t kStopTimeout = 10000; // us
+
+static uint8_t buffer[IMU_MAX_BURST * kPacketSize];
+static uint8_t count_buffer[2];
+
+volatile bool ImuAcquisition::running_ = false;
+volatile ImuAcquisition::Step ImuAcquisition::step_ = ImuAcquisition::kIdle;
+volatile bool ImuAcquisition::pending_ = false;
+volatile uint32_t ImuAcquisition::ready_time_ = 0;
+uint16_t ImuAcquisition::fifo_count_ = 0;
+uint8_t ImuAcquisition::burst_ = 0;
+uint32_t ImuAcquisition::burst_time_ = 0;
+ImuAcquisition::State ImuAcquisition::state_ = {};
+bool ImuAcquisition::has_packet_ = false;
+float ImuAcquisition::gyro_offset_ = 0;
+uint8_t ImuAcquisition::user_control_ = 1 << MPU9150_USERCTRL_FIFO_EN_BIT;
+AccelPeaks ImuAcquisition::peaks_;
+volatile bool ImuAcquisition::reset_forward_accel_ = false;
+volatile bool ImuAcquisition::reset_radial_accel_ = false;
+ImuAcquisition::State ImuAcquisition::buffers_[2];
+volatile uint8_t ImuAcquisition::front_ = 0;
+volatile uint32_t ImuAcquisition::sequence_ = 0;
+SpscRing<ImuAcquisition::Sample, ImuAcquisition::kRingSize>
+    ImuAcquisition::ring_;
+volatile uint32_t ImuAcquisition::dropped_ = 0;
+volatile uint32_t ImuAcquisition::resets_ = 0;
+volatile uint32_t ImuAcquisition::errors_ = 0;
+
+void ImuAcquisition::readyHandler()
+{
+  if (!running_)
+    return;
+
+  // If this lands while finish() is going idle the pending flag can be
+  // missed, which only delays the packets until the next data ready
+  ready_time_ = micros();
+  if (step_ == kIdle) {
+    readCount();
+  } else {
+    pending_ = true;
+  }
+}
+
+void ImuAcquisition::readCount()
+{
+  burst_time_ = ready_time_;
+  step_ = kCountAddress;
+  Wire1.beginTransmission(MPU9150_DEFAULT_ADDRESS);
+  Wire1.write(MPU9150_RA_FIFO_COUNTH);
+  Wire1.sendTransmission(I2C_NOSTOP);
+}
+
+void ImuAcquisition::readPackets()
+{
+  burst_ = fifo_count_ / kPacketSize;
+  if (burst_ > IMU_MAX_BURST)
+    burst_ = IMU_MAX_BURST;
+
+  step_ = kDataAddress;
+  Wire1.beginTransmission(MPU9150_DEFAULT_ADDRESS);
+  Wire1.write(MPU9150_RA_FIFO_R_W);
+  Wire1.sendTransmission(I2C_NOSTOP);
+}
+
+void ImuAcquisition::resetFIFO()
+{
+  TRACE_INSTANT("FIFO reset", fifo_count_);
+  resets_++;
+  step_ = kReset;
+  Wire1.beginTransmission(MPU9150_DEFAULT_ADDRESS);
+  Wire1.write(MPU9150_RA_USER_CTRL);
+  Wire1.write(user_control_ | 1 << MPU9150_USERCTRL_FIFO_RESET_BIT);
+  Wire1.sendTransmission(I2C_STOP);
+}
+
+void ImuAcquisition::finish()
+{
+  if (running_ && fifo_count_ >= kPacketSize) {
+    readPackets();
+  } else if (running_ && pending_) {
+    pending_ = false;
+    readCount();
+  } else {
+    step_ = kIdle;
+  }
+}
+
+void ImuAcquisition::transmitDoneHandler()
+{
+  switch (step_) {
+    case kCountAddress:
+      step_ = kCount;
+      Wire1.sendRequest(MPU9150_DEFAULT_ADDRESS, 2, I2C_STOP);
+      break;
+    case kDataAddress:
+      step_ = kData;
+      Wire1.sendRequest(MPU9150_DEFAULT_ADDRESS, burst_ * kPacketSize,
+                        I2C_STOP);
+      break;
+    case kReset:
+      fifo_count_ = 0;
+      finish();
+      break;
+    default:
+      break;
+  }
+}
+
+void ImuAcquisition::requestDoneHandler()
+{
+  if (step_ == kCount) {
+    Wire1.read(count_buffer, 2);
+    fifo_count_ = (uint16_t) count_buffer[0] << 8 | count_buffer[1];
+
+    if (fifo_count_ >= kFIFOSize || fifo_count_ % kPacketSize != 0) {
+      resetFIFO();
+    } else {
+      finish();
+    }
+  } else if (step_ == kData) {
+    Wire1.read(buffer, burst_ * kPacketSize);
+
+    // packets left in the FIFO after this burst are newer than it
+    uint16_t newer = fifo_count_ / kPacketSize - burst_;
+    for (uint8_t i = 0; i < burst_; i++) {
+      uint32_t age = (newer + burst_ - 1 - i) * IMU_SAMPLE_PERIOD;
+      integrate(buffer + i * kPacketSize, burst_time_ - age);
+    }
+    fifo_count_ -= burst_ * kPacketSize;
+
+    buffers_[front_ ^ 1] = state_;
+    buffers_[front_ ^ 1].sequence = sequence_;
+    std::atomic_signal_fence(std::memory_order_release);
+    front_ ^= 1;
+    sequence_++;
+
+    finish();
+  }
+}
+
+void ImuAcquisition::errorHandler()
+{
+  errors_++;
+  fifo_count_ = 0;
+  pending_ = false;
+  step_ = kIdle;
+}
+
+void ImuAcquisition::integrate(const uint8_t* packet, uint32_t time)
+{
+  Sample sample;
+  sample.accel_x = (int16_t) ((uint16_t) packet[0] << 8 | packet[1]);
+  sample.accel_y = (int16_t) ((uint16_t) packet[2] << 8 | packet[3]);
+  sample.gyro_z = (int16_t) ((uint16_t) packet[6] << 8 | packet[7]);
+  sample.time = time;
+
+  // the rate of the last packet holds until this one
+  if (has_packet_) {
+    state_.rotation += state_.rate * (int32_t) (time - state_.time) / 1000000.0;
+  }
+  state_.rate = -(sample.gyro_z - gyro_offset_) / GYRO_LSB_PER_DEG_PER_S;
+  state_.time = time;
+  has_packet_ = true;
+
+  if (reset_forward_accel_) {
+    reset_forward_accel_ = false;
+    peaks_.resetForward();
+  }
+  if (reset_radial_accel_) {
+    reset_radial_accel_ = false;
+    peaks_.resetRadial();
+  }
+
+  // accel_y is positive when speeding up, like the logged forward accel
+  peaks_.add(sample.accel_y, sample.accel_x);
+  state_.max_forward_accel = peaks_.getMaxForwardAccel();
+  state_.max_forward_decel = peaks_.getMaxForwardDecel();
+  state_.max_radial_accel = peaks_.getMaxRadialAccel();
+
+  if (!ring_.push(sample)) {
+    dropped_++;
+  }
+}
+
+void ImuAcquisition::start()
+{
+  if (running_)
+    return;
+
+  Wire1.onTransmitDone(transmitDoneHandler);
+  Wire1.onReqFromDone(requestDoneHandler);
+  Wire1.onError(errorHandler);
+
+  pending_ = false;
+  fifo_count_ = 0;
+  running_ = true;
+
+  pinMode(IMU_INTERRUPT_PIN, INPUT);
+  attachInterrupt(IMU_INTERRUPT_PIN, readyHandler, RISING);
+}
+
+void ImuAcquisition::stop()
+{
+  running_ = false;
+
+  elapsedMicros waited;
+  while (step_ != kIdle) {
+    if (waited > kStopTimeout) {
+      freakOut("IMU1");
+    }
+  }
+}
+
+bool ImuAcquisition::isRunning()
+{
+  return running_;
+}
+
+void ImuAcquisition::setGyroOffset(float offset)
+{
+  gyro_offset_ = offset;
+}
+
+void ImuAcquisition::setUserControl(uint8_t value)
+{
+  // the reset bits clear themselves, and must not be written back every time
+  user_control_ = value & ~(1 << MPU9150_USERCTRL_DMP_RESET_BIT
+                            | 1 << MPU9150_USERCTRL_FIFO_RESET_BIT
+                            | 1 << MPU9150_USERCTRL_I2C_MST_RESET_BIT
+                            | 1 << MPU9150_USERCTRL_SIG_COND_RESET_BIT);
+}
+
+bool ImuAcquisition::getLatest(State& state)
+{
+  uint32_t sequence;
+
+  do {
+    sequence = sequence_;
+    if (sequence == 0)
+      return false;
+
+    std::atomic_signal_fence(std::memory_order_acquire);
+    state = buffers_[front_];
+    std::atomic_signal_fence(std::memory_order_acquire);
+  } while (sequence != sequence_);
+
+  return true;
+}
+
+bool ImuAcquisition::pop(Sample& sample)
+{
+  return ring_.pop(sample);
+}
+
+void ImuAcquisition::flush()
+{
+  ring_.clear();
+}
+
+void ImuAcquisition::resetMaxForwardAccel()
+{
+  reset_forward_accel_ = true;
+}
+
+void ImuAcquisition::resetMaxRadialAccel()
+{
+  reset_radial_accel_ = true;
+}
+
+uint32_t ImuAcquisition::getDropped()
+{
+  return dropped_;
+}
+
+uint32_t ImuAcquisition::getResets()
+{
+  return resets_;
+}
+
+uint32_t ImuAcquisition::getErrors()
+{
+  return errors_;
+}
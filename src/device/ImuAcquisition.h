@@ -0,0 +1,142 @@
+#ifndef MICROMOUSE_IMU_ACQUISITION_H_
+#define MICROMOUSE_IMU_ACQUISITION_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "AccelPeaks.h"
+#include "SpscRing.h"
+
+// Reads the MPU9150 FIFO in the background with interrupt driven I2C
+//
+// Each data ready interrupt from the IMU starts a chain of non-blocking
+// transfers on Wire1: read the FIFO count, then read every whole packet
+// waiting in the FIFO, up to IMU_MAX_BURST, in one burst. Each step is started
+// from the completion callback of the one before, so nothing waits on the bus.
+// A FIFO that overflowed or lost its packet alignment is reset the same way.
+//
+// The packets are timestamped, the newest with the time of the data ready
+// interrupt and the rest IMU_SAMPLE_PERIOD apart before it. Each one is
+// integrated into the rotation, added to the AccelPeaks, and pushed into an
+// SpscRing of samples. The
+// fused state is published through a double buffer like RangeAcquisition's,
+// so the control loop gets the heading without touching the bus.
+//
+// Blocking I2C calls through the MPU9150 library share Wire1 and must only be
+// made while the engine is stopped.
+//
+//   ImuAcquisition::start();
+//   ...
+//   ImuAcquisition::State state;
+//   ImuAcquisition::getLatest(state);
+//   heading = state.rotation + state.rate * (micros() - state.time) / 1e6;
+//
+class ImuAcquisition
+{
+  public:
+    struct Sample {
+      int16_t accel_x; // radial, raw
+      int16_t accel_y; // forward, raw
+      int16_t gyro_z; // raw, clockwise negative
+      uint32_t time; // micros() when the IMU took it
+    };
+
+    struct State {
+      float rotation; // degrees clockwise since start(), at time
+      float rate; // degrees per second clockwise, from the newest packet
+      // peaks since the last reset of the moving average in AccelPeaks
+      float max_forward_accel; // m/s/s speeding up
+      float max_forward_decel; // m/s/s slowing down
+      float max_radial_accel; // m/s/s
+      uint32_t time; // micros() of the newest packet
+      uint32_t sequence; // number of bursts published before this one
+    };
+
+    static const size_t kRingSize = 64;
+
+  private:
+    enum Step { kIdle, kCountAddress, kCount, kDataAddress, kData, kReset };
+
+    static void readyHandler();
+    static void transmitDoneHandler();
+    static void requestDoneHandler();
+    static void errorHandler();
+
+    // start the next transfer of the chain
+    static void readCount();
+    static void readPackets();
+    static void resetFIFO();
+    static void finish();
+
+    static void integrate(const uint8_t* packet, uint32_t time);
+
+    static volatile bool running_;
+    static volatile Step step_;
+
+    // set if the IMU had more data ready during a transfer
+    static volatile bool pending_;
+    static volatile uint32_t ready_time_;
+
+    // bytes in the FIFO at the last count, and packets in this burst
+    static uint16_t fifo_count_;
+    static uint8_t burst_;
+    static uint32_t burst_time_;
+
+    // fused state, written only from the I2C interrupt
+    static State state_;
+    static bool has_packet_;
+    static float gyro_offset_;
+    static uint8_t user_control_;
+    static AccelPeaks peaks_;
+    static volatile bool reset_forward_accel_;
+    static volatile bool reset_radial_accel_;
+
+    static State buffers_[2];
+    static volatile uint8_t front_;
+    static volatile uint32_t sequence_;
+
+    static SpscRing<Sample, kRingSize> ring_;
+    static volatile uint32_t dropped_;
+    static volatile uint32_t resets_;
+    static volatile uint32_t errors_;
+
+  public:
+    // Attaches the data ready interrupt and the I2C callbacks. The IMU must
+    // already be set up to fill its FIFO with accel and z gyro packets.
+    static void start();
+
+    // Waits for the transfer in progress to finish and stops starting new
+    // ones, so the bus can be used directly
+    static void stop();
+
+    static bool isRunning();
+
+    // Raw gyro reading that counts as no rotation
+    static void setGyroOffset(float offset);
+
+    // USER_CTRL as the IMU was set up. A FIFO reset writes it back with
+    // FIFO_RESET set, so that the other bits, like I2C_MST_EN and
+    // I2C_IF_DIS, are kept. Call before start().
+    static void setUserControl(uint8_t value);
+
+    // Copies the fused state into state. Returns false if no packet has
+    // been read yet.
+    static bool getLatest(State& state);
+
+    // Takes the oldest sample not yet read. Returns false if there is none.
+    static bool pop(Sample& sample);
+
+    // Throws away every sample not yet read
+    static void flush();
+
+    static void resetMaxForwardAccel();
+    static void resetMaxRadialAccel();
+
+    // Samples lost because the ring was full, FIFO resets and bus errors
+    static uint32_t getDropped();
+    static uint32_t getResets();
+    static uint32_t getErrors();
+};
+
+#endif
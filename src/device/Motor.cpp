@@ -1,14 +1,28 @@
 #include <Arduino.h>
 #include "../conf.h"
+#include "Battery.h"
 #include "Motor.h"
 
-// input desired force and current speed
-static float idealMotorOutput(float force, float velocity) {
-  float required_current, back_emf;
-  required_current = force / FORCE_PER_AMP;
-  back_emf = velocity / VELOCITY_PER_VBEMF;
-  return ((required_current * RATED_INTERNAL_RESISTANCE + back_emf) / BATTERY_VOLTAGE);
-}
+// Feedforward from the motor spec sheet, for one of NUMBER_OF_MOTORS motors
+static const float kRatedStaticVolts = FRICTION_FORCE / NUMBER_OF_MOTORS
+    / FORCE_PER_AMP * RATED_INTERNAL_RESISTANCE;
+static const float kRatedVoltsPerVelocity = 1 / VELOCITY_PER_VBEMF;
+static const float kRatedVoltsPerAccel = ROBOT_MASS / NUMBER_OF_MOTORS
+    / FORCE_PER_AMP * RATED_INTERNAL_RESISTANCE;
+
+// PWM steps per volt at BATTERY_VOLTAGE
+static const float kPWMPerVolt = PWM_SPEED_STEPS / BATTERY_VOLTAGE;
+
+float Motor::static_pwm_ = kRatedStaticVolts * kPWMPerVolt;
+float Motor::pwm_per_velocity_ = kRatedVoltsPerVelocity * kPWMPerVolt;
+float Motor::pwm_per_accel_ = kRatedVoltsPerAccel * kPWMPerVolt;
+
+#if CONTROL_FIXED_POINT
+Q16 Motor::static_pwm_fixed_ = Q16::fromFloat(kRatedStaticVolts * kPWMPerVolt);
+FixedMultiplier Motor::pwm_per_velocity_fixed_(kRatedVoltsPerVelocity
+                                               * kPWMPerVolt);
+FixedMultiplier Motor::pwm_per_accel_fixed_(kRatedVoltsPerAccel * kPWMPerVolt);
+#endif
 
 Motor motor_lf (MOTOR_LF_DIRECTION_PIN, MOTOR_LF_PWM_PIN, MOTOR_LF_FORWARD_STATE);
 
@@ -27,24 +41,75 @@ Motor::Motor(int motor_f_pin, int motor_f_pwm_pin, bool motor_f_forward_state){
   pinMode(pin_pwm_, OUTPUT);
 }
 
+void Motor::setFeedforward(float static_volts, float volts_per_velocity,
+                           float volts_per_accel) {
+  static_pwm_ = static_volts * kPWMPerVolt;
+  pwm_per_velocity_ = volts_per_velocity * kPWMPerVolt;
+  pwm_per_accel_ = volts_per_accel * kPWMPerVolt;
+
+#if CONTROL_FIXED_POINT
+  static_pwm_fixed_ = Q16::fromFloat(static_pwm_);
+  pwm_per_velocity_fixed_ = FixedMultiplier(pwm_per_velocity_);
+  pwm_per_accel_fixed_ = FixedMultiplier(pwm_per_accel_);
+#endif
+}
+
+void Motor::resetFeedforward() {
+  setFeedforward(kRatedStaticVolts, kRatedVoltsPerVelocity,
+                 kRatedVoltsPerAccel);
+}
+
+void Motor::SetPWM(int pwm) {
+  pwm = constrain(pwm, -PWM_SPEED_STEPS, PWM_SPEED_STEPS);
+
+  digitalWrite(pin_, (pwm > 0 ? HIGH : LOW) ^ forward_state_ ^ 1);
+  analogWrite(pin_pwm_, abs(pwm));
+}
+
+#if CONTROL_FIXED_POINT
+
+static const Q16 kMaxPWM = Q16::fromInt(PWM_SPEED_STEPS);
+
+void Motor::Set(float accel, float current_velocity) {
+  Set(Q16::fromFloat(accel), Q16::fromFloat(current_velocity));
+}
+
+void Motor::Set(Q16 accel, Q16 current_velocity) {
+  Q16 speed = pwm_per_accel_fixed_.apply(accel)
+              + pwm_per_velocity_fixed_.apply(current_velocity);
+
+  if (current_velocity > Q16()) {
+    speed += static_pwm_fixed_;
+  } else if (current_velocity < Q16()) {
+    speed -= static_pwm_fixed_;
+  }
+
+  speed *= Battery::getCompensationFixed();
+  speed = speed.clamp(-kMaxPWM, kMaxPWM);
+
+  digitalWrite(pin_, (speed > Q16() ? HIGH : LOW) ^ forward_state_ ^ 1);
+  analogWrite(pin_pwm_, speed.absolute().toRoundedInt());
+}
+
+#else
+
 void Motor::Set(float accel, float current_velocity) {
-  float force;
   float speed;
   int pin_state;
   int speed_raw;
 
+  speed = pwm_per_accel_ * accel + pwm_per_velocity_ * current_velocity;
+
   if (current_velocity > 0) {
-    force = (ROBOT_MASS * accel + FRICTION_FORCE) / NUMBER_OF_MOTORS;
+    speed += static_pwm_;
   } else if (current_velocity < 0) {
-    force = (ROBOT_MASS * accel - FRICTION_FORCE) / NUMBER_OF_MOTORS;
-  } else {
-    force = (ROBOT_MASS * accel) / NUMBER_OF_MOTORS;
+    speed -= static_pwm_;
   }
 
-  speed = idealMotorOutput(force, current_velocity);
-  speed = constrain(speed, -1, 1);
+  speed *= Battery::getCompensation();
+  speed = constrain(speed, -PWM_SPEED_STEPS, PWM_SPEED_STEPS);
 
-  speed_raw = abs((int)(round(PWM_SPEED_STEPS * speed)));
+  speed_raw = abs((int)(round(speed)));
 
   if (speed > 0.0) {
     pin_state = HIGH;
@@ -55,3 +120,5 @@ void Motor::Set(float accel, float current_velocity) {
   digitalWrite(pin_, pin_state ^ forward_state_ ^ 1);
   analogWrite(pin_pwm_, speed_raw);
 }
+
+#endif
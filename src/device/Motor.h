@@ -1,13 +1,52 @@
 #ifndef MOTOR_H
 #define MOTOR_H
 
+#include "../conf.h"
+#include "../motion/Fixed.h"
+
+// Motor feedforward
+//
+// Each motor is driven with the voltage
+//
+//   static_volts * sign(velocity) + volts_per_velocity * velocity
+//     + volts_per_accel * accel
+//
+// scaled to a duty cycle with the measured battery voltage. The three
+// parameters start out worked out from the motor constants in conf.h, and are
+// replaced with the ones measured by the drivetrain identification once those
+// have been saved.
 class Motor {
   private:
+    static float static_pwm_, pwm_per_velocity_, pwm_per_accel_;
+
+#if CONTROL_FIXED_POINT
+    static Q16 static_pwm_fixed_;
+    static FixedMultiplier pwm_per_velocity_fixed_, pwm_per_accel_fixed_;
+#endif
+
     int pin_, pin_pwm_;
     bool forward_state_;
+
   public:
     Motor(int motor_f_pin, int motor_f_pwm_pin, bool motor_f_forward_state);
     void Set(float accel, float current_velocity);
+
+#if CONTROL_FIXED_POINT
+    // Same as above, with accel in m/s/s and velocity in m/s
+    void Set(Q16 accel, Q16 current_velocity);
+#endif
+
+    // Drives the motor at a fixed duty cycle in PWM steps, negative for
+    // backwards, with no feedforward or battery compensation
+    void SetPWM(int pwm);
+
+    // Sets the feedforward for all motors, in volts, volts per m/s and volts
+    // per m/s/s
+    static void setFeedforward(float static_volts, float volts_per_velocity,
+                               float volts_per_accel);
+
+    // Goes back to the feedforward from the motor constants in conf.h
+    static void resetFeedforward();
 };
 
 extern Motor motor_lf, motor_lb, motor_rf, motor_rb;
@@ -4,30 +4,41 @@
 #include <Arduino.h>
 #include <MPU9150PittMicromouse.h>
 #include "../conf.h"
-
+#include "GyroBiasEstimator.h"
+
+// Heading of the robot from the MPU9150 gyro
+//
+// The IMU is read in the background by ImuAcquisition, which integrates the
+// gyro as the packets come in, so the heading is always current without
+// calling update(). update() takes the oldest sample not yet seen, for the
+// logger, the failsafes and the gyro bias.
+//
+// The bias starts at GYRO_SECONDARY_OFFSET and is refined by a
+// GyroBiasEstimator from the samples update() takes while the robot is marked
+// stationary, so it follows drift over a whole session.
+//
 class Orientation {
   private:
     Orientation() = default;
     void init();
-    void interruptHandler();
 
-    static volatile bool initialized_;
+    // degrees turned since startup, extrapolated to now
+    float getRotation();
 
-    volatile bool mpu_interrupt_ = false;
+    static volatile bool initialized_;
 
     MPU9150PittMicromouse mpu_;
-    uint16_t packet_size_ = 8;
-    uint16_t fifo_count_ = 0;
 
-    float secondary_gyro_offset_ = GYRO_SECONDARY_OFFSET;
+    GyroBiasEstimator gyro_bias_ {
+      GYRO_SECONDARY_OFFSET, GYRO_BIAS_INITIAL_VARIANCE
+    };
 
-    float raw_heading_ = 0;
+    // heading minus the rotation since startup
+    float heading_offset_ = 0;
+
+    // from the last sample taken by update()
     int16_t last_gyro_reading_ = 0;
     unsigned long last_update_time_ = 0;
-    volatile unsigned long next_update_time_ = 0;
-
-    float max_forward_accel_ = 0;
-    float max_radial_accel_ = 0;
 
     // true if we're currently over the gyro threshold
     bool over_gyro_threshold_ = false;
@@ -41,16 +52,17 @@ class Orientation {
     float mag_heading_offset_;
     float last_mag_heading_;
   public:
-    bool handler_update_ = true;
-
     // NEVER call this from an interrupt
-    // (unless you're Orientation::interruptHandler, then it's kinda maybe ok)
     static Orientation& getInstance();
 
-    // determine the right offset for the gyro
-    void calibrate();
+    // marks the robot as held still or not, so that update() refines the
+    // gyro bias in between
+    void setStationary(bool stationary);
+
+    // keeps calling update() for time ms with the robot marked still
+    void waitStationary(uint32_t time);
 
-    // get the latest data from the IMU
+    // take the oldest IMU sample not yet seen, returns false if there is none
     bool update();
 
     // designates the current heading as 0 degrees
@@ -66,9 +78,23 @@ class Orientation {
     //   or decreasing past -360
     float getHeading();
 
+    // Returns the angular velocity from the last gyro reading in degrees per
+    // second, clockwise positive like the heading
+    float getAngularVelocity();
+
+    // Returns the degrees turned clockwise since startup, from the gyro
+    // alone. Unlike the heading, this is not changed by resetHeading() or
+    // incrementHeading().
+    float getTotalRotation();
+
+    // Largest accelerations since the last reset, in m/s/s, averaged over
+    // IMU_ACCEL_PEAK_WINDOW packets so that single spikes do not count.
+    // Speeding up and slowing down are kept apart and both reset by
+    // resetMaxForwardAccel().
     void resetMaxForwardAccel();
     void resetMaxRadialAccel();
     float getMaxForwardAccel();
+    float getMaxForwardDecel();
     float getMaxRadialAccel();
 };
 
@@ -1,7 +1,16 @@
 #include <EEPROM.h>
 #include "../conf.h"
+#include "../user_interaction/Trace.h"
 #include "PersistantStorage.h"
 
+// Writes one byte and marks it on the trace timeline. saveMaze() writes every
+// cell directly and is traced as one span instead, so that it does not push
+// the rest of a run out of the trace.
+static void writeByte(uint16_t location, uint8_t value) {
+  TRACE_INSTANT("EEPROM write", location);
+  EEPROM.write(location, value);
+}
+
 int PersistantStorage::loadIntFromLocation(uint16_t high_byte_location) {
   uint16_t result = (uint16_t)EEPROM.read(high_byte_location) << 8;
   result |= EEPROM.read(high_byte_location + 1);
@@ -9,11 +18,12 @@ int PersistantStorage::loadIntFromLocation(uint16_t high_byte_location) {
 }
 
 void PersistantStorage::writeIntToLocation(uint16_t n, uint16_t high_byte_location) {
-  EEPROM.write(high_byte_location, n >> 8);
-  EEPROM.write(high_byte_location + 1, n & 0xFF);
+  writeByte(high_byte_location, n >> 8);
+  writeByte(high_byte_location + 1, n & 0xFF);
 }
 
 void PersistantStorage::saveMaze(Maze<16, 16>& maze) {
+  TRACE_BEGIN("EEPROM save maze", 0);
   for (int x = 0; x < 16; x++) {
     for (int y = 0; y < 16; y++) {
       uint8_t out = 0;
@@ -26,6 +36,7 @@ void PersistantStorage::saveMaze(Maze<16, 16>& maze) {
     }
   }
   EEPROM.write(EEPROM_MAZE_FLAG_LOCATION, 1);
+  TRACE_END("EEPROM save maze");
 }
 
 void PersistantStorage::loadSavedMaze(Maze<16, 16>& maze) {
@@ -73,13 +84,13 @@ void PersistantStorage::updateSavedMaze(Maze<16, 16>& maze, size_t x, size_t y)
   out |= maze.isWall(x, y, kSouth) << 2;
   out |= maze.isWall(x, y, kWest) << 3;
   out |= maze.isVisited(x, y) << 4;
-  EEPROM.write(EEPROM_MAZE_LOCATION + 16*x + y, out);
+  writeByte(EEPROM_MAZE_LOCATION + 16*x + y, out);
 }
 
 void PersistantStorage::clearSavedMaze() {
   Maze<16, 16> maze;
   saveMaze(maze);
-  EEPROM.write(EEPROM_MAZE_FLAG_LOCATION, 0);
+  writeByte(EEPROM_MAZE_FLAG_LOCATION, 0);
 }
 
 void PersistantStorage::resetSavedMaze() {
@@ -96,7 +107,7 @@ Compass8 PersistantStorage::getDefaultDirection() {
 }
 
 void PersistantStorage::setDefaultDirection(Compass8 dir) {
-  EEPROM.write(EEPROM_INITIAL_DIRECTION_LOCATION, (uint8_t)dir);
+  writeByte(EEPROM_INITIAL_DIRECTION_LOCATION, (uint8_t)dir);
 }
 
 uint8_t PersistantStorage::getNumRuns() {
@@ -105,7 +116,7 @@ uint8_t PersistantStorage::getNumRuns() {
 
 void PersistantStorage::setNumRuns (uint8_t num_runs) {
   if (num_runs < 6) {
-    EEPROM.write(EEPROM_NUM_RUNS_LOCATION, num_runs);
+    writeByte(EEPROM_NUM_RUNS_LOCATION, num_runs);
   }
 }
 
@@ -115,7 +126,7 @@ uint8_t PersistantStorage::getState() {
 
 void PersistantStorage::setState (uint8_t state) {
   if (state < 4) {
-    EEPROM.write(EEPROM_STATE_LOCATION, state);
+    writeByte(EEPROM_STATE_LOCATION, state);
   }
 }
 
@@ -125,7 +136,7 @@ uint8_t PersistantStorage::getTargetXLocation() {
 
 void PersistantStorage::setTargetXLocation(uint8_t x) {
   if (x < 16) {
-    EEPROM.write(EEPROM_TARGET_X_LOCATION, x);
+    writeByte(EEPROM_TARGET_X_LOCATION, x);
   }
 }
 
@@ -135,7 +146,7 @@ uint8_t PersistantStorage::getTargetYLocation() {
 
 void PersistantStorage::setTargetYLocation(uint8_t y) {
   if (y < 16) {
-    EEPROM.write(EEPROM_TARGET_Y_LOCATION, y);
+    writeByte(EEPROM_TARGET_Y_LOCATION, y);
   }
 }
 
@@ -266,3 +277,39 @@ uint16_t PersistantStorage::getRawKaosDecel() {
 void PersistantStorage::setRawKaosDecel(uint16_t decel) {
   writeIntToLocation(decel, EEPROM_KAOS_DECEL_LOCATION);
 }
+
+bool PersistantStorage::hasDrivetrainParameters() {
+  return EEPROM.read(EEPROM_DRIVETRAIN_FLAG_LOCATION) == 1;
+}
+
+void PersistantStorage::setDrivetrainParameters(float static_volts,
+                                                float volts_per_velocity,
+                                                float volts_per_accel) {
+  float scale = pow(10, PERSISTANT_STORAGE_DRIVETRAIN_DIGITS);
+  writeIntToLocation(static_volts * scale + 0.5,
+                     EEPROM_DRIVETRAIN_STATIC_LOCATION);
+  writeIntToLocation(volts_per_velocity * scale + 0.5,
+                     EEPROM_DRIVETRAIN_VELOCITY_LOCATION);
+  writeIntToLocation(volts_per_accel * scale + 0.5,
+                     EEPROM_DRIVETRAIN_ACCEL_LOCATION);
+  writeByte(EEPROM_DRIVETRAIN_FLAG_LOCATION, 1);
+}
+
+void PersistantStorage::clearDrivetrainParameters() {
+  writeByte(EEPROM_DRIVETRAIN_FLAG_LOCATION, 0);
+}
+
+float PersistantStorage::getDrivetrainStatic() {
+  return loadIntFromLocation(EEPROM_DRIVETRAIN_STATIC_LOCATION)
+         / pow(10, PERSISTANT_STORAGE_DRIVETRAIN_DIGITS);
+}
+
+float PersistantStorage::getDrivetrainVelocity() {
+  return loadIntFromLocation(EEPROM_DRIVETRAIN_VELOCITY_LOCATION)
+         / pow(10, PERSISTANT_STORAGE_DRIVETRAIN_DIGITS);
+}
+
+float PersistantStorage::getDrivetrainAccel() {
+  return loadIntFromLocation(EEPROM_DRIVETRAIN_ACCEL_LOCATION)
+         / pow(10, PERSISTANT_STORAGE_DRIVETRAIN_DIGITS);
+}
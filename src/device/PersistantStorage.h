@@ -13,6 +13,17 @@ class PersistantStorage {
     static void writeIntToLocation(uint16_t n, uint16_t high_byte_location);
 
   public:
+    // Values of getState() between runs in autoMode
+    enum RunState {
+      kRunStateIdle = 0,
+
+      // freakOut() stopped the last run
+      kRunStateCrashed = 1,
+
+      // a speed run started and has not finished yet
+      kRunStateSpeedRun = 2
+    };
+
     // Writes the current state to persistent memory
     static void saveMaze(Maze<16, 16>& maze);
 
@@ -73,6 +84,18 @@ class PersistantStorage {
     static void setRawKaosAccel(uint16_t accel);
     static uint16_t getRawKaosDecel();
     static void setRawKaosDecel(uint16_t decel);
+
+    // Motor feedforward measured by the drivetrain identification, in volts,
+    // volts per m/s and volts per m/s/s for each motor
+    static bool hasDrivetrainParameters();
+    static void setDrivetrainParameters(float static_volts,
+                                        float volts_per_velocity,
+                                        float volts_per_accel);
+    static void clearDrivetrainParameters();
+    static float getDrivetrainStatic();
+    static float getDrivetrainVelocity();
+    static float getDrivetrainAccel();
+
     static void setNumRuns(uint8_t num_runs);
     static uint8_t getNumRuns();
     static void setState(uint8_t state);
@@ -0,0 +1,125 @@
+#include <Arduino.h>
+#include <atomic>
+#include "../conf.h"
+#include "RangeAcquisition.h"
+
+// Receiver and emitter pins in channel order
+static const uint8_t kReceiverPins[RangeAcquisition::kNumSensors] = {
+  RANGE_DIAG_LEFT_PIN, RANGE_DIAG_RIGHT_PIN,
+  RANGE_FRONT_LEFT_PIN, RANGE_FRONT_RIGHT_PIN
+};
+
+static const uint8_t kEmitterPins[RangeAcquisition::kNumSensors] = {
+  EMITTER_DIAG_LEFT_PIN, EMITTER_DIAG_RIGHT_PIN,
+  EMITTER_FRONT_LEFT_PIN, EMITTER_FRONT_RIGHT_PIN
+};
+
+// Ticks in one sweep. A sensor is lit for one tick and then has to stay dark
+// for RANGE_SENSOR_OFF_TIME, and the last sensor needs a tick to finish.
+static const uint8_t kDarkSteps =
+  (RANGE_SENSOR_OFF_TIME + RANGE_SENSOR_ON_TIME - 1) / RANGE_SENSOR_ON_TIME;
+static const uint8_t kSweepSteps =
+  kDarkSteps + 1 > RangeAcquisition::kNumSensors + 1
+  ? kDarkSteps + 1 : RangeAcquisition::kNumSensors + 1;
+
+// Below the control scheduler and the encoder pins, which are more sensitive
+// to latency than the range sensors
+static const uint8_t kTimerPriority = 160;
+
+IntervalTimer RangeAcquisition::timer_;
+RangeAcquisition::Sample RangeAcquisition::buffers_[2];
+volatile uint8_t RangeAcquisition::front_ = 0;
+volatile uint32_t RangeAcquisition::sequence_ = 0;
+volatile bool RangeAcquisition::running_ = false;
+uint32_t RangeAcquisition::start_sequence_ = 0;
+uint8_t RangeAcquisition::step_ = 0;
+int RangeAcquisition::ambient_ = 0;
+
+void RangeAcquisition::tickHandler()
+{
+  Sample& back = buffers_[front_ ^ 1];
+
+  // finish the sensor that was lit during the last tick
+  if (step_ > 0 && step_ <= kNumSensors) {
+    size_t lit = step_ - 1;
+    back.raw[lit] = analogRead(kReceiverPins[lit]) - ambient_;
+    digitalWrite(kEmitterPins[lit], LOW);
+
+    if (step_ == kNumSensors) {
+      back.battery = analogRead(BATTERY_PIN);
+      back.time = micros();
+      back.sequence = sequence_;
+      std::atomic_signal_fence(std::memory_order_release);
+      front_ ^= 1;
+      sequence_++;
+    }
+  }
+
+  // then start the next one
+  if (step_ < kNumSensors) {
+    ambient_ = analogRead(kReceiverPins[step_]);
+    digitalWrite(kEmitterPins[step_], HIGH);
+  }
+
+  if (++step_ >= kSweepSteps)
+    step_ = 0;
+}
+
+void RangeAcquisition::start()
+{
+  if (running_)
+    return;
+
+  step_ = 0;
+  start_sequence_ = sequence_;
+  running_ = true;
+
+  timer_.priority(kTimerPriority);
+  timer_.begin(tickHandler, RANGE_SENSOR_ON_TIME);
+}
+
+void RangeAcquisition::stop()
+{
+  if (!running_)
+    return;
+
+  timer_.end();
+  running_ = false;
+
+  for (size_t i = 0; i < kNumSensors; i++) {
+    digitalWrite(kEmitterPins[i], LOW);
+  }
+}
+
+bool RangeAcquisition::isRunning()
+{
+  return running_;
+}
+
+bool RangeAcquisition::getLatest(Sample& sample)
+{
+  uint32_t sequence;
+
+  do {
+    sequence = sequence_;
+    if (!running_ || sequence == start_sequence_)
+      return false;
+
+    // keep the copy between the two reads of sequence_
+    std::atomic_signal_fence(std::memory_order_acquire);
+    sample = buffers_[front_];
+    std::atomic_signal_fence(std::memory_order_acquire);
+  } while (sequence != sequence_);
+
+  return true;
+}
+
+int RangeAcquisition::channelForPin(int pin)
+{
+  for (size_t i = 0; i < kNumSensors; i++) {
+    if (kReceiverPins[i] == pin)
+      return i;
+  }
+
+  return -1;
+}
@@ -0,0 +1,76 @@
+#ifndef MICROMOUSE_RANGE_ACQUISITION_H_
+#define MICROMOUSE_RANGE_ACQUISITION_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Reads the range sensors in the background from a timer interrupt
+//
+// The timer fires once every RANGE_SENSOR_ON_TIME. On each tick the sensor
+// whose emitter is on is read and switched off, then the next sensor's
+// ambient level is read and its emitter switched on, so only one emitter is
+// ever lit and no time is spent waiting. After the fourth sensor the battery
+// voltage is read for Battery, and the engine idles until the first sensor
+// has been dark for RANGE_SENSOR_OFF_TIME.
+//
+// Finished sweeps are published through a double buffer: the interrupt fills
+// the back buffer and swaps it to the front once all four readings are in.
+// getLatest() copies the front buffer and retries if a swap happened while it
+// was copying, so it never blocks on the sensors.
+//
+//   RangeAcquisition::start();
+//   ...
+//   RangeAcquisition::Sample sample;
+//   if (RangeAcquisition::getLatest(sample))
+//     use(sample.raw[RangeAcquisition::channelForPin(RANGE_DIAG_LEFT_PIN)]);
+//
+class RangeAcquisition
+{
+  public:
+    static const size_t kNumSensors = 4;
+
+    struct Sample {
+      int16_t raw[kNumSensors]; // on reading minus off reading
+      int16_t battery; // raw reading of BATTERY_PIN
+      uint32_t time; // micros() when the sweep finished
+      uint32_t sequence; // number of sweeps published before this one
+    };
+
+  private:
+    static void tickHandler();
+
+    static IntervalTimer timer_;
+    static Sample buffers_[2];
+    static volatile uint8_t front_;
+    static volatile uint32_t sequence_;
+    static volatile bool running_;
+
+    // value of sequence_ when the engine was last started
+    static uint32_t start_sequence_;
+
+    // position within the current sweep, in ticks
+    static uint8_t step_;
+
+    // off reading of the sensor whose emitter is on
+    static int ambient_;
+
+  public:
+    // Starts the timer. The emitter pins must already be outputs.
+    static void start();
+
+    // Stops the timer and switches every emitter off
+    static void stop();
+
+    static bool isRunning();
+
+    // Copies the most recent finished sweep into sample. Returns false if
+    // the engine is stopped or has not finished a sweep yet.
+    static bool getLatest(Sample& sample);
+
+    // Returns the index into Sample::raw for the given receiver pin, or -1
+    static int channelForPin(int pin);
+};
+
+#endif
@@ -1,6 +1,28 @@
 #include <Arduino.h>
 #include "../conf.h"
+#include "../user_interaction/PerfCounters.h"
+#include "RangeAcquisition.h"
 #include "RangeSensor.h"
+#include "RangeTables.h"
+
+// Make sure RangeTables.h was generated from the current constants. If this
+// fails, run tools/make_range_table.py.
+template <size_t N>
+static constexpr bool sameConstants(const float (&a)[N], const float (&b)[N],
+                                    size_t i = 0) {
+  return i == N || (a[i] == b[i] && sameConstants(a, b, i + 1));
+}
+
+#define CHECK_RANGE_TABLE(name) \
+  static constexpr float name##_CONSTANTS[] = RANGE_##name##_TRANSLATION; \
+  static constexpr float name##_SOURCE[] = RANGE_##name##_TABLE_SOURCE; \
+  static_assert(sameConstants(name##_CONSTANTS, name##_SOURCE), \
+                "RangeTables.h is out of date for " #name)
+
+CHECK_RANGE_TABLE(DIAG_LEFT);
+CHECK_RANGE_TABLE(DIAG_RIGHT);
+CHECK_RANGE_TABLE(FRONT_LEFT);
+CHECK_RANGE_TABLE(FRONT_RIGHT);
 
 RangeSensor::RangeSensor(int temp_pin, int lowT, int highT) {
   pin_ = temp_pin;
@@ -8,22 +30,22 @@ RangeSensor::RangeSensor(int temp_pin, int lowT, int highT) {
   switch (pin_) {
     case RANGE_DIAG_LEFT_PIN:
       emitter_pin_ = EMITTER_DIAG_LEFT_PIN;
-      constants_ = RANGE_DIAG_LEFT_TRANSLATION;
+      table_ = RANGE_DIAG_LEFT_TABLE;
       break;
 
     case RANGE_DIAG_RIGHT_PIN:
       emitter_pin_ = EMITTER_DIAG_RIGHT_PIN;
-      constants_ = RANGE_DIAG_RIGHT_TRANSLATION;
+      table_ = RANGE_DIAG_RIGHT_TABLE;
       break;
 
     case RANGE_FRONT_LEFT_PIN:
       emitter_pin_ = EMITTER_FRONT_LEFT_PIN;
-      constants_ = RANGE_FRONT_LEFT_TRANSLATION;
+      table_ = RANGE_FRONT_LEFT_TABLE;
       break;
 
     case RANGE_FRONT_RIGHT_PIN:
       emitter_pin_ = EMITTER_FRONT_RIGHT_PIN;
-      constants_ = RANGE_FRONT_RIGHT_TRANSLATION;
+      table_ = RANGE_FRONT_RIGHT_TABLE;
       break;
   }
 
@@ -32,8 +54,25 @@ RangeSensor::RangeSensor(int temp_pin, int lowT, int highT) {
 }
 
 void RangeSensor::updateRange() {
+  RangeAcquisition::Sample sample;
+
+  if (RangeAcquisition::getLatest(sample)) {
+    setRawReading(sample.raw[RangeAcquisition::channelForPin(pin_)],
+                  sample.time);
+  } else {
+    acquire();
+    translate();
+  }
+}
+
+void RangeSensor::setRawReading(int raw_reading, uint32_t time) {
+  last_raw_reading_ = raw_reading;
+  last_reading_time_ = time;
+  translate();
+}
+
+void RangeSensor::acquire() {
   float off_reading, on_reading;
-  float sensed_distance;
 
   while (micros() - last_reading_time_ < RANGE_SENSOR_OFF_TIME) {
     // wait until this sensor has been off for long enough to turn it on again
@@ -48,24 +87,28 @@ void RangeSensor::updateRange() {
   digitalWrite(emitter_pin_, LOW);
   last_raw_reading_ = on_reading - off_reading;
   last_reading_time_ = micros();
+}
 
-  if (last_raw_reading_ < constants_.v0) {
-    if (last_raw_reading_ - constants_.b1 < 0) {
-      sensed_distance = 2880;
-    } else {
-      sensed_distance = (constants_.a1 * pow(last_raw_reading_
-            - constants_.b1, constants_.c1) + constants_.d1) + constants_.e;
-    }
-  } else {
-    if (last_raw_reading_ - constants_.b2 < 0) {
-      sensed_distance = 2880;
-    } else {
-      sensed_distance = (constants_.a2 * pow(last_raw_reading_
-            - constants_.b2, constants_.c2) + constants_.d2) + constants_.e;
-    }
+void RangeSensor::translate() {
+  PERF_BEGIN(translate);
+  int reading = last_raw_reading_;
+
+  // anything below zero is noise, which means nothing is in range
+  if (reading < 0) {
+    reading = 0;
+  } else if (reading > RANGE_TABLE_MAX_READING) {
+    reading = RANGE_TABLE_MAX_READING;
   }
 
-  last_reading_ = sensed_distance;
+#if RANGE_TABLE_STEP > 1
+  int index = reading / RANGE_TABLE_STEP;
+  int fraction = reading % RANGE_TABLE_STEP;
+  last_reading_ = table_[index]
+    + ((table_[index + 1] - table_[index]) * fraction) / RANGE_TABLE_STEP;
+#else
+  last_reading_ = table_[reading];
+#endif
+  PERF_END(translate, kPerfRangeTranslate);
 }
 
 int RangeSensor::getRange() {
@@ -87,6 +130,14 @@ int RangeSensor::getRawReading() {
     return last_raw_reading_;
 }
 
+uint32_t RangeSensor::getReadingTime() {
+  return last_reading_time_;
+}
+
+int RangeSensor::getPin() {
+  return pin_;
+}
+
 bool RangeSensor::isWall() {
 
   getRange();
@@ -16,24 +16,36 @@ class RangeSensor {
   int pin_;
   int emitter_pin_;
 
-  struct TranslationConstants {
-    float a1, b1, c1, d1;
-    float a2, b2, c2, d2;
-    float v0;
-    float e;
-  };
+  // distance in mm for each raw reading, from RangeTables.h
+  const uint16_t* table_;
 
-  TranslationConstants constants_;
+  // pulses the emitter and reads the receiver, blocking for about 300 us
+  void acquire();
+
+  // converts last_raw_reading_ to a distance with a table lookup
+  void translate();
 
  public:
   RangeSensor(int temp_pin, int lowT, int highT);
+
+  // Takes the latest reading from RangeAcquisition if it is running,
+  // otherwise reads the sensor directly
   void updateRange();
+
+  // Sets the reading to a raw value acquired elsewhere
+  void setRawReading(int raw_reading, uint32_t time);
+
   int getRange();
   int getRange(int index);
 
   // returns the raw result of the last reading
   int getRawReading();
-  
+
+  // returns micros() at the time of the last reading
+  uint32_t getReadingTime();
+
+  int getPin();
+
   bool isWall();
 };
 
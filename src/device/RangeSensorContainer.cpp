@@ -1,4 +1,6 @@
 #include "../conf.h"
+#include "../user_interaction/Trace.h"
+#include "RangeAcquisition.h"
 #include "RangeSensorContainer.h"
 
 RangeSensorContainer RangeSensors;
@@ -12,6 +14,23 @@ RangeSensorContainer::RangeSensorContainer()
 }
 
 void RangeSensorContainer::updateReadings() {
+	RangeAcquisition::Sample sample;
+
+	if (RangeAcquisition::getLatest(sample)) {
+		// only translate a sweep once
+		if (sample.sequence == last_sequence_)
+			return;
+
+		last_sequence_ = sample.sequence;
+		RangeSensor* sensors[] = { &diagLeftSensor, &diagRightSensor,
+		                           &frontLeftSensor, &frontRightSensor };
+		for (RangeSensor* sensor : sensors) {
+			int channel = RangeAcquisition::channelForPin(sensor->getPin());
+			sensor->setRawReading(sample.raw[channel], sample.time);
+		}
+		return;
+	}
+
 	diagLeftSensor.updateRange();
 	diagRightSensor.updateRange();
 	frontLeftSensor.updateRange();
@@ -41,6 +60,7 @@ void RangeSensorContainer::saveIsWall()
 {
   saved_left_ = diagLeftSensor.isWall();
   saved_right_ = diagRightSensor.isWall();
+  TRACE_INSTANT("saveIsWall", saved_left_ << 1 | saved_right_);
 }
 
 bool RangeSensorContainer::savedIsWall(Direction wallToCheck) {
@@ -16,12 +16,17 @@ class RangeSensorContainer {
 	private:
 		bool saved_left_ = true;
 		bool saved_right_ = true;
+
+		// sequence number of the last sweep taken from RangeAcquisition
+		uint32_t last_sequence_ = 0xFFFFFFFF;
 	
 	public:
 		RangeSensorContainer();
 		RangeSensor diagLeftSensor, diagRightSensor;
 		RangeSensor frontLeftSensor, frontRightSensor;
 
+		// Takes the latest sweep from RangeAcquisition without blocking if it
+		// is running, otherwise reads each sensor in turn
 		void updateReadings();
 		bool isWall(Direction wallToCheck); //Maybe directly return error for pid 
 		void saveIsWall();
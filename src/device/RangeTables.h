@@ -0,0 +1,372 @@
+#ifndef MICROMOUSE_RANGE_TABLES_H_
+#define MICROMOUSE_RANGE_TABLES_H_
+
+// Generated by tools/make_range_table.py from conf.h, do not edit
+
+#include <Arduino.h>
+
+#define RANGE_TABLE_STEP 1
+#define RANGE_TABLE_MAX_READING 1023
+#define RANGE_TABLE_SIZE 1025
+
+#define RANGE_DIAG_LEFT_TABLE_SOURCE { 204279.127508, -140.177058331, -1.17485565668, 4.26428490432, -0.0004, 774., 2.29, 68., 774.051196698, 0 }
+static const uint16_t RANGE_DIAG_LEFT_TABLE[RANGE_TABLE_SIZE] = {
+  618, 613, 608, 603, 598, 593, 588, 584, 579, 575, 570, 566,
+  561, 557, 553, 549, 545, 541, 537, 533, 529, 525, 521, 517,
+  514, 510, 507, 503, 500, 496, 493, 489, 486, 483, 480, 476,
+  473, 470, 467, 464, 461, 458, 455, 452, 449, 446, 444, 441,
+  438, 436, 433, 430, 428, 425, 422, 420, 417, 415, 413, 410,
+  408, 405, 403, 401, 398, 396, 394, 392, 390, 387, 385, 383,
+  381, 379, 377, 375, 373, 371, 369, 367, 365, 363, 361, 359,
+  357, 356, 354, 352, 350, 348, 347, 345, 343, 341, 340, 338,
+  336, 335, 333, 332, 330, 328, 327, 325, 324, 322, 321, 319,
+  318, 316, 315, 313, 312, 310, 309, 308, 306, 305, 303, 302,
+  301, 299, 298, 297, 295, 294, 293, 292, 290, 289, 288, 287,
+  285, 284, 283, 282, 281, 279, 278, 277, 276, 275, 274, 273,
+  271, 270, 269, 268, 267, 266, 265, 264, 263, 262, 261, 260,
+  259, 258, 257, 256, 255, 254, 253, 252, 251, 250, 249, 248,
+  247, 246, 245, 244, 243, 243, 242, 241, 240, 239, 238, 237,
+  236, 236, 235, 234, 233, 232, 231, 231, 230, 229, 228, 227,
+  227, 226, 225, 224, 223, 223, 222, 221, 220, 220, 219, 218,
+  217, 217, 216, 215, 215, 214, 213, 213, 212, 211, 210, 210,
+  209, 208, 208, 207, 206, 206, 205, 204, 204, 203, 202, 202,
+  201, 201, 200, 199, 199, 198, 198, 197, 196, 196, 195, 195,
+  194, 193, 193, 192, 192, 191, 190, 190, 189, 189, 188, 188,
+  187, 187, 186, 185, 185, 184, 184, 183, 183, 182, 182, 181,
+  181, 180, 180, 179, 179, 178, 178, 177, 177, 176, 176, 175,
+  175, 174, 174, 173, 173, 172, 172, 171, 171, 171, 170, 170,
+  169, 169, 168, 168, 167, 167, 166, 166, 166, 165, 165, 164,
+  164, 163, 163, 163, 162, 162, 161, 161, 160, 160, 160, 159,
+  159, 158, 158, 158, 157, 157, 156, 156, 156, 155, 155, 155,
+  154, 154, 153, 153, 153, 152, 152, 152, 151, 151, 150, 150,
+  150, 149, 149, 149, 148, 148, 148, 147, 147, 147, 146, 146,
+  146, 145, 145, 145, 144, 144, 143, 143, 143, 143, 142, 142,
+  142, 141, 141, 141, 140, 140, 140, 139, 139, 139, 138, 138,
+  138, 137, 137, 137, 137, 136, 136, 136, 135, 135, 135, 134,
+  134, 134, 134, 133, 133, 133, 132, 132, 132, 132, 131, 131,
+  131, 130, 130, 130, 130, 129, 129, 129, 129, 128, 128, 128,
+  127, 127, 127, 127, 126, 126, 126, 126, 125, 125, 125, 125,
+  124, 124, 124, 124, 123, 123, 123, 123, 122, 122, 122, 122,
+  121, 121, 121, 121, 120, 120, 120, 120, 119, 119, 119, 119,
+  119, 118, 118, 118, 118, 117, 117, 117, 117, 117, 116, 116,
+  116, 116, 115, 115, 115, 115, 115, 114, 114, 114, 114, 113,
+  113, 113, 113, 113, 112, 112, 112, 112, 112, 111, 111, 111,
+  111, 111, 110, 110, 110, 110, 110, 109, 109, 109, 109, 109,
+  108, 108, 108, 108, 108, 107, 107, 107, 107, 107, 106, 106,
+  106, 106, 106, 106, 105, 105, 105, 105, 105, 104, 104, 104,
+  104, 104, 104, 103, 103, 103, 103, 103, 102, 102, 102, 102,
+  102, 102, 101, 101, 101, 101, 101, 101, 100, 100, 100, 100,
+  100, 100, 99, 99, 99, 99, 99, 99, 98, 98, 98, 98,
+  98, 98, 98, 97, 97, 97, 97, 97, 97, 96, 96, 96,
+  96, 96, 96, 95, 95, 95, 95, 95, 95, 95, 94, 94,
+  94, 94, 94, 94, 94, 93, 93, 93, 93, 93, 93, 93,
+  92, 92, 92, 92, 92, 92, 92, 91, 91, 91, 91, 91,
+  91, 91, 90, 90, 90, 90, 90, 90, 90, 89, 89, 89,
+  89, 89, 89, 89, 89, 88, 88, 88, 88, 88, 88, 88,
+  87, 87, 87, 87, 87, 87, 87, 87, 86, 86, 86, 86,
+  86, 86, 86, 86, 85, 85, 85, 85, 85, 85, 85, 85,
+  85, 84, 84, 84, 84, 84, 84, 84, 84, 83, 83, 83,
+  83, 83, 83, 83, 83, 83, 82, 82, 82, 82, 82, 82,
+  82, 82, 81, 81, 81, 81, 81, 81, 81, 81, 81, 80,
+  80, 80, 80, 80, 80, 80, 80, 80, 80, 79, 79, 79,
+  79, 79, 79, 79, 79, 79, 78, 78, 78, 78, 78, 78,
+  78, 78, 78, 78, 77, 77, 77, 77, 77, 77, 77, 77,
+  77, 77, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76,
+  75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 74, 74,
+  74, 74, 74, 74, 74, 74, 74, 74, 74, 73, 73, 73,
+  73, 73, 73, 73, 73, 73, 73, 73, 72, 72, 72, 72,
+  72, 72, 72, 72, 72, 72, 72, 67, 67, 67, 67, 67,
+  67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67,
+  67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 67,
+  67, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+  65, 65, 65, 65, 65, 65, 65, 65, 64, 64, 64, 64,
+  64, 64, 63, 63, 63, 63, 63, 63, 62, 62, 62, 62,
+  62, 61, 61, 61, 61, 61, 60, 60, 60, 60, 59, 59,
+  59, 59, 58, 58, 58, 58, 57, 57, 57, 56, 56, 56,
+  56, 55, 55, 55, 54, 54, 54, 53, 53, 53, 52, 52,
+  52, 51, 51, 50, 50, 50, 49, 49, 49, 48, 48, 47,
+  47, 47, 46, 46, 45, 45, 44, 44, 44, 43, 43, 42,
+  42, 41, 41, 40, 40, 39, 39, 38, 38, 37, 37, 36,
+  36, 35, 35, 34, 34, 33, 32, 32, 31, 31, 30, 30,
+  29, 28, 28, 27, 27, 26, 25, 25, 24, 24, 23, 22,
+  22, 21, 20, 20, 19, 18, 18, 17, 16, 16, 15, 14,
+  13, 13, 12, 11, 11, 10, 9, 8, 8, 7, 6, 5,
+  5, 4, 3, 2, 1, 1, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0,
+};
+
+#define RANGE_DIAG_RIGHT_TABLE_SOURCE { 1599.06663151, 27.8878612466, -0.225900340991, -274.178607786, -0.0007, 745., 2.29, 85., 746.880064643, 0 }
+static const uint16_t RANGE_DIAG_RIGHT_TABLE[RANGE_TABLE_SIZE] = {
+  2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880,
+  2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880, 2880,
+  2880, 2880, 2880, 2880, 2347, 1286, 1076, 963, 887, 831, 788, 752,
+  722, 696, 673, 653, 636, 619, 605, 591, 579, 567, 556, 546,
+  537, 528, 520, 512, 504, 497, 491, 484, 478, 472, 466, 461,
+  456, 451, 446, 441, 437, 432, 428, 424, 420, 416, 412, 409,
+  405, 402, 398, 395, 392, 389, 386, 383, 380, 377, 374, 372,
+  369, 367, 364, 362, 359, 357, 355, 352, 350, 348, 346, 344,
+  342, 340, 338, 336, 334, 332, 330, 328, 326, 325, 323, 321,
+  319, 318, 316, 314, 313, 311, 310, 308, 307, 305, 304, 302,
+  301, 300, 298, 297, 295, 294, 293, 291, 290, 289, 288, 286,
+  285, 284, 283, 282, 280, 279, 278, 277, 276, 275, 274, 273,
+  272, 271, 269, 268, 267, 266, 265, 264, 263, 262, 261, 261,
+  260, 259, 258, 257, 256, 255, 254, 253, 252, 251, 251, 250,
+  249, 248, 247, 246, 246, 245, 244, 243, 242, 242, 241, 240,
+  239, 239, 238, 237, 236, 236, 235, 234, 233, 233, 232, 231,
+  231, 230, 229, 228, 228, 227, 226, 226, 225, 224, 224, 223,
+  223, 222, 221, 221, 220, 219, 219, 218, 218, 217, 216, 216,
+  215, 215, 214, 213, 213, 212, 212, 211, 211, 210, 209, 209,
+  208, 208, 207, 207, 206, 206, 205, 205, 204, 204, 203, 203,
+  202, 202, 201, 201, 200, 200, 199, 199, 198, 198, 197, 197,
+  196, 196, 195, 195, 194, 194, 193, 193, 192, 192, 192, 191,
+  191, 190, 190, 189, 189, 188, 188, 188, 187, 187, 186, 186,
+  185, 185, 185, 184, 184, 183, 183, 183, 182, 182, 181, 181,
+  181, 180, 180, 179, 179, 179, 178, 178, 177, 177, 177, 176,
+  176, 176, 175, 175, 175, 174, 174, 173, 173, 173, 172, 172,
+  172, 171, 171, 171, 170, 170, 170, 169, 169, 168, 168, 168,
+  167, 167, 167, 166, 166, 166, 165, 165, 165, 164, 164, 164,
+  164, 163, 163, 163, 162, 162, 162, 161, 161, 161, 160, 160,
+  160, 159, 159, 159, 159, 158, 158, 158, 157, 157, 157, 156,
+  156, 156, 156, 155, 155, 155, 154, 154, 154, 154, 153, 153,
+  153, 152, 152, 152, 152, 151, 151, 151, 150, 150, 150, 150,
+  149, 149, 149, 149, 148, 148, 148, 148, 147, 147, 147, 147,
+  146, 146, 146, 145, 145, 145, 145, 144, 144, 144, 144, 143,
+  143, 143, 143, 142, 142, 142, 142, 141, 141, 141, 141, 141,
+  140, 140, 140, 140, 139, 139, 139, 139, 138, 138, 138, 138,
+  137, 137, 137, 137, 137, 136, 136, 136, 136, 135, 135, 135,
+  135, 135, 134, 134, 134, 134, 133, 133, 133, 133, 133, 132,
+  132, 132, 132, 131, 131, 131, 131, 131, 130, 130, 130, 130,
+  130, 129, 129, 129, 129, 129, 128, 128, 128, 128, 128, 127,
+  127, 127, 127, 127, 126, 126, 126, 126, 126, 125, 125, 125,
+  125, 125, 124, 124, 124, 124, 124, 123, 123, 123, 123, 123,
+  122, 122, 122, 122, 122, 122, 121, 121, 121, 121, 121, 120,
+  120, 120, 120, 120, 120, 119, 119, 119, 119, 119, 118, 118,
+  118, 118, 118, 118, 117, 117, 117, 117, 117, 117, 116, 116,
+  116, 116, 116, 115, 115, 115, 115, 115, 115, 114, 114, 114,
+  114, 114, 114, 113, 113, 113, 113, 113, 113, 112, 112, 112,
+  112, 112, 112, 111, 111, 111, 111, 111, 111, 111, 110, 110,
+  110, 110, 110, 110, 109, 109, 109, 109, 109, 109, 108, 108,
+  108, 108, 108, 108, 108, 107, 107, 107, 107, 107, 107, 106,
+  106, 106, 106, 106, 106, 106, 105, 105, 105, 105, 105, 105,
+  105, 104, 104, 104, 104, 104, 104, 104, 103, 103, 103, 103,
+  103, 103, 103, 102, 102, 102, 102, 102, 102, 102, 101, 101,
+  101, 101, 101, 101, 101, 100, 100, 100, 100, 100, 100, 100,
+  99, 99, 99, 99, 99, 99, 99, 99, 98, 98, 98, 98,
+  98, 98, 98, 97, 97, 97, 97, 97, 97, 97, 97, 96,
+  96, 96, 96, 96, 96, 96, 96, 95, 95, 95, 95, 95,
+  95, 95, 94, 94, 94, 94, 94, 94, 94, 94, 93, 93,
+  93, 93, 93, 93, 93, 93, 92, 92, 92, 92, 92, 92,
+  92, 92, 92, 91, 91, 91, 91, 91, 91, 91, 91, 90,
+  90, 90, 90, 90, 90, 90, 90, 89, 89, 89, 89, 89,
+  89, 89, 89, 89, 88, 88, 88, 88, 88, 88, 88, 88,
+  88, 87, 87, 84, 84, 84, 84, 84, 84, 84, 84, 84,
+  84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84,
+  84, 83, 83, 83, 83, 83, 83, 83, 83, 83, 82, 82,
+  82, 82, 82, 82, 81, 81, 81, 81, 81, 80, 80, 80,
+  80, 80, 79, 79, 79, 79, 78, 78, 78, 77, 77, 77,
+  77, 76, 76, 76, 75, 75, 75, 74, 74, 73, 73, 73,
+  72, 72, 72, 71, 71, 70, 70, 69, 69, 69, 68, 68,
+  67, 67, 66, 66, 65, 65, 64, 64, 63, 63, 62, 61,
+  61, 60, 60, 59, 58, 58, 57, 57, 56, 55, 55, 54,
+  53, 53, 52, 51, 51, 50, 49, 49, 48, 47, 46, 46,
+  45, 44, 43, 43, 42, 41, 40, 39, 38, 38, 37, 36,
+  35, 34, 33, 32, 32, 31, 30, 29, 28, 27, 26, 25,
+  24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13,
+  12, 11, 10, 9, 8, 6, 5, 4, 3, 2, 1, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0,
+};
+
+#define RANGE_FRONT_LEFT_TABLE_SOURCE { 982.981088769, 3.01477552114, -0.290806601873, -105.008228929, -0.0006, 880, 2.4, 33, 880.068342392, 0 }
+static const uint16_t RANGE_FRONT_LEFT_TABLE[RANGE_TABLE_SIZE] = {
+  2880, 2880, 2880, 2880, 882, 700, 610, 552, 511, 479, 453, 432,
+  414, 398, 384, 372, 361, 351, 342, 334, 326, 319, 312, 306,
+  300, 295, 290, 285, 280, 276, 272, 268, 264, 260, 257, 253,
+  250, 247, 244, 241, 238, 236, 233, 231, 228, 226, 224, 222,
+  219, 217, 215, 213, 211, 210, 208, 206, 204, 203, 201, 199,
+  198, 196, 195, 193, 192, 191, 189, 188, 186, 185, 184, 183,
+  181, 180, 179, 178, 177, 176, 175, 173, 172, 171, 170, 169,
+  168, 167, 166, 165, 165, 164, 163, 162, 161, 160, 159, 158,
+  158, 157, 156, 155, 154, 154, 153, 152, 151, 151, 150, 149,
+  148, 148, 147, 146, 146, 145, 144, 144, 143, 142, 142, 141,
+  141, 140, 139, 139, 138, 138, 137, 136, 136, 135, 135, 134,
+  134, 133, 133, 132, 132, 131, 131, 130, 130, 129, 129, 128,
+  128, 127, 127, 126, 126, 125, 125, 124, 124, 123, 123, 123,
+  122, 122, 121, 121, 120, 120, 120, 119, 119, 118, 118, 118,
+  117, 117, 116, 116, 116, 115, 115, 115, 114, 114, 113, 113,
+  113, 112, 112, 112, 111, 111, 111, 110, 110, 110, 109, 109,
+  109, 108, 108, 108, 107, 107, 107, 106, 106, 106, 105, 105,
+  105, 104, 104, 104, 104, 103, 103, 103, 102, 102, 102, 102,
+  101, 101, 101, 100, 100, 100, 100, 99, 99, 99, 99, 98,
+  98, 98, 97, 97, 97, 97, 96, 96, 96, 96, 95, 95,
+  95, 95, 94, 94, 94, 94, 93, 93, 93, 93, 93, 92,
+  92, 92, 92, 91, 91, 91, 91, 90, 90, 90, 90, 90,
+  89, 89, 89, 89, 89, 88, 88, 88, 88, 87, 87, 87,
+  87, 87, 86, 86, 86, 86, 86, 85, 85, 85, 85, 85,
+  84, 84, 84, 84, 84, 83, 83, 83, 83, 83, 83, 82,
+  82, 82, 82, 82, 81, 81, 81, 81, 81, 81, 80, 80,
+  80, 80, 80, 80, 79, 79, 79, 79, 79, 78, 78, 78,
+  78, 78, 78, 77, 77, 77, 77, 77, 77, 77, 76, 76,
+  76, 76, 76, 76, 75, 75, 75, 75, 75, 75, 74, 74,
+  74, 74, 74, 74, 74, 73, 73, 73, 73, 73, 73, 73,
+  72, 72, 72, 72, 72, 72, 72, 71, 71, 71, 71, 71,
+  71, 71, 70, 70, 70, 70, 70, 70, 70, 69, 69, 69,
+  69, 69, 69, 69, 69, 68, 68, 68, 68, 68, 68, 68,
+  68, 67, 67, 67, 67, 67, 67, 67, 66, 66, 66, 66,
+  66, 66, 66, 66, 66, 65, 65, 65, 65, 65, 65, 65,
+  65, 64, 64, 64, 64, 64, 64, 64, 64, 63, 63, 63,
+  63, 63, 63, 63, 63, 63, 62, 62, 62, 62, 62, 62,
+  62, 62, 62, 61, 61, 61, 61, 61, 61, 61, 61, 61,
+  61, 60, 60, 60, 60, 60, 60, 60, 60, 60, 59, 59,
+  59, 59, 59, 59, 59, 59, 59, 59, 58, 58, 58, 58,
+  58, 58, 58, 58, 58, 58, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 56, 56, 56, 56, 56, 56, 56, 56,
+  56, 56, 56, 55, 55, 55, 55, 55, 55, 55, 55, 55,
+  55, 55, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54,
+  54, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53,
+  52, 52, 52, 52, 52, 52, 52, 52, 52, 52, 52, 52,
+  51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51,
+  50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50,
+  50, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49,
+  49, 49, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+  48, 48, 48, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+  47, 47, 47, 47, 47, 46, 46, 46, 46, 46, 46, 46,
+  46, 46, 46, 46, 46, 46, 46, 45, 45, 45, 45, 45,
+  45, 45, 45, 45, 45, 45, 45, 45, 45, 44, 44, 44,
+  44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44,
+  43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43,
+  43, 43, 43, 43, 42, 42, 42, 42, 42, 42, 42, 42,
+  42, 42, 42, 42, 42, 42, 42, 42, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, 40, 40, 39, 39, 39, 39, 39, 39, 39,
+  39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 38, 38,
+  38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+  38, 38, 38, 38, 37, 37, 37, 37, 37, 37, 37, 37,
+  37, 37, 37, 37, 37, 37, 37, 37, 37, 37, 37, 36,
+  36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+  36, 36, 36, 36, 36, 36, 35, 35, 35, 35, 35, 35,
+  35, 35, 35, 35, 35, 35, 35, 35, 35, 35, 35, 35,
+  35, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+  34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 33, 33,
+  33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33, 33,
+  33, 33, 33, 33, 33, 33, 33, 32, 32, 32, 32, 32,
+  32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32,
+  32, 32, 32, 32, 31, 32, 32, 32, 32, 32, 32, 32,
+  32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32,
+  32, 32, 32, 31, 31, 31, 31, 31, 31, 31, 30, 30,
+  30, 30, 30, 29, 29, 29, 29, 29, 28, 28, 28, 28,
+  27, 27, 27, 26, 26, 26, 25, 25, 25, 24, 24, 23,
+  23, 23, 22, 22, 21, 21, 20, 20, 20, 19, 19, 18,
+  17, 17, 16, 16, 15, 15, 14, 14, 13, 12, 12, 11,
+  10, 10, 9, 8, 8, 7, 6, 5, 5, 4, 3, 2,
+  2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0,
+};
+
+#define RANGE_FRONT_RIGHT_TABLE_SOURCE { 3003.86136476, -27.8333578541, -0.546648961093, -23.5867782255, -0.0005, 818, 2.26, 50, 819.033713553, 6 }
+static const uint16_t RANGE_FRONT_RIGHT_TABLE[RANGE_TABLE_SIZE] = {
+  469, 460, 451, 443, 435, 427, 420, 413, 407, 400, 394, 388,
+  383, 377, 372, 367, 362, 358, 353, 349, 345, 340, 337, 333,
+  329, 325, 322, 318, 315, 312, 309, 306, 303, 300, 297, 294,
+  292, 289, 286, 284, 282, 279, 277, 274, 272, 270, 268, 266,
+  264, 262, 260, 258, 256, 254, 252, 251, 249, 247, 245, 244,
+  242, 240, 239, 237, 236, 234, 233, 231, 230, 229, 227, 226,
+  224, 223, 222, 221, 219, 218, 217, 216, 214, 213, 212, 211,
+  210, 209, 208, 207, 206, 204, 203, 202, 201, 200, 199, 198,
+  198, 197, 196, 195, 194, 193, 192, 191, 190, 189, 189, 188,
+  187, 186, 185, 184, 184, 183, 182, 181, 181, 180, 179, 178,
+  178, 177, 176, 175, 175, 174, 173, 173, 172, 171, 171, 170,
+  169, 169, 168, 168, 167, 166, 166, 165, 164, 164, 163, 163,
+  162, 162, 161, 160, 160, 159, 159, 158, 158, 157, 157, 156,
+  156, 155, 155, 154, 154, 153, 153, 152, 152, 151, 151, 150,
+  150, 149, 149, 148, 148, 147, 147, 147, 146, 146, 145, 145,
+  144, 144, 144, 143, 143, 142, 142, 141, 141, 141, 140, 140,
+  139, 139, 139, 138, 138, 138, 137, 137, 136, 136, 136, 135,
+  135, 135, 134, 134, 134, 133, 133, 132, 132, 132, 131, 131,
+  131, 130, 130, 130, 129, 129, 129, 128, 128, 128, 128, 127,
+  127, 127, 126, 126, 126, 125, 125, 125, 124, 124, 124, 124,
+  123, 123, 123, 122, 122, 122, 122, 121, 121, 121, 121, 120,
+  120, 120, 119, 119, 119, 119, 118, 118, 118, 118, 117, 117,
+  117, 117, 116, 116, 116, 116, 115, 115, 115, 115, 114, 114,
+  114, 114, 113, 113, 113, 113, 113, 112, 112, 112, 112, 111,
+  111, 111, 111, 110, 110, 110, 110, 110, 109, 109, 109, 109,
+  109, 108, 108, 108, 108, 107, 107, 107, 107, 107, 106, 106,
+  106, 106, 106, 105, 105, 105, 105, 105, 104, 104, 104, 104,
+  104, 104, 103, 103, 103, 103, 103, 102, 102, 102, 102, 102,
+  102, 101, 101, 101, 101, 101, 100, 100, 100, 100, 100, 100,
+  99, 99, 99, 99, 99, 99, 98, 98, 98, 98, 98, 98,
+  97, 97, 97, 97, 97, 97, 96, 96, 96, 96, 96, 96,
+  96, 95, 95, 95, 95, 95, 95, 94, 94, 94, 94, 94,
+  94, 94, 93, 93, 93, 93, 93, 93, 93, 92, 92, 92,
+  92, 92, 92, 92, 91, 91, 91, 91, 91, 91, 91, 90,
+  90, 90, 90, 90, 90, 90, 89, 89, 89, 89, 89, 89,
+  89, 89, 88, 88, 88, 88, 88, 88, 88, 88, 87, 87,
+  87, 87, 87, 87, 87, 87, 86, 86, 86, 86, 86, 86,
+  86, 86, 85, 85, 85, 85, 85, 85, 85, 85, 84, 84,
+  84, 84, 84, 84, 84, 84, 84, 83, 83, 83, 83, 83,
+  83, 83, 83, 83, 82, 82, 82, 82, 82, 82, 82, 82,
+  82, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 80,
+  80, 80, 80, 80, 80, 80, 80, 80, 80, 79, 79, 79,
+  79, 79, 79, 79, 79, 79, 79, 78, 78, 78, 78, 78,
+  78, 78, 78, 78, 78, 77, 77, 77, 77, 77, 77, 77,
+  77, 77, 77, 77, 76, 76, 76, 76, 76, 76, 76, 76,
+  76, 76, 76, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+  75, 75, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+  74, 74, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73,
+  73, 73, 72, 72, 72, 72, 72, 72, 72, 72, 72, 72,
+  72, 72, 71, 71, 71, 71, 71, 71, 71, 71, 71, 71,
+  71, 71, 71, 70, 70, 70, 70, 70, 70, 70, 70, 70,
+  70, 70, 70, 70, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 67, 67, 67, 67,
+  67, 67, 67, 67, 67, 67, 67, 67, 67, 67, 66, 66,
+  66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66, 66,
+  66, 65, 65, 65, 65, 65, 65, 65, 65, 65, 65, 65,
+  65, 65, 65, 65, 65, 64, 64, 64, 64, 64, 64, 64,
+  64, 64, 64, 64, 64, 64, 64, 64, 64, 63, 63, 63,
+  63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+  63, 63, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+  62, 62, 62, 62, 62, 62, 62, 61, 61, 61, 61, 61,
+  61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61,
+  61, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60,
+  60, 60, 60, 60, 60, 60, 60, 60, 59, 59, 59, 59,
+  59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+  59, 59, 59, 58, 58, 58, 58, 58, 58, 58, 58, 58,
+  58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 57,
+  57, 57, 57, 57, 55, 55, 55, 55, 55, 55, 55, 55,
+  55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55,
+  55, 55, 55, 55, 55, 55, 55, 54, 54, 54, 54, 54,
+  54, 54, 54, 54, 54, 54, 53, 53, 53, 53, 53, 53,
+  53, 52, 52, 52, 52, 52, 52, 52, 51, 51, 51, 51,
+  51, 50, 50, 50, 50, 50, 49, 49, 49, 49, 49, 48,
+  48, 48, 48, 47, 47, 47, 47, 46, 46, 46, 46, 45,
+  45, 45, 44, 44, 44, 43, 43, 43, 42, 42, 42, 41,
+  41, 41, 40, 40, 40, 39, 39, 39, 38, 38, 37, 37,
+  37, 36, 36, 35, 35, 35, 34, 34, 33, 33, 32, 32,
+  31, 31, 31, 30, 30, 29, 29, 28, 28, 27, 27, 26,
+  26, 25, 24, 24, 23, 23, 22, 22, 21, 21, 20, 20,
+  19, 18, 18, 17, 17, 16, 15, 15, 14, 13, 13, 12,
+  12, 11, 10, 10, 9, 8, 8, 7, 6, 6, 5, 4,
+  3, 3, 2, 1, 1, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0,
+};
+
+#endif
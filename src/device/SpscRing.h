@@ -0,0 +1,85 @@
+#ifndef MICROMOUSE_SPSC_RING_H_
+#define MICROMOUSE_SPSC_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Lock-free ring buffer for one producer and one consumer
+//
+// Meant for handing samples from an interrupt to the control loop without
+// disabling interrupts. Only the producer writes head_ and only the consumer
+// writes tail_. Each side publishes its index with a release store after it
+// is done with the slot, and reads the other side's index with an acquire
+// load before touching a slot, so an item is never read half written or
+// overwritten while it is being read. That holds between threads on the host
+// as well as between an interrupt and the loop on the Teensy.
+//
+// The indexes count up forever and wrap around at 2^32, which is why the
+// capacity must be a power of two. When the ring is full push() fails rather
+// than overwrite, since only the consumer may move tail_.
+//
+//   static SpscRing<Sample, 64> ring;
+//   // in the interrupt
+//   if (!ring.push(sample)) dropped++;
+//   // in the loop
+//   while (ring.pop(sample)) use(sample);
+//
+template <typename T, size_t N>
+class SpscRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+  private:
+    T items_[N];
+    std::atomic<uint32_t> head_; // next slot to write
+    std::atomic<uint32_t> tail_; // next slot to read
+
+  public:
+    SpscRing() : head_(0), tail_(0) {}
+
+    // Producer only. Returns false, dropping item, if the ring is full.
+    bool push(const T& item)
+    {
+      uint32_t head = head_.load(std::memory_order_relaxed);
+      if (head - tail_.load(std::memory_order_acquire) >= N)
+        return false;
+
+      items_[head & (N - 1)] = item;
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer only. Returns false if the ring is empty.
+    bool pop(T& item)
+    {
+      uint32_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail == head_.load(std::memory_order_acquire))
+        return false;
+
+      item = items_[tail & (N - 1)];
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer only. Throws away every item in the ring.
+    void clear()
+    {
+      tail_.store(head_.load(std::memory_order_acquire),
+                  std::memory_order_release);
+    }
+
+    // Either side, so only a snapshot
+    size_t size() const
+    {
+      return head_.load(std::memory_order_acquire)
+             - tail_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr size_t capacity() { return N; }
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include <Arduino.h>
+#include "../conf.h"
+#include "WallEvidence.h"
+
+WallEvidence wallEvidence;
+
+WallEvidence::WallEvidence()
+{
+  reset();
+}
+
+void WallEvidence::reset()
+{
+  for (int i = 0; i < 3; i++) {
+    votes_[i] = 0;
+    weights_[i] = 0;
+  }
+}
+
+void WallEvidence::addVote(Direction dir, float threshold, float reading,
+                           float weight)
+{
+  float vote = (threshold - reading) / WALL_EVIDENCE_MARGIN;
+
+  if (vote > 1) {
+    vote = 1;
+  } else if (vote < -1) {
+    vote = -1;
+  }
+
+  votes_[dir] += weight * vote;
+  weights_[dir] += weight;
+}
+
+void WallEvidence::addSample(float distance_to_end)
+{
+  if (distance_to_end < 0 || distance_to_end > WALL_EVIDENCE_WINDOW)
+    return;
+
+  float weight = 1 - distance_to_end / WALL_EVIDENCE_WINDOW;
+
+  // a sliver of weight so that a sample at the very start still counts
+  if (weight < 0.01)
+    weight = 0.01;
+
+  addVote(left, DIAG_LEFT_LOW_THRESHOLD,
+          RangeSensors.diagLeftSensor.getRange(1), weight);
+  addVote(right, DIAG_RIGHT_LOW_THRESHOLD,
+          RangeSensors.diagRightSensor.getRange(1), weight);
+
+  // same test as RangeSensorContainer::isWall(front)
+  float front_reading = (RangeSensors.frontLeftSensor.getRange(1)
+                         + RangeSensors.frontRightSensor.getRange(1)) / 2;
+  addVote(front, FRONT_LEFT_LOW_THRESHOLD + distance_to_end, front_reading,
+          weight);
+}
+
+bool WallEvidence::hasEvidence(Direction dir)
+{
+  if (dir == back)
+    return false;
+
+  return weights_[dir] > 0;
+}
+
+bool WallEvidence::isWall(Direction dir)
+{
+  if (!hasEvidence(dir))
+    return false;
+
+  return votes_[dir] > 0;
+}
+
+float WallEvidence::getConfidence(Direction dir)
+{
+  if (!hasEvidence(dir))
+    return 0;
+
+  return fabs(votes_[dir]) / weights_[dir];
+}
@@ -0,0 +1,63 @@
+#ifndef MICROMOUSE_WALL_EVIDENCE_H_
+#define MICROMOUSE_WALL_EVIDENCE_H_
+
+#include <Arduino.h>
+#include "../conf.h"
+#include "RangeSensorContainer.h"
+
+// Accumulates range sensor readings over the approach to a cell, so that one
+// bad reading does not decide a wall
+//
+// Every sample taken in the last WALL_EVIDENCE_WINDOW mm before the end of the
+// move votes for or against a wall on the left, front and right. A vote is
+// how far the reading is past the wall threshold, scaled by
+// WALL_EVIDENCE_MARGIN and clipped to +/-1. Votes are weighted by position,
+// rising linearly to full weight at the end of the move, where the sensors
+// are lined up with the cell being judged.
+//
+// The evidence has to be reset whenever the heading changes, since left,
+// front and right then point at other walls.
+//
+// The front threshold is moved out by the distance left to travel, since the
+// front wall gets closer during the window.
+//
+//   wallEvidence.reset();
+//   while (moving) {
+//     RangeSensors.updateReadings();
+//     wallEvidence.addSample(distance_left);
+//   }
+//   if (wallEvidence.isWall(left) && wallEvidence.getConfidence(left) > 0.5)
+//     ...
+//
+class WallEvidence {
+  private:
+    // indexed by Direction, back is never sampled
+    float votes_[3];
+    float weights_[3];
+
+    void addVote(Direction dir, float threshold, float reading, float weight);
+
+  public:
+    WallEvidence();
+
+    // Throws away all samples
+    void reset();
+
+    // Adds the latest readings from RangeSensors, taken the given distance in
+    // mm before the end of the move
+    void addSample(float distance_to_end);
+
+    // True if any samples have counted toward the given direction
+    bool hasEvidence(Direction dir);
+
+    // Returns the decision for the given direction
+    bool isWall(Direction dir);
+
+    // Returns how sure the decision is, from 0 (a coin toss) to 1 (every
+    // sample was well past the threshold)
+    float getConfidence(Direction dir);
+};
+
+extern WallEvidence wallEvidence;
+
+#endif
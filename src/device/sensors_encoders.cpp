@@ -20,6 +20,21 @@ float   enc_left_back_velocity() { return velocity(gEncoderLB); }
 float enc_right_front_velocity() { return velocity(gEncoderRF); }
 float  enc_right_back_velocity() { return velocity(gEncoderRB); }
 
+float enc_odometer()
+{
+  return (gEncoderLF.odometer() + gEncoderLB.odometer()
+          + gEncoderRF.odometer() + gEncoderRB.odometer()) * MM_PER_STEP / 4;
+}
+
+void enc_shift(float distance)
+{
+  int32_t counts = nearbyint(distance / MM_PER_STEP);
+  gEncoderLF.shift(counts);
+  gEncoderLB.shift(counts);
+  gEncoderRF.shift(counts);
+  gEncoderRB.shift(counts);
+}
+
 float  enc_left_front_extrapolate() { return extrapolate(gEncoderLF); }
 float   enc_left_back_extrapolate() { return extrapolate(gEncoderLB); }
 float enc_right_front_extrapolate() { return extrapolate(gEncoderRF); }
@@ -27,7 +42,7 @@ float  enc_right_back_extrapolate() { return extrapolate(gEncoderRB); }
 
 static void write(Encoder &encoder, float value)
 {
-  encoder.innerObject().write((int32_t) rint(value / MM_PER_STEP));
+  encoder.count(value / MM_PER_STEP);
 }
 
 static float velocity(Encoder &encoder)
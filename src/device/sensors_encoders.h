@@ -16,4 +16,12 @@ float enc_left_back_extrapolate();
 float enc_right_front_extrapolate();
 float enc_right_back_extrapolate();
 
+// mean distance covered by the wheels since startup in mm, not changed by
+// the enc_*_write functions
+float enc_odometer();
+
+// moves all four encoders by distance in mm, to the nearest count, without
+// changing enc_odometer()
+void enc_shift(float distance);
+
 #endif
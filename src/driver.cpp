@@ -17,17 +17,21 @@
 #include "device/PersistantStorage.h"
 #include "device/RangeSensorContainer.h"
 #include "device/sensors_encoders.h"
+#include "device/WallEvidence.h"
+#include "legacy_motion/FastMath.h"
 #include "legacy_motion/motion.h"
+#include "motion/KaosGeometry.h"
+#include "motion/Odometry.h"
+#include "motion/TrajectoryExecutor.h"
 #include "user_interaction/FreakOut.h"
 #include "user_interaction/Menu.h"
+#include "user_interaction/Trace.h"
 #include "conf.h"
 #include "data.h"
 #include "parser.h"
 #endif
 
 
-
-
 float Driver::getXFloat()
 {
   return x_;
@@ -191,6 +195,10 @@ void Driver::updateState(Maze<16, 16>& maze, size_t x, size_t y) {
 #endif
 }
 
+float Driver::wallConfidence(Compass8 dir) {
+  return 1;
+}
+
 void Driver::clearState() {
 #ifdef COMPILE_FOR_PC
   remove("saved_state.maze");
@@ -631,8 +639,8 @@ void RobotDriver::move(Compass8 dir, int distance)
       break;
   }
 
-  distance_to_move = hypot(destination_x - getXFloat(),
-                            destination_y - getYFloat());
+  distance_to_move = FastMath::hypot(destination_x - getXFloat(),
+                                      destination_y - getYFloat());
 
   motion_forward(MM_PER_BLOCK * distance_to_move, 0, 0);
   motion_hold(10);
@@ -674,6 +682,15 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
       is_right_wall = isWall(absoluteDir(kEast));
       motion_forward(MM_PER_BLOCK / 2, search_velocity_, 0.0);
 
+      // Only stop and square up against the walls once the pose estimate has
+      // drifted too far to trust
+      if (Odometry::isConfident()) {
+        Odometry::alignHeading();
+        motion_rotate(180);
+        motion_forward(MM_PER_BLOCK / 2, 0.0, search_velocity_);
+        break;
+      }
+
       if (is_front_wall) {
         motion_hold_range(MOTION_RESET_HOLD_DISTANCE, 500);
 
@@ -682,6 +699,7 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
         enc_left_front_write(0);
         enc_right_front_write(0);
         Orientation::getInstance().resetHeading();
+        Odometry::observeAligned();
       }
 
       if (is_right_wall) {
@@ -693,6 +711,7 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
         enc_left_front_write(0);
         enc_right_front_write(0);
         Orientation::getInstance().resetHeading();
+        Odometry::observeAligned();
 
         motion_rotate(90);
       } else if (is_left_wall) {
@@ -704,6 +723,7 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
         enc_left_front_write(0);
         enc_right_front_write(0);
         Orientation::getInstance().resetHeading();
+        Odometry::observeAligned();
 
         motion_rotate(-90);
       } else {
@@ -731,6 +751,7 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
           enc_left_front_write(0);
           enc_right_front_write(0);
           Orientation::getInstance().resetHeading();
+          Odometry::observeAligned();
 
           motion_forward(MM_FROM_BACK_TO_CENTER + MM_PER_BLOCK / 2, 0, search_velocity_);
         } else {
@@ -739,9 +760,9 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
         pivot_turns_in_a_row_ = 0;
       }
       else {
-        motion_forward(12, search_velocity_, search_velocity_);
+        motion_forward(turn_lead_in(), search_velocity_, search_velocity_);
         motion_corner(kRightTurn90, search_velocity_, 160./180);
-        motion_forward(12, search_velocity_, search_velocity_);
+        motion_forward(TURN_LEAD_IN, search_velocity_, search_velocity_);
         pivot_turns_in_a_row_++;
       }
       //motion_forward(10, search_velocity_, search_velocity_);
@@ -766,6 +787,7 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
           enc_left_front_write(0);
           enc_right_front_write(0);
           Orientation::getInstance().resetHeading();
+          Odometry::observeAligned();
 
           motion_forward(MM_FROM_BACK_TO_CENTER + MM_PER_BLOCK / 2, 0, search_velocity_);
         } else {
@@ -774,9 +796,9 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
         pivot_turns_in_a_row_ = 0;
       }
       else {
-        motion_forward(12, search_velocity_, search_velocity_);
+        motion_forward(turn_lead_in(), search_velocity_, search_velocity_);
         motion_corner(kLeftTurn90, search_velocity_, 160./180);
-        motion_forward(12, search_velocity_, search_velocity_);
+        motion_forward(TURN_LEAD_IN, search_velocity_, search_velocity_);
         pivot_turns_in_a_row_++;
       }
       //motion_forward(10, search_velocity_, search_velocity_);
@@ -788,6 +810,20 @@ void ContinuousRobotDriver::turn_while_moving(Compass8 dir)
   }
 }
 
+// Length of the straight before a swept turn, which should start TURN_LEAD_IN
+// past the edge of the cell the robot is entering. Encoder distance alone
+// says the robot is at the edge now. The last post seen says how far off
+// that is.
+float ContinuousRobotDriver::turn_lead_in()
+{
+  float to_edge;
+  if (!Odometry::distanceToCellEdge(&to_edge))
+    return TURN_LEAD_IN;
+
+  to_edge = constrain(to_edge, -TURN_LEAD_IN_MAX_SHIFT, TURN_LEAD_IN_MAX_SHIFT);
+  return TURN_LEAD_IN + to_edge;
+}
+
 void ContinuousRobotDriver::beginFromCenter(Compass8 dir)
 {
   turn_in_place(dir);
@@ -940,6 +976,23 @@ void ContinuousRobotDriver::turn(Compass8 dir)
   // Not using this method.
 }
 
+// Converts a direction relative to the robot to the sensors that see it
+static Direction toSensorDirection(Compass8 relative_dir)
+{
+  switch (relative_dir) {
+    case kNorth:
+      return front;
+    case kSouth:
+      return back;
+    case kEast:
+      return right;
+    case kWest:
+      return left;
+    default:
+      freakOut("BDIR");
+  }
+}
+
 bool ContinuousRobotDriver::isWall(Compass8 dir)
 {
   RangeSensors.updateReadings();
@@ -962,32 +1015,46 @@ bool ContinuousRobotDriver::isWall(Compass8 dir)
     // TODO FIX THIS TERRIBLE HACK
     return false;
   } else {
-    switch (relativeDir(dir)) {
-      case kNorth:
-        return RangeSensors.isWall(front);
-        break;
-      case kSouth:
-        return RangeSensors.isWall(back);
-        break;
-      case kEast:
-        return RangeSensors.isWall(right);
-        break;
-      case kWest:
-        return RangeSensors.isWall(left);
-        break;
-      default:
-        freakOut("BDIR");
-        break;
-    }
+    Direction sensor_dir = toSensorDirection(relativeDir(dir));
+
+    if (sensor_dir == back)
+      return RangeSensors.isWall(back);
+
+    // a move too short to reach the window still gets one sample
+    if (!wallEvidence.hasEvidence(sensor_dir))
+      wallEvidence.addSample(0);
+
+    return wallEvidence.isWall(sensor_dir);
   }
 }
 
+float ContinuousRobotDriver::wallConfidence(Compass8 dir)
+{
+  if (!left_back_wall_) {
+    // the walls around the starting cell are known
+    return 1;
+  } else if (!moving_) {
+    // isWall() does not look at the sensors here
+    return 0;
+  }
+
+  Direction sensor_dir = toSensorDirection(relativeDir(dir));
+
+  if (sensor_dir == back)
+    return 1;
+
+  return wallEvidence.getConfidence(sensor_dir);
+}
+
 void ContinuousRobotDriver::move(Compass8 dir, int distance)
 {
   bool will_end_moving;
 
   will_end_moving = distance > 0;
 
+  // evidence from here on is for the cell this move ends in
+  wallEvidence.reset();
+
   if (!left_back_wall_) {
     beginFromBack(dir, distance);
     moving_ = will_end_moving;
@@ -1035,36 +1102,30 @@ float KaosDriver::max_vel_straight_  = 0;
 float KaosDriver::max_vel_diag_  = 0;
 float KaosDriver::max_accel_ = 0;
 float KaosDriver::max_decel_ = 0;
+float KaosDriver::max_heading_error_ = 0;
+float KaosDriver::max_position_error_ = 0;
 
 void KaosDriver::execute(Queue<int, 256> move_list)
 {
   if (move_list.isEmpty()) return;
 
+  TRACE_BEGIN("execute", move_list.getSize());
+  TRACE_BEGIN("plan", 0);
+
   max_vel_straight_ = PersistantStorage::getKaosForwardVelocity();
   max_vel_diag_ = PersistantStorage::getKaosDiagVelocity();
   turn_velocity_ = PersistantStorage::getKaosTurnVelocity();
   max_accel_ = PersistantStorage::getKaosAccel();
   max_decel_ = -PersistantStorage::getKaosDecel();
 
-  float old_max_vel_straight = motion_get_maxVel_straight();
-  motion_set_maxVel_straight(max_vel_straight_);
-  float old_max_vel_diag = motion_get_maxVel_diag();
-  motion_set_maxVel_diag(max_vel_diag_);
-  float old_max_accel = motion_get_maxAccel_straight();
-  motion_set_maxAccel_straight(max_accel_);
-  float old_max_decel = motion_get_maxDecel_straight();
-  motion_set_maxDecel_straight(max_decel_);
+  // The whole move list is queued up first and then driven in one go
+  TrajectoryExecutor executor(max_accel_, max_decel_);
 
   int next_move = move_list.peek();
   float len = 0;
   move_list.dequeue();
 
-  motion_forward(MM_FROM_BACK_TO_CENTER, 0, turn_velocity_);
-  enc_left_front_write(0);
-  enc_left_back_write(0);
-  enc_right_front_write(0);
-  enc_right_back_write(0);
-  Orientation::getInstance().resetHeading();
+  executor.addStraight(MM_FROM_BACK_TO_CENTER, max_vel_straight_, turn_velocity_);
 
   bool should_continue = true;
   while (!move_list.isEmpty() || should_continue) {
@@ -1072,8 +1133,6 @@ void KaosDriver::execute(Queue<int, 256> move_list)
       should_continue = false;
     }
 
-    tone(BUZZER_PIN, 2000, 100);
-
     switch (next_move) {
       case quarter:
       case half:
@@ -1091,77 +1150,77 @@ void KaosDriver::execute(Queue<int, 256> move_list)
             move_list.dequeue();
           }
         } while (!move_list.isEmpty() && (next_move == forward || next_move == half || next_move == quarter));
-        motion_forward(MM_PER_BLOCK * len, turn_velocity_, turn_velocity_);
+        executor.addStraight(MM_PER_BLOCK * len, max_vel_straight_, turn_velocity_);
         break;
       case left_90:
-        motion_corner(kLeftTurn90, turn_velocity_);
+        executor.addCorner(kLeftTurn90, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case right_90:
-        motion_corner(kRightTurn90, turn_velocity_);
+        executor.addCorner(kRightTurn90, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case diag_left_90:
-        motion_corner(kLeftTurn90, turn_velocity_, 1/sqrt(2));
+        executor.addCorner(kLeftTurn90, turn_velocity_, KaosGeometry::kDiagonal90Scaling);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case diag_right_90:
-        motion_corner(kRightTurn90, turn_velocity_, 1/sqrt(2));
+        executor.addCorner(kRightTurn90, turn_velocity_, KaosGeometry::kDiagonal90Scaling);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case left_180:
-        motion_corner(kLeftTurn180, turn_velocity_);
+        executor.addCorner(kLeftTurn180, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case right_180:
-        motion_corner(kRightTurn180, turn_velocity_);
+        executor.addCorner(kRightTurn180, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case enter_left_45:
-        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (sqrt(2) - 1)), turn_velocity_, turn_velocity_);
-        motion_corner(kLeftTurn45, turn_velocity_, (sqrt(2) / 2 / (sqrt(2) - 1)));
+        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (kSqrt2 - 1)), turn_velocity_, turn_velocity_);
+        executor.addCorner(kLeftTurn45, turn_velocity_, KaosGeometry::kCorner45Scaling);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case enter_right_45:
-        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (sqrt(2) - 1)), turn_velocity_, turn_velocity_);
-        motion_corner(kRightTurn45, turn_velocity_, (sqrt(2) / 2 / (sqrt(2) - 1)));
+        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (kSqrt2 - 1)), turn_velocity_, turn_velocity_);
+        executor.addCorner(kRightTurn45, turn_velocity_, KaosGeometry::kCorner45Scaling);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case exit_left_45:
-        motion_corner(kLeftTurn45, turn_velocity_, (sqrt(2) / 2 / (sqrt(2) - 1)));
-        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (sqrt(2) - 1)), turn_velocity_, turn_velocity_);
+        executor.addCorner(kLeftTurn45, turn_velocity_, KaosGeometry::kCorner45Scaling);
+        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (kSqrt2 - 1)), turn_velocity_, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case exit_right_45:
-        motion_corner(kRightTurn45, turn_velocity_, (sqrt(2) / 2 / (sqrt(2) - 1)));
-        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (sqrt(2) - 1)), turn_velocity_, turn_velocity_);
+        executor.addCorner(kRightTurn45, turn_velocity_, KaosGeometry::kCorner45Scaling);
+        //motion_forward(MM_PER_BLOCK * (0.75 - 0.25 / (kSqrt2 - 1)), turn_velocity_, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
@@ -1176,56 +1235,56 @@ void KaosDriver::execute(Queue<int, 256> move_list)
             move_list.dequeue();
           }
         } while (!move_list.isEmpty() && next_move == diag);
-        motion_forward_diag(MM_PER_BLOCK * 0.707 * len, turn_velocity_, turn_velocity_);
+        executor.addDiagonal(KaosGeometry::kDiagonalBlock * len, max_vel_diag_, turn_velocity_);
         break;
       case pivot_180:
-        motion_rotate(180);
+        executor.addPivot(180);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case pivot_left_90:
-        motion_rotate(-90);
+        executor.addPivot(-90);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case pivot_right_90:
-        motion_rotate(90);
+        executor.addPivot(90);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case enter_right_135:
-        motion_forward(MM_PER_BLOCK * (.75 - .75/(sqrt(2) + 1)), turn_velocity_, turn_velocity_);
-        motion_corner(kRightTurn135, turn_velocity_, TURN_135_SCALING*(3 * sqrt(2) / 2 / (sqrt(2) + 1)));
+        executor.addStraight(KaosGeometry::kCorner135Straight, max_vel_straight_, turn_velocity_);
+        executor.addCorner(kRightTurn135, turn_velocity_, KaosGeometry::kCorner135Scaling);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case enter_left_135:
-        motion_forward(MM_PER_BLOCK * (.75 - .75/(sqrt(2) + 1)), turn_velocity_, turn_velocity_);
-        motion_corner(kLeftTurn135, turn_velocity_, TURN_135_SCALING*(3 * sqrt(2) / 2 / (sqrt(2) + 1)));
+        executor.addStraight(KaosGeometry::kCorner135Straight, max_vel_straight_, turn_velocity_);
+        executor.addCorner(kLeftTurn135, turn_velocity_, KaosGeometry::kCorner135Scaling);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case exit_right_135:
-        motion_corner(kRightTurn135, turn_velocity_, TURN_135_SCALING*(3 * sqrt(2) / 2 / (sqrt(2) + 1)));
-        motion_forward(MM_PER_BLOCK * (.75 - .75/(sqrt(2) + 1)), turn_velocity_, turn_velocity_);
+        executor.addCorner(kRightTurn135, turn_velocity_, KaosGeometry::kCorner135Scaling);
+        executor.addStraight(KaosGeometry::kCorner135Straight, max_vel_straight_, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
         }
         break;
       case exit_left_135:
-        motion_corner(kLeftTurn135, turn_velocity_, TURN_135_SCALING*(3 * sqrt(2) / 2 / (sqrt(2) + 1)));
-        motion_forward(MM_PER_BLOCK * (.75 - .75/(sqrt(2) + 1)), turn_velocity_, turn_velocity_);
+        executor.addCorner(kLeftTurn135, turn_velocity_, KaosGeometry::kCorner135Scaling);
+        executor.addStraight(KaosGeometry::kCorner135Straight, max_vel_straight_, turn_velocity_);
         if (!move_list.isEmpty()) {
           next_move = move_list.peek();
           move_list.dequeue();
@@ -1237,13 +1296,25 @@ void KaosDriver::execute(Queue<int, 256> move_list)
     }
   }
 
-  motion_forward(MM_PER_BLOCK / 6, turn_velocity_, 0);
-  motion_forward(-MM_PER_BLOCK / 6, 0, 0);
+  executor.addStraight(KaosGeometry::kEndStraight, max_vel_straight_, 0);
+  executor.addStraight(-KaosGeometry::kEndStraight, max_vel_straight_, 0);
+  TRACE_END("plan");
 
-  motion_set_maxVel_straight(old_max_vel_straight);
-  motion_set_maxVel_diag(old_max_vel_diag);
-  motion_set_maxAccel_straight(old_max_accel);
-  motion_set_maxDecel_straight(old_max_decel);
+  executor.run();
+
+  max_heading_error_ = executor.getMaxHeadingError();
+  max_position_error_ = executor.getMaxPositionError();
+  TRACE_END("execute");
+}
+
+float KaosDriver::getMaxHeadingError()
+{
+  return max_heading_error_;
+}
+
+float KaosDriver::getMaxPositionError()
+{
+  return max_position_error_;
 }
 
 #endif // #ifndef COMPILE_FOR_PC
@@ -89,10 +89,14 @@ class Driver
     // Returns whether there is a wall in the given direction.
     virtual bool isWall(Compass8 dir) = 0;
 
+    // Returns how sure the last isWall(dir) answer is, from 0 (no idea) to 1.
+    // By default every answer is certain.
+    virtual float wallConfidence(Compass8 dir);
+
     // Moves the robot a number of blocks in a given direction.
     virtual void move(Compass8 dir, int distance) = 0;
 
-    // The next four methods may be overridden in a derived class.
+    // The next methods may be overridden in a derived class.
 
     // Moves the robot through the given Path.
     virtual void move(Path<16, 16>& path);
@@ -278,6 +282,7 @@ class ContinuousRobotDriver : public Driver, public Turnable
 
     void turn_in_place(Compass8 dir);
     void turn_while_moving(Compass8 dir);
+    float turn_lead_in();
 
     void beginFromCenter(Compass8 dir);
     void beginFromBack(Compass8 dir, int distance);
@@ -297,6 +302,7 @@ class ContinuousRobotDriver : public Driver, public Turnable
     void turn(Compass8 dir);
 
     bool isWall(Compass8 dir);
+    float wallConfidence(Compass8 dir);
     virtual void move(Compass8 dir, int distance);
     virtual void move(Path<16, 16>& path);
 };
@@ -309,9 +315,15 @@ class KaosDriver
     static float max_vel_diag_;
     static float max_accel_;
     static float max_decel_;
+    static float max_heading_error_;
+    static float max_position_error_;
   public:
     KaosDriver();
     void execute(Queue<int, 256> move_list);
+
+    // Largest tracking errors of the last execute(), in degrees and mm
+    static float getMaxHeadingError();
+    static float getMaxPositionError();
 };
 
 #endif // #ifndef COMPILE_FOR_PC
@@ -0,0 +1,413 @@
+// Dependencies within Micromouse
+#include "legacy_motion/MotionCalc.h"
+#include "legacy_motion/SCurveProfile.h"
+#include "legacy_motion/SweptTurnProfile.h"
+#include "motion/KaosGeometry.h"
+#include "conf.h"
+#include "data.h"
+#include "parser.h"
+#include "fastest_path.h"
+
+// Path made from a plain array of directions, used to feed candidates to
+// PathParser
+class CandidatePath : public Path<16, 16>
+{
+  public:
+    CandidatePath(Maze<16, 16> &maze, size_t start_x, size_t start_y,
+                  size_t finish_x, size_t finish_y,
+                  const uint8_t directions[], size_t length);
+};
+
+CandidatePath::CandidatePath(Maze<16, 16> &maze,
+                             size_t start_x, size_t start_y,
+                             size_t finish_x, size_t finish_y,
+                             const uint8_t directions[], size_t length) :
+    Path<16, 16>(maze, start_x, start_y, finish_x, finish_y)
+{
+  for (size_t i = 0; i < length; i++) {
+    switch ((Compass8) directions[i]) {
+      case kNorth:
+        this->directions_.enqueue(&this->directions_data_[0]);
+        break;
+      case kSouth:
+        this->directions_.enqueue(&this->directions_data_[1]);
+        break;
+      case kEast:
+        this->directions_.enqueue(&this->directions_data_[2]);
+        break;
+      case kWest:
+        this->directions_.enqueue(&this->directions_data_[3]);
+        break;
+      default:
+        break;
+    }
+  }
+
+  this->setSolutionExists();
+}
+
+// Moves the coordinates one box in the given direction.
+static void step(size_t &x, size_t &y, Compass8 dir)
+{
+  switch (dir) {
+    case kNorth:
+      y++;
+      break;
+    case kSouth:
+      y--;
+      break;
+    case kEast:
+      x++;
+      break;
+    case kWest:
+      x--;
+      break;
+    default:
+      break;
+  }
+}
+
+static float straightTime(float distance, float max_velocity,
+                          float start_velocity, float end_velocity,
+                          const SpeedRunSettings& settings)
+{
+  SCurveProfile calc(distance, max_velocity, start_velocity, end_velocity,
+                     settings.accel, settings.decel, MAX_JERK_STRAIGHT);
+  return calc.getTotalTime() / 1000000.0;
+}
+
+// Same time scaling as motion_corner()
+static float cornerTime(float angle, float size_scaling, float speed)
+{
+  float reference_speed;
+  const SweptTurnProfile* profile;
+
+  if (angle == SWEPT_TURN_45_ANGLE) {
+    reference_speed = SWEPT_TURN_45_FORWARD_SPEED;
+    profile = &turn_45_table;
+  } else if (angle == SWEPT_TURN_90_ANGLE) {
+    reference_speed = SWEPT_TURN_90_FORWARD_SPEED;
+    profile = &turn_90_table;
+  } else if (angle == SWEPT_TURN_135_ANGLE) {
+    reference_speed = SWEPT_TURN_135_FORWARD_SPEED;
+    profile = &turn_135_table;
+  } else {
+    reference_speed = SWEPT_TURN_180_FORWARD_SPEED;
+    profile = &turn_180_table;
+  }
+
+  return profile->getTotalTime() * size_scaling * reference_speed / speed;
+}
+
+// Same motion as motion_rotate()
+static float pivotTime(float angle)
+{
+  float distance_per_degree = 3.14159265359 * MM_BETWEEN_WHEELS_ROTATE / 360;
+  MotionCalc calc(distance_per_degree * angle, MAX_VEL_ROTATE, 0, 0,
+                  MAX_ACCEL_ROTATE, MAX_DECEL_ROTATE);
+  return calc.getTotalTime() / 1000000.0;
+}
+
+float estimateRunTime(Queue<int, 256> move_list,
+                      const SpeedRunSettings& settings)
+{
+  const float v = settings.turn_velocity;
+
+  // blocks of straight and diagonal not yet accounted for
+  float straight = 0;
+  float diagonal = 0;
+
+  float time = straightTime(MM_FROM_BACK_TO_CENTER, settings.forward_velocity,
+                            0, v, settings);
+
+  while (!move_list.isEmpty()) {
+    int move = move_list.dequeue();
+
+    if (straight > 0 && move != forward && move != half && move != quarter) {
+      time += straightTime(MM_PER_BLOCK * straight, settings.forward_velocity,
+                           v, v, settings);
+      straight = 0;
+    }
+
+    if (diagonal > 0 && move != diag) {
+      time += straightTime(KaosGeometry::kDiagonalBlock * diagonal,
+                           settings.diag_velocity, v, v, settings);
+      diagonal = 0;
+    }
+
+    switch (move) {
+      case forward:
+        straight += 1;
+        break;
+      case half:
+        straight += 0.5;
+        break;
+      case quarter:
+        straight += 0.25;
+        break;
+      case diag:
+        diagonal += 1;
+        break;
+      case left_90:
+      case right_90:
+        time += cornerTime(SWEPT_TURN_90_ANGLE, 1, v);
+        break;
+      case diag_left_90:
+      case diag_right_90:
+        time += cornerTime(SWEPT_TURN_90_ANGLE, KaosGeometry::kDiagonal90Scaling, v);
+        break;
+      case left_180:
+      case right_180:
+        time += cornerTime(SWEPT_TURN_180_ANGLE, 1, v);
+        break;
+      case enter_left_45:
+      case enter_right_45:
+      case exit_left_45:
+      case exit_right_45:
+        time += cornerTime(SWEPT_TURN_45_ANGLE, KaosGeometry::kCorner45Scaling,
+                           v);
+        break;
+      case enter_left_135:
+      case enter_right_135:
+      case exit_left_135:
+      case exit_right_135:
+        time += cornerTime(SWEPT_TURN_135_ANGLE, KaosGeometry::kCorner135Scaling,
+                           v);
+        time += straightTime(KaosGeometry::kCorner135Straight,
+                             settings.forward_velocity,
+                             v, v, settings);
+        break;
+      case pivot_180:
+        time += pivotTime(180);
+        break;
+      case pivot_left_90:
+      case pivot_right_90:
+        time += pivotTime(90);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (straight > 0) {
+    time += straightTime(MM_PER_BLOCK * straight, settings.forward_velocity,
+                         v, v, settings);
+  }
+
+  if (diagonal > 0) {
+    time += straightTime(KaosGeometry::kDiagonalBlock * diagonal,
+                         settings.diag_velocity, v, v, settings);
+  }
+
+  // stop and back up at the end
+  time += straightTime(KaosGeometry::kEndStraight, settings.forward_velocity,
+                       v, 0, settings);
+  time += straightTime(KaosGeometry::kEndStraight, settings.forward_velocity,
+                       0, 0, settings);
+
+  return time;
+}
+
+void FastestPath::paintDistances()
+{
+  uint8_t queue[16 * 16];
+  size_t front = 0;
+  size_t back = 0;
+
+  for (size_t x = 0; x < 16; x++) {
+    for (size_t y = 0; y < 16; y++) {
+      distance_[y][x] = kUnreachable;
+    }
+  }
+
+  distance_[this->finish_y_][this->finish_x_] = 0;
+  queue[back++] = 16 * this->finish_y_ + this->finish_x_;
+
+  while (front < back) {
+    size_t x = queue[front] % 16;
+    size_t y = queue[front] / 16;
+    front++;
+
+    for (int i = 0; i < 4; i++) {
+      Compass8 dir = (Compass8) (2 * i);
+      size_t next_x = x;
+      size_t next_y = y;
+
+      if (this->maze_.isWall(x, y, dir))
+        continue;
+
+      step(next_x, next_y, dir);
+
+      // we can only move from the neighbor into this box if we have been there
+      if (!this->maze_.isVisited(next_x, next_y)
+          || distance_[next_y][next_x] != kUnreachable)
+        continue;
+
+      distance_[next_y][next_x] = distance_[y][x] + 1;
+      queue[back++] = 16 * next_y + next_x;
+    }
+  }
+}
+
+void FastestPath::scoreKnownPath()
+{
+  FloodFillPath<16, 16> flood_path(this->maze_, this->start_x_,
+                                   this->start_y_, this->finish_x_,
+                                   this->finish_y_);
+  KnownPath<16, 16> known_path(this->maze_, this->start_x_, this->start_y_,
+                               this->finish_x_, this->finish_y_, flood_path);
+  uint8_t directions[kMaxLength];
+  size_t length = 0;
+  size_t x = this->start_x_;
+  size_t y = this->start_y_;
+
+  while (!known_path.isEmpty() && length < kMaxLength) {
+    Compass8 dir = known_path.nextDirection();
+    directions[length++] = dir;
+    step(x, y, dir);
+  }
+
+  // KnownPath stops at the first box that has not been visited, which may
+  // be short of the finish
+  if (x == this->finish_x_ && y == this->finish_y_) {
+    score(directions, length);
+  }
+}
+
+void FastestPath::search()
+{
+  bool on_path[16][16];
+  uint8_t directions[kMaxLength];
+  uint8_t tried[kMaxLength];
+  size_t x = this->start_x_;
+  size_t y = this->start_y_;
+  size_t depth = 0;
+  size_t limit = distance_[y][x] + kExtraCells;
+
+  for (size_t i = 0; i < 16; i++) {
+    for (size_t j = 0; j < 16; j++) {
+      on_path[j][i] = false;
+    }
+  }
+
+  on_path[y][x] = true;
+  tried[0] = 0;
+
+  while (candidates_ < kMaxCandidates) {
+    if (tried[depth] == 4) {
+      if (depth == 0)
+        break;
+
+      // back up one box
+      on_path[y][x] = false;
+      depth--;
+      step(x, y, (Compass8) ((directions[depth] + 4) % 8));
+      continue;
+    }
+
+    // Try going straight first, then right, back, and left
+    int previous = depth > 0 ? directions[depth - 1] : (int) kNorth;
+    Compass8 dir = (Compass8) ((previous + 2 * tried[depth]) % 8);
+    tried[depth]++;
+
+    if (!this->maze_.isVisited(x, y) || this->maze_.isWall(x, y, dir))
+      continue;
+
+    size_t next_x = x;
+    size_t next_y = y;
+    step(next_x, next_y, dir);
+
+    if (on_path[next_y][next_x] || distance_[next_y][next_x] == kUnreachable
+        || depth + 1 + distance_[next_y][next_x] > limit)
+      continue;
+
+    directions[depth] = dir;
+
+    if (next_x == this->finish_x_ && next_y == this->finish_y_) {
+      score(directions, depth + 1);
+      continue;
+    }
+
+    if (depth + 1 >= kMaxLength)
+      continue;
+
+    depth++;
+    x = next_x;
+    y = next_y;
+    on_path[y][x] = true;
+    tried[depth] = 0;
+  }
+}
+
+void FastestPath::score(const uint8_t directions[], size_t length)
+{
+  CandidatePath candidate(this->maze_, this->start_x_, this->start_y_,
+                          this->finish_x_, this->finish_y_,
+                          directions, length);
+  PathParser parser(&candidate);
+  float time = estimateRunTime(parser.getMoveList(), settings_);
+
+  candidates_++;
+
+  if (best_length_ == 0 || time < best_time_) {
+    best_time_ = time;
+    best_length_ = length;
+    for (size_t i = 0; i < length; i++) {
+      best_[i] = directions[i];
+    }
+  }
+}
+
+FastestPath::FastestPath(Maze<16, 16> &maze,
+                         size_t start_x, size_t start_y,
+                         size_t finish_x, size_t finish_y,
+                         const SpeedRunSettings& settings) :
+    Path<16, 16>(maze, start_x, start_y, finish_x, finish_y),
+    settings_(settings), best_time_(-1), best_length_(0), candidates_(0)
+{
+  if (this->start_x_ == this->finish_x_ && this->start_y_ == this->finish_y_)
+    return;
+
+  paintDistances();
+
+  // Stop if no solution was found.
+  if (distance_[this->start_y_][this->start_x_] == kUnreachable)
+    return;
+
+  scoreKnownPath();
+  search();
+
+  if (best_length_ == 0)
+    return;
+
+  for (size_t i = 0; i < best_length_; i++) {
+    switch ((Compass8) best_[i]) {
+      case kNorth:
+        this->directions_.enqueue(&this->directions_data_[0]);
+        break;
+      case kSouth:
+        this->directions_.enqueue(&this->directions_data_[1]);
+        break;
+      case kEast:
+        this->directions_.enqueue(&this->directions_data_[2]);
+        break;
+      case kWest:
+        this->directions_.enqueue(&this->directions_data_[3]);
+        break;
+      default:
+        break;
+    }
+  }
+
+  this->setSolutionExists();
+}
+
+float FastestPath::getEstimatedTime()
+{
+  return best_length_ > 0 ? best_time_ : -1;
+}
+
+size_t FastestPath::getCandidateCount()
+{
+  return candidates_;
+}
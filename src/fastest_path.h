@@ -0,0 +1,85 @@
+#ifndef MICROMOUSE_FASTEST_PATH_H_
+#define MICROMOUSE_FASTEST_PATH_H_
+
+// Dependencies within Micromouse
+#include "data.h"
+
+// Speeds and accelerations that a speed run will be driven with
+//
+// These are the same settings that KaosDriver loads from persistent storage.
+// They are passed in explicitly so that paths can be scored without any
+// hardware present.
+struct SpeedRunSettings {
+  float forward_velocity; // m/s
+  float diag_velocity; // m/s
+  float turn_velocity; // m/s
+  float accel; // m/s/s
+  float decel; // m/s/s, negative
+};
+
+// Returns the estimated time in seconds KaosDriver::execute will take to drive
+// the given move list, using the SCurveProfile, MotionCalc and SweptTurnProfile
+// timing model.
+float estimateRunTime(Queue<int, 256> move_list,
+                      const SpeedRunSettings& settings);
+
+// Path through known cells that should be the quickest one to drive
+//
+// FloodFillPath always returns one of the shortest routes in cells, but a
+// route that is a cell or two longer with fewer turns is often much faster to
+// drive. This path enumerates candidate routes through visited cells whose
+// length is within kExtraCells of the shortest, compiles each one with
+// PathParser, scores it with estimateRunTime(), and keeps the fastest.
+//
+// The route that KnownPath would take is always scored first, so the chosen
+// path is never expected to be slower than it. The rest of the candidates
+// are found with a depth first search bounded by the known-cell distance to
+// the finish, trying straight, right, back and left out of each box. That
+// only orders the routes out of each box, not the routes as a whole, and
+// once kMaxCandidates have been scored the search stops wherever it got to.
+//
+// Like KnownPath, a cell is only ever driven out of if it has been visited, so
+// this can be used anywhere a KnownPath is used for a speed run.
+//
+//   FastestPath path(maze, 0, 0, 8, 8, settings);
+//   PathParser parser(&path);
+//
+class FastestPath : public Path<16, 16>
+{
+  private:
+    static const size_t kExtraCells = 2;
+    static const size_t kMaxCandidates = 48;
+    static const size_t kMaxLength = 16 * 16;
+    static const uint8_t kUnreachable = 0xFF;
+
+    const SpeedRunSettings settings_;
+
+    // Number of moves from each box to the finish, only moving out of
+    // visited boxes
+    uint8_t distance_[16][16];
+
+    float best_time_;
+    size_t best_length_;
+    uint8_t best_[kMaxLength];
+
+    size_t candidates_;
+
+    void paintDistances();
+    void scoreKnownPath();
+    void search();
+    void score(const uint8_t directions[], size_t length);
+
+  public:
+    FastestPath(Maze<16, 16> &maze, size_t start_x, size_t start_y,
+                size_t finish_x, size_t finish_y,
+                const SpeedRunSettings& settings);
+
+    // Returns the estimated time of the chosen path in seconds, or a negative
+    // number if no path was found.
+    float getEstimatedTime();
+
+    // Returns the number of candidate paths that were scored.
+    size_t getCandidateCount();
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include <cmath>
+
+#include "FastMath.h"
+#include "SineTable.h"
+
+// Make sure SineTable.h was generated for the current table size. If this
+// fails, run tools/make_sine_table.py.
+static_assert(SINE_TABLE_BITS == FastMath::kSineTableBits,
+              "SineTable.h is out of date");
+
+// Reinterprets the bits of a float and back
+union FloatBits {
+  float f;
+  uint32_t i;
+};
+
+float FastMath::atan2(float y, float x)
+{
+  float abs_x = std::fabs(x);
+  float abs_y = std::fabs(y);
+  float big = abs_x > abs_y ? abs_x : abs_y;
+  float small = abs_x > abs_y ? abs_y : abs_x;
+
+  // atan on [0, 1], Abramowitz and Stegun 4.4.49, error below 1e-5
+  float z = big > 0 ? small / big : 0;
+  float z2 = z * z;
+  float angle = z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f
+                + z2 * (-0.0851330f + z2 * 0.0208351f))));
+
+  // unfold the octants, all of which become conditional moves
+  angle = abs_y > abs_x ? (float) (M_PI / 2) - angle : angle;
+  angle = x < 0 ? (float) M_PI - angle : angle;
+  return y < 0 ? -angle : angle;
+}
+
+float FastMath::sqrt(float x)
+{
+  if (x <= 0)
+    return 0;
+
+  // estimate of 1/sqrt(x), then two Newton steps
+  FloatBits bits;
+  bits.f = x;
+  bits.i = 0x5f375a86 - (bits.i >> 1);
+  float y = bits.f;
+  float half_x = 0.5f * x;
+  y = y * (1.5f - half_x * y * y);
+  y = y * (1.5f - half_x * y * y);
+
+  return x * y;
+}
+
+float FastMath::pow(float x, float y)
+{
+  if (x <= 0)
+    return 0;
+
+  // log2(x) = exponent + log2(mantissa), with the mantissa in
+  // [sqrt(1/2), sqrt(2)) so that the series below converges quickly
+  FloatBits bits;
+  bits.f = x;
+  int exponent = (int) ((bits.i >> 23) & 0xff) - 127;
+  bits.i = (bits.i & 0x007fffff) | 0x3f800000;
+  if (bits.f > 1.41421356f) {
+    bits.f *= 0.5f;
+    exponent++;
+  }
+
+  // log2(m) = 2 / ln(2) * atanh(t) with t = (m - 1) / (m + 1), |t| < 0.172
+  float t = (bits.f - 1) / (bits.f + 1);
+  float t2 = t * t;
+  float log2_m = 2.8853901f * t * (1 + t2 * (0.33333333f + t2 * (0.2f
+                 + t2 * (0.14285714f + t2 * 0.11111111f))));
+
+  // p = y * log2(x), kept as the two products so that the whole powers of
+  // two from the exponent do not cost the fraction its precision
+  float p_exponent = y * exponent;
+  float p_mantissa = y * log2_m;
+  float p = p_exponent + p_mantissa;
+  if (p >= 128)
+    return INFINITY;
+  if (p < -126)
+    return 0;
+
+  // 2^p = 2^whole * 2^fraction, with the fraction in [0, 1)
+  float whole_exponent = std::floor(p_exponent);
+  float f = (p_exponent - whole_exponent) + p_mantissa;
+  float whole_mantissa = std::floor(f);
+  f -= whole_mantissa;
+  int whole = (int) whole_exponent + (int) whole_mantissa;
+
+  float fraction = 1 + f * (0.69314718f + f * (0.24022651f + f * (0.05550411f
+                   + f * (0.00961813f + f * (0.00133336f + f * (0.00015403f
+                   + f * 0.00001525f))))));
+
+  bits.f = fraction;
+  bits.i += (uint32_t) whole << 23;
+  return bits.f;
+}
@@ -0,0 +1,82 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Fast approximations of the libm functions used in the control path
+//
+// The Teensy has no FPU, so sin, atan2, sqrt and friends are long soft float
+// routines. These trade a small, known error for far fewer float operations.
+// Worst case errors over the whole input range, as measured by the BNCH
+// menu entry and checked by test/fast_math_test.cpp:
+//
+//   sin, cos      2e-5 absolute
+//   atan2         1.2e-5 radians
+//   sqrt, hypot   5e-6 relative
+//   pow           3e-6 relative, for x > 0 and |y * log2(x)| < 64
+//
+// Angles can be given as a Phase, where a full turn is 2^32, so that wrapping
+// around is integer overflow. The sine is a table lookup with linear
+// interpolation over the whole turn, which needs no quadrant folding and no
+// branches. The table is generated by tools/make_sine_table.py and is const,
+// so it stays in flash.
+//
+//   FastMath::Phase heading = FastMath::toPhase(angle);
+//   float dx = distance * FastMath::cosPhase(heading);
+//
+class FastMath {
+  public:
+    typedef uint32_t Phase;
+
+    // entries in the sine table for one full turn, as a power of two
+    static const int kSineTableBits = 9;
+    static const size_t kSineTableSize = (size_t) 1 << kSineTableBits;
+
+    static Phase toPhase(float radians)
+    {
+      // through int64_t so that angles outside +/-pi wrap instead of
+      // saturating
+      return (Phase) (int64_t) (radians * kPhasePerRadian);
+    }
+
+    static float sinPhase(Phase phase)
+    {
+      size_t index = phase >> (32 - kSineTableBits);
+      float fraction = (Phase) (phase << kSineTableBits) * kPhaseFraction;
+      return sine_table_[index]
+             + (sine_table_[index + 1] - sine_table_[index]) * fraction;
+    }
+
+    static float cosPhase(Phase phase)
+    {
+      return sinPhase(phase + kQuarterTurn);
+    }
+
+    static float sin(float radians) { return sinPhase(toPhase(radians)); }
+    static float cos(float radians) { return cosPhase(toPhase(radians)); }
+
+    // Same as std::atan2, returns radians in [-pi, pi]. atan2(0, 0) is 0.
+    static float atan2(float y, float x);
+
+    // Returns 0 for x <= 0
+    static float sqrt(float x);
+
+    static float hypot(float x, float y) { return sqrt(x * x + y * y); }
+
+    // Only for x > 0, returns 0 otherwise
+    static float pow(float x, float y);
+
+  private:
+    static const Phase kQuarterTurn = (Phase) 1 << 30;
+    static constexpr float kPhasePerRadian = 683565275.6;
+    static constexpr float kPhaseFraction = 1.0 / 4294967296.0;
+
+    // one full turn, with the first entry repeated at the end, defined in
+    // SineTable.h
+    static const float sine_table_[kSineTableSize + 1];
+
+    FastMath();
+};
+
+#endif
@@ -3,32 +3,97 @@
 
 PIDController::PIDController(float tempKP, float tempKI, float tempKD, float temp_i_upper_bound,
                              float temp_i_lower_bound) {
+#if CONTROL_FIXED_POINT
+  kp = FixedMultiplier(tempKP);
+  ki = FixedMultiplier(tempKI);
+  kd = FixedMultiplier(tempKD);
+  kd_nonzero = tempKD != 0;
+#else
   kp = tempKP;
   ki = tempKI;
   kd = tempKD;
+#endif
   
   if (temp_i_lower_bound == 0) {
     temp_i_lower_bound = -temp_i_upper_bound;
   }
 
+#if CONTROL_FIXED_POINT
+  i_lower_bound = Q16::fromFloat(temp_i_lower_bound);
+  i_upper_bound = Q16::fromFloat(temp_i_upper_bound);
+#else
   i_lower_bound = temp_i_lower_bound;
   i_upper_bound = temp_i_upper_bound;
+#endif
 }
 
 float PIDController::Calculate(float current_value, float target_value) {
+  uint32_t dt = elapsed_time;
+  elapsed_time = 0;
+
+  return Calculate(current_value, target_value, dt);
+}
+
+#if CONTROL_FIXED_POINT
+
+float PIDController::Calculate(float current_value, float target_value, uint32_t dt) {
+  return Calculate(Q16::fromFloat(current_value), Q16::fromFloat(target_value),
+                   dt).toFloat();
+}
+
+Q16 PIDController::Calculate(Q16 current_value, Q16 target_value, uint32_t dt) {
+  Q16 error = current_value - target_value;
+
+  // ki * error * dt in one step, so that small gains are not lost
+  i_term += Q16::fromRaw(ki.apply((int64_t) error.raw() * dt));
+  i_term = i_term.clamp(i_lower_bound, i_upper_bound);
+
+  if (!has_last_value) {
+    last_value = current_value;
+    has_last_value = true;
+  }
+
+  Q16 output = -kp.apply(error) - i_term;
+
+  if (kd_nonzero && dt > 0) {
+    // kd is usually big and dt is usually a few thousand, so divide before
+    // saturating
+    int64_t derivative = kd.applyWide((last_value - current_value).raw());
+
+    if (derivative <= INT32_MAX && derivative >= INT32_MIN) {
+      derivative = (int32_t) derivative / (int32_t) dt;
+    } else {
+      derivative /= dt;
+    }
+
+    output += Q16::fromRaw(fixed::saturate(derivative));
+  }
+
+  last_value = current_value;
+
+  elapsed_time = 0;
+
+  return output;
+}
+
+#else
+
+float PIDController::Calculate(float current_value, float target_value, uint32_t dt) {
   float error = current_value - target_value;
 
-  i_term += ki * error * elapsed_time;
+  i_term += ki * error * dt;
   i_term = constrain(i_term, i_lower_bound, i_upper_bound);
 
   if (isnan(last_value)) {
     last_value = current_value;
   }
 
-  float output = -kp * error - i_term + kd * (-current_value + last_value) / elapsed_time;
+  float output = -kp * error - i_term + kd * (-current_value + last_value) / dt;
   last_value = current_value;
 
   elapsed_time = 0;
 
   return output;
 }
+
+#endif
@@ -2,18 +2,38 @@
 #define PID_CONTROLLER_H
 
 #include <Arduino.h>
+#include "../conf.h"
+#include "../motion/Fixed.h"
 
 class PIDController {
   private:
-    float i_term = 0;
     elapsedMicros elapsed_time;
+#if CONTROL_FIXED_POINT
+    Q16 i_term;
+    Q16 last_value;
+    bool has_last_value = false;
+    FixedMultiplier kp, ki, kd;
+    bool kd_nonzero;
+    Q16 i_lower_bound, i_upper_bound;
+#else
+    float i_term = 0;
     float last_value = NAN;
     float kp, ki, kd;
     float i_lower_bound, i_upper_bound;
+#endif
   public:
     PIDController(float tempKP, float tempKI, float tempKD, float temp_i_upper_bound = 10000,
                   float temp_i_lower_bound = 0);
     float Calculate(float current_value, float target_value);
+
+    // Same as above, but with a fixed time step in microseconds since the last
+    // call, for loops that run at a known rate
+    float Calculate(float current_value, float target_value, uint32_t dt);
+
+#if CONTROL_FIXED_POINT
+    // Same as above, without converting to and from float
+    Q16 Calculate(Q16 current_value, Q16 target_value, uint32_t dt);
+#endif
 };
 
 #endif
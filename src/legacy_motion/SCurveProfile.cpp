@@ -0,0 +1,250 @@
+#include <Arduino.h>
+#include "SCurveProfile.h"
+
+void SCurveProfile::Transition::plan(float from, float to, float max_accel,
+                                     float max_jerk)
+{
+  float change = fabs(to - from);
+  float sign = to < from ? -1 : 1;
+
+  start_velocity = from;
+  end_velocity = to;
+  peak_accel = jerk = 0;
+  jerk_time = const_time = 0;
+
+  if (change > 0 && max_accel > 0) {
+    float peak;
+
+    if (max_jerk <= 0) {
+      // no jerk limit, same as MotionCalc
+      peak = max_accel;
+      const_time = change / max_accel;
+    } else if (change >= max_accel * max_accel / max_jerk) {
+      // reaches the acceleration limit
+      peak = max_accel;
+      jerk_time = max_accel / max_jerk;
+      const_time = change / max_accel - jerk_time;
+    } else {
+      // ramps straight back down before reaching it
+      peak = sqrt(change * max_jerk);
+      jerk_time = peak / max_jerk;
+    }
+
+    peak_accel = sign * peak;
+    jerk = sign * max_jerk;
+  }
+
+  // the acceleration is symmetric, so the mean speed is halfway between
+  duration = 2 * jerk_time + const_time;
+  distance = (from + to) / 2 * duration;
+}
+
+void SCurveProfile::Transition::fit(float from, float to, float time,
+                                    float max_jerk)
+{
+  float change = fabs(to - from);
+  float sign = to < from ? -1 : 1;
+
+  start_velocity = from;
+  end_velocity = to;
+  peak_accel = jerk = 0;
+  jerk_time = 0;
+  const_time = time > 0 ? time : 0;
+
+  if (change > 0 && time > 0) {
+    float peak;
+
+    if (max_jerk > 0 && time * time * max_jerk >= 4 * change) {
+      // Keep the jerk and find the acceleration that takes the whole time:
+      //   change = peak * (time - peak / max_jerk)
+      // smaller root, written so that it does not cancel
+      peak = 2 * change * max_jerk
+             / (time * max_jerk
+                + sqrt(time * time * max_jerk * max_jerk
+                       - 4 * change * max_jerk));
+      jerk_time = peak / max_jerk;
+      const_time = time - 2 * jerk_time;
+    } else {
+      // a triangle of acceleration, with a higher jerk
+      jerk_time = time / 2;
+      const_time = 0;
+      peak = change / jerk_time;
+      max_jerk = peak / jerk_time;
+    }
+
+    peak_accel = sign * peak;
+    jerk = sign * max_jerk;
+  }
+
+  duration = 2 * jerk_time + const_time;
+  distance = (from + to) / 2 * duration;
+}
+
+void SCurveProfile::Transition::evaluate(float t, float* d, float* v,
+                                         float* a) const
+{
+  if (t < 0)
+    t = 0;
+
+  if (t >= duration) {
+    *d = distance;
+    *v = end_velocity;
+    *a = 0;
+    return;
+  }
+
+  // ramping up
+  if (t < jerk_time) {
+    *a = jerk * t;
+    *v = start_velocity + jerk * t * t / 2;
+    *d = start_velocity * t + jerk * t * t * t / 6;
+    return;
+  }
+
+  float v1 = start_velocity + jerk * jerk_time * jerk_time / 2;
+  float d1 = start_velocity * jerk_time
+             + jerk * jerk_time * jerk_time * jerk_time / 6;
+
+  // constant acceleration
+  t -= jerk_time;
+  if (t < const_time) {
+    *a = peak_accel;
+    *v = v1 + peak_accel * t;
+    *d = d1 + v1 * t + peak_accel * t * t / 2;
+    return;
+  }
+
+  float v2 = v1 + peak_accel * const_time;
+  float d2 = d1 + v1 * const_time + peak_accel * const_time * const_time / 2;
+
+  // ramping down
+  t -= const_time;
+  *a = peak_accel - jerk * t;
+  *v = v2 + peak_accel * t - jerk * t * t / 2;
+  *d = d2 + v2 * t + peak_accel * t * t / 2 - jerk * t * t * t / 6;
+}
+
+SCurveProfile::SCurveProfile(float distance, float max_velocity,
+                             float start_velocity, float end_velocity,
+                             float max_accel, float max_decel, float max_jerk)
+{
+  direction_ = distance < 0 ? -1 : 1;
+  total_distance_ = fabs(distance) / 1000;
+
+  float v_max = fabs(max_velocity);
+  float v_start = max(direction_ * start_velocity, 0.0f);
+  float v_end = max(direction_ * end_velocity, 0.0f);
+
+  max_accel = fabs(max_accel);
+  max_decel = fabs(max_decel);
+  max_jerk = fabs(max_jerk);
+
+  // check if there's enough space to reach exit speed
+  Transition direct;
+  direct.plan(v_start, v_end, v_end < v_start ? max_decel : max_accel,
+              max_jerk);
+
+  if (direct.distance > total_distance_) {
+    // v_start + v_end is positive, or the direct distance would be 0
+    start_.fit(v_start, v_end, 2 * total_distance_ / (v_start + v_end),
+               max_jerk);
+    end_.plan(v_end, v_end, max_decel, max_jerk);
+    cruise_velocity_ = v_end;
+    cruise_time_ = 0;
+  } else {
+    // Find the highest peak speed that still leaves room to stop. The speed
+    // at low always fits, since going straight to v_end does.
+    float low = max(v_start, v_end) <= v_max ? max(v_start, v_end) : v_end;
+    float high = v_max;
+    float peak = v_max;
+
+    start_.plan(v_start, peak, peak < v_start ? max_decel : max_accel,
+                max_jerk);
+    end_.plan(peak, v_end, v_end < peak ? max_decel : max_accel, max_jerk);
+
+    if (start_.distance + end_.distance > total_distance_) {
+      for (int i = 0; i < 24; i++) {
+        peak = (low + high) / 2;
+        start_.plan(v_start, peak, peak < v_start ? max_decel : max_accel,
+                    max_jerk);
+        end_.plan(peak, v_end, v_end < peak ? max_decel : max_accel,
+                  max_jerk);
+
+        if (start_.distance + end_.distance > total_distance_) {
+          high = peak;
+        } else {
+          low = peak;
+        }
+      }
+
+      peak = low;
+      start_.plan(v_start, peak, peak < v_start ? max_decel : max_accel,
+                  max_jerk);
+      end_.plan(peak, v_end, v_end < peak ? max_decel : max_accel, max_jerk);
+    }
+
+    cruise_velocity_ = peak;
+    cruise_time_ = 0;
+    if (peak > 0) {
+      cruise_time_ = (total_distance_ - start_.distance - end_.distance)
+                     / peak;
+    }
+  }
+
+  start_time_ = lround(start_.duration * 1000000);
+  cruise_end_time_ = lround((start_.duration + cruise_time_) * 1000000);
+  total_time_ = lround((start_.duration + cruise_time_ + end_.duration)
+                       * 1000000);
+}
+
+void SCurveProfile::getState(int32_t elapsed_time, float* distance,
+                             float* velocity, float* accel) const
+{
+  float t = elapsed_time / 1000000.0;
+  float d, v, a;
+
+  if (elapsed_time < start_time_) {
+    start_.evaluate(t, &d, &v, &a);
+  } else if (elapsed_time < cruise_end_time_) {
+    d = start_.distance + cruise_velocity_ * (t - start_.duration);
+    v = cruise_velocity_;
+    a = 0;
+  } else if (elapsed_time < total_time_) {
+    end_.evaluate(t - start_.duration - cruise_time_, &d, &v, &a);
+    d += total_distance_ - end_.distance;
+  } else {
+    d = total_distance_;
+    v = end_.end_velocity;
+    a = 0;
+  }
+
+  *distance = direction_ * d * 1000;
+  *velocity = direction_ * v;
+  *accel = direction_ * a;
+}
+
+float SCurveProfile::idealDistance(int32_t elapsed_time) const
+{
+  float distance, velocity, accel;
+  getState(elapsed_time, &distance, &velocity, &accel);
+  return distance;
+}
+
+float SCurveProfile::idealVelocity(int32_t elapsed_time) const
+{
+  float distance, velocity, accel;
+  getState(elapsed_time, &distance, &velocity, &accel);
+  return velocity;
+}
+
+float SCurveProfile::idealAccel(int32_t elapsed_time) const
+{
+  float distance, velocity, accel;
+  getState(elapsed_time, &distance, &velocity, &accel);
+  return accel;
+}
+
+uint32_t SCurveProfile::getTotalTime() const
+{
+  return total_time_;
+}
@@ -0,0 +1,89 @@
+#ifndef S_CURVE_PROFILE_H
+#define S_CURVE_PROFILE_H
+
+#include <Arduino.h>
+
+// Jerk limited version of MotionCalc
+//
+// MotionCalc steps the acceleration straight from 0 to its limit, which
+// kicks the wheels into slipping and pitches the robot. Here the acceleration
+// ramps up and down at a limited jerk instead, so each change of speed is an
+// S shaped curve:
+//
+//   jerk up, constant accel, jerk down, cruise, jerk down, constant decel,
+//   jerk up
+//
+// Any of the phases can be empty. A change of speed that is too small to
+// reach the acceleration limit is a triangle of acceleration.
+//
+// Constructor arguments and units are the same as MotionCalc, plus the jerk
+// limit in m/s/s/s. Like MotionCalc, when there is not enough room to reach
+// the exit speed within the limits, the limits are raised just enough to
+// reach it at the end of the move. An entry speed above max_velocity is
+// brought down to max_velocity with the decel limit.
+//
+//   SCurveProfile profile(MM_PER_BLOCK, 1, 0, 0.5, 7, -5, 200);
+//   profile.getState(elapsed_time, &distance, &velocity, &accel);
+//
+class SCurveProfile {
+  private:
+    // One change of speed, in seconds, m/s, m/s/s and m
+    struct Transition {
+      float start_velocity;
+      float end_velocity;
+
+      // signed, zero if the speed does not change
+      float peak_accel;
+      float jerk;
+
+      // time spent ramping the acceleration at each end, and time spent at
+      // peak_accel
+      float jerk_time;
+      float const_time;
+
+      float distance;
+      float duration;
+
+      void plan(float from, float to, float max_accel, float max_jerk);
+
+      // Makes the change of speed take exactly the given time, raising the
+      // acceleration and jerk limits as needed
+      void fit(float from, float to, float time, float max_jerk);
+
+      void evaluate(float t, float* d, float* v, float* a) const;
+    };
+
+    // +1 for forward moves, -1 for backward moves. All the planning is done
+    // as if the move were forward.
+    float direction_;
+
+    float total_distance_; // m
+
+    Transition start_;
+    Transition end_;
+    float cruise_velocity_; // m/s
+    float cruise_time_; // s
+
+    int32_t start_time_; // us
+    int32_t cruise_end_time_; // us
+    int32_t total_time_; // us
+
+  public:
+    SCurveProfile(float distance, float max_velocity, float start_velocity,
+                  float end_velocity, float max_accel, float max_decel,
+                  float max_jerk);
+
+    // Fills in the distance in mm, velocity in m/s and acceleration in m/s/s
+    // at elapsed_time microseconds into the move
+    void getState(int32_t elapsed_time, float* distance, float* velocity,
+                  float* accel) const;
+
+    float idealDistance(int32_t elapsed_time) const;
+    float idealVelocity(int32_t elapsed_time) const;
+    float idealAccel(int32_t elapsed_time) const;
+
+    // microseconds
+    uint32_t getTotalTime() const;
+};
+
+#endif
@@ -1,105 +1,82 @@
-#include <cmath>
 #include <cstddef>
 #include "../conf.h"
 
-#include "FastTrigs.h"
 #include "SweptTurnProfile.h"
 
-// Internal methods for calculating const parameters
-static float calculateAccelerationDuration(float turn_angle,
-                                           float inside_trigs,
-                                           float omega_max)
-{
-  // angle covered if we accelerate to max rotational velocity
-  float angle_for_full_acceleration = omega_max / inside_trigs;
+// Compares two arrays of constants at compile time
+template <size_t N>
+static constexpr bool sameConstants(const float (&a)[N], const float (&b)[N],
+                                    size_t i = 0) {
+  return i == N || (a[i] == b[i] && sameConstants(a, b, i + 1));
+}
 
-  if (angle_for_full_acceleration > turn_angle / 2) {
-    // We don't have time to accelerate to max rotational velocity
+static constexpr float ROBOT_CONSTANTS[] = {
+  ROBOT_MASS, MOMENT_OF_INERTIA, MM_BETWEEN_WHEELS, MAX_COEFFICIENT_FRICTION
+};
+static constexpr float ROBOT_SOURCE[] = SWEPT_TURN_TABLE_SOURCE;
+static_assert(sameConstants(ROBOT_CONSTANTS, ROBOT_SOURCE),
+              "SweptTurnTables.h is out of date");
 
-    // Solve for t when theta = turn_angle / 2
-    float temp = (turn_angle / 2) * inside_trigs / omega_max;
-    return std::acos(1 - temp) / inside_trigs;
-  } else {
-    // We have time to accelerate to max rotational velocity
+#define CHECK_TURN_TABLE(turn) \
+  static constexpr float TURN_##turn##_CONSTANTS[] = { \
+    SWEPT_TURN_##turn##_FORWARD_SPEED, SWEPT_TURN_##turn##_ANGLE \
+  }; \
+  static constexpr float TURN_##turn##_SOURCE[] = \
+      SWEPT_TURN_##turn##_TABLE_SOURCE; \
+  static_assert(sameConstants(TURN_##turn##_CONSTANTS, TURN_##turn##_SOURCE), \
+                "SweptTurnTables.h is out of date for " #turn)
 
-    // Solve for t when omega maxes out
-    return (M_PI / 2) / inside_trigs;
-  }
-}
+CHECK_TURN_TABLE(45);
+CHECK_TURN_TABLE(90);
+CHECK_TURN_TABLE(135);
+CHECK_TURN_TABLE(180);
+
+#define TURN_TABLE(turn) \
+  SweptTurnProfile(SWEPT_TURN_##turn##_ANGLE, SWEPT_TURN_##turn##_DURATION, \
+                   SWEPT_TURN_##turn##_ANGLE_TABLE, \
+                   SWEPT_TURN_##turn##_VELOCITY_TABLE, \
+                   SWEPT_TURN_##turn##_ACCEL_TABLE)
+
+const SweptTurnProfile turn_45_table = TURN_TABLE(45);
+const SweptTurnProfile turn_90_table = TURN_TABLE(90);
+const SweptTurnProfile turn_135_table = TURN_TABLE(135);
+const SweptTurnProfile turn_180_table = TURN_TABLE(180);
 
-static float calculateConstVelocityDuration(float turn_angle,
-                                            float inside_trigs,
-                                            float omega_max)
+// Internal methods
+float SweptTurnProfile::interpolate(const float* table, float t) const
 {
-  // angle covered if we accelerate to max rotational velocity
-  float angle_for_full_acceleration = omega_max / inside_trigs;
+  float position = t * rate_;
 
-  if (angle_for_full_acceleration > turn_angle / 2) {
-    // We don't have time to accelerate to max rotational velocity
-    return 0;
-  } else {
-    // We have time to accelerate to max rotational velocity
-    float theta_const = turn_angle - 2 * omega_max / inside_trigs;
-    return theta_const / omega_max;
+  if (position <= 0) {
+    return table[0];
+  } else if (position >= kSize - 1) {
+    return table[kSize - 1];
   }
-}
 
-// Constructor
-SweptTurnProfile::SweptTurnProfile(float tangential_velocity,
-                                   float turn_angle_deg)
-    : tangential_velocity_(tangential_velocity),
-      turn_angle_(turn_angle_deg * M_PI / 180),
-      inside_trigs_(ROBOT_MASS * (MM_BETWEEN_WHEELS / 2.0 / 1000.0)
-                    * tangential_velocity_ / MOMENT_OF_INERTIA),
-      omega_max_(ROBOT_MASS * MAX_COEFFICIENT_FRICTION * 9.81 / ROBOT_MASS
-              / tangential_velocity),
-      acceleration_duration_(calculateAccelerationDuration(
-          turn_angle_, inside_trigs_, omega_max_)),
-      const_velocity_duration_(calculateConstVelocityDuration(
-          turn_angle_, inside_trigs_, omega_max_)),
-      turn_duration_(2 * acceleration_duration_ + const_velocity_duration_)
-{
+  size_t index = position;
+  float fraction = position - index;
+  return table[index] + (table[index + 1] - table[index]) * fraction;
 }
 
 // Public methods
 float SweptTurnProfile::getAngle(float t) const
 {
-  if (t <= acceleration_duration_) {
-    return (1 - FastTrigs::cos(inside_trigs_ * t)) * omega_max_ / inside_trigs_;
-  } else if (t <= acceleration_duration_ + const_velocity_duration_) {
-    return getAngle(acceleration_duration_)
-         + (getAngularVelocity(acceleration_duration_)
-            * (t - acceleration_duration_));
-  } else {
-    return turn_angle_ - getAngle(turn_duration_ - t);
-  }
+  return interpolate(angles_, t);
 }
 
 float SweptTurnProfile::getAngularAcceleration(float t) const
 {
-  if (t <= acceleration_duration_) {
-    return omega_max_ * inside_trigs_ * FastTrigs::cos(inside_trigs_ * t);
-  } else if (t <= acceleration_duration_ + const_velocity_duration_) {
-    return 0;
-  } else {
-    return -getAngularAcceleration(turn_duration_ - t);
-  }
+  return interpolate(angular_accelerations_, t);
 }
 
 float SweptTurnProfile::getAngularVelocity(float t) const
 {
-  if (t <= acceleration_duration_) {
-    return omega_max_ * FastTrigs::sin(inside_trigs_ * t);
-  } else if (t <= acceleration_duration_ + const_velocity_duration_) {
-    return getAngularVelocity(acceleration_duration_);
-  } else {
-    return getAngularVelocity(turn_duration_ - t);
-  }
+  return interpolate(angular_velocities_, t);
 }
 
 float SweptTurnProfile::getTotalAngle() const
 {
-  return turn_angle_ * (180 / M_PI);
+  return turn_angle_;
 }
 
 float SweptTurnProfile::getTotalTime() const
@@ -3,26 +3,47 @@
 
 #include <cstddef>
 
+#include "SweptTurnTables.h"
+
 enum SweptTurnType {
   kLeftTurn45, kLeftTurn90, kLeftTurn135, kLeftTurn180,
   kRightTurn45, kRightTurn90, kRightTurn135, kRightTurn180
 };
 
+// Angle of a swept turn over time, at its reference forward speed
+//
+// The curves are worked out from the closed form in doc/swept_turn_math by
+// tools/make_turn_tables.py and compiled in as SweptTurnTables.h, so reading
+// one is an index and a linear interpolation. Times before the start or after
+// the end of the turn read the first or last entry.
 class SweptTurnProfile {
  private:
+  static const size_t kSize = SWEPT_TURN_TABLE_SIZE;
+
   // All internal variables in mks units unless stated otherwise
-  const float tangential_velocity_;
-  const float turn_angle_;
+  const float turn_angle_; // degrees
+  const float turn_duration_;
 
-  const float inside_trigs_;
-  const float omega_max_;
+  // table entries per second
+  const float rate_;
 
-  const float acceleration_duration_;
-  const float const_velocity_duration_;
-  const float turn_duration_;
+  const float* const angles_;
+  const float* const angular_velocities_;
+  const float* const angular_accelerations_;
+
+  float interpolate(const float* table, float t) const;
 
  public:
-  SweptTurnProfile(float tangential_velocity, float turn_angle);
+  constexpr SweptTurnProfile(float turn_angle_deg, float turn_duration,
+                             const float* angles,
+                             const float* angular_velocities,
+                             const float* angular_accelerations)
+      : turn_angle_(turn_angle_deg), turn_duration_(turn_duration),
+        rate_((kSize - 1) / turn_duration), angles_(angles),
+        angular_velocities_(angular_velocities),
+        angular_accelerations_(angular_accelerations)
+  {
+  }
 
   float getAngle(float t) const;
   float getAngularAcceleration(float t) const;
@@ -31,4 +52,10 @@ class SweptTurnProfile {
   float getTotalTime() const;
 };
 
+// turn lookup tables, at SWEPT_TURN_*_FORWARD_SPEED
+extern const SweptTurnProfile turn_45_table;
+extern const SweptTurnProfile turn_90_table;
+extern const SweptTurnProfile turn_135_table;
+extern const SweptTurnProfile turn_180_table;
+
 #endif
@@ -0,0 +1,565 @@
+#ifndef SWEPT_TURN_TABLES_H
+#define SWEPT_TURN_TABLES_H
+
+// Generated by tools/make_turn_tables.py from conf.h, do not edit
+
+// Angle in radians, angular velocity in rad/s and angular
+// acceleration in rad/s/s at SWEPT_TURN_TABLE_SIZE evenly spaced
+// times from 0 to the duration of the turn in seconds
+#define SWEPT_TURN_TABLE_SIZE 257
+
+#define SWEPT_TURN_TABLE_SOURCE { .1302, 0.00015, 74.5, 1 }
+
+#define SWEPT_TURN_45_TABLE_SOURCE { 0.87, 45.0 }
+#define SWEPT_TURN_45_DURATION 0.110236113
+static constexpr float SWEPT_TURN_45_ANGLE_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 2.94067857e-05, 0.000117622828, 0.000264635184, 0.000470422284, 0.000734953934,
+  0.00105819132, 0.00144008702, 0.001880585, 0.00237962063, 0.00293712069, 0.00355300339,
+  0.00422717835, 0.00495954667, 0.00575000089, 0.00659842503, 0.00750469462, 0.00846867668,
+  0.00949022977, 0.010569204, 0.0117054411, 0.0128987743, 0.0141490286, 0.0154560205,
+  0.0168195582, 0.0182394417, 0.0197154627, 0.0212474046, 0.0228350425, 0.0244781437,
+  0.026176467, 0.0279297632, 0.0297377751, 0.0316002374, 0.0335168768, 0.0354874122,
+  0.0375115544, 0.0395890064, 0.0417194634, 0.0439026129, 0.0461381345, 0.0484257002,
+  0.0507649745, 0.053155614, 0.055597268, 0.0580895782, 0.0606321791, 0.0632246975,
+  0.0658667531, 0.0685579582, 0.0712979179, 0.0740862303, 0.0769224863, 0.0798062696,
+  0.0827371573, 0.0857147192, 0.0887385185, 0.0918081116, 0.094923048, 0.0980828708,
+  0.101287116, 0.104535314, 0.107826989, 0.111161656, 0.114538827, 0.117958006,
+  0.121418692, 0.124920377, 0.128462546, 0.132044682, 0.135666257, 0.13932674,
+  0.143025595, 0.146762279, 0.150536243, 0.154346933, 0.158193792, 0.162076253,
+  0.165993748, 0.169945702, 0.173931534, 0.177950661, 0.182002492, 0.186086434,
+  0.190201885, 0.194348244, 0.198524902, 0.202731245, 0.206966656, 0.211230515,
+  0.215522196, 0.219841068, 0.224186498, 0.22855785, 0.23295448, 0.237375745,
+  0.241820995, 0.246289578, 0.250780839, 0.255294119, 0.259828755, 0.264384083,
+  0.268959433, 0.273554135, 0.278167514, 0.282798893, 0.287447594, 0.292112933,
+  0.296794227, 0.301490789, 0.306201928, 0.310926955, 0.315665176, 0.320415896,
+  0.325178418, 0.329952042, 0.33473607, 0.339529797, 0.344332523, 0.34914354,
+  0.353962145, 0.358787629, 0.363619286, 0.368456405, 0.373298277, 0.378144192,
+  0.382993439, 0.387845306, 0.392699082, 0.397552857, 0.402404724, 0.407253971,
+  0.412099886, 0.416941759, 0.421778878, 0.426610534, 0.431436018, 0.436254623,
+  0.441065641, 0.445868366, 0.450662094, 0.455446121, 0.460219746, 0.464982267,
+  0.469732987, 0.474471208, 0.479196235, 0.483907375, 0.488603936, 0.49328523,
+  0.49795057, 0.50259927, 0.50723065, 0.511844029, 0.51643873, 0.521014081,
+  0.525569408, 0.530104044, 0.534617324, 0.539108585, 0.543577169, 0.548022419,
+  0.552443683, 0.556840314, 0.561211665, 0.565557095, 0.569875968, 0.574167648,
+  0.578431507, 0.582666919, 0.586873262, 0.591049919, 0.595196278, 0.59931173,
+  0.603395671, 0.607447502, 0.611466629, 0.615452462, 0.619404415, 0.62332191,
+  0.627204372, 0.63105123, 0.634861921, 0.638635885, 0.642372568, 0.646071423,
+  0.649731907, 0.653353482, 0.656935617, 0.660477787, 0.663979472, 0.667440157,
+  0.670859337, 0.674236508, 0.677571175, 0.680862849, 0.684111047, 0.687315293,
+  0.690475115, 0.693590052, 0.696659645, 0.699683444, 0.702661006, 0.705591894,
+  0.708475677, 0.711311933, 0.714100245, 0.716840205, 0.71953141, 0.722173466,
+  0.724765984, 0.727308585, 0.729800895, 0.732242549, 0.734633189, 0.736972463,
+  0.739260029, 0.74149555, 0.7436787, 0.745809157, 0.747886609, 0.749910751,
+  0.751881287, 0.753797926, 0.755660388, 0.7574684, 0.759221696, 0.76092002,
+  0.762563121, 0.764150759, 0.765682701, 0.767158722, 0.768578605, 0.769942143,
+  0.771249135, 0.772499389, 0.773692722, 0.774828959, 0.775907934, 0.776929487,
+  0.777893469, 0.778799738, 0.779648163, 0.780438617, 0.781170985, 0.78184516,
+  0.782461043, 0.783018543, 0.783517578, 0.783958076, 0.784339972, 0.784663209,
+  0.784927741, 0.785133528, 0.785280541, 0.785368757, 0.785398163,
+};
+static constexpr float SWEPT_TURN_45_VELOCITY_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 0.13658038, 0.27314072, 0.409660985, 0.546121144, 0.682501175,
+  0.818781069, 0.954940831, 1.09096048, 1.22682007, 1.36249965, 1.49797933,
+  1.63323922, 1.76825948, 1.90302029, 2.0375019, 2.17168456, 2.30554859,
+  2.43907434, 2.57224223, 2.70503272, 2.83742632, 2.96940361, 3.10094523,
+  3.23203187, 3.3626443, 3.49276337, 3.62236997, 3.75144509, 3.87996979,
+  4.00792522, 4.13529261, 4.26205326, 4.38818857, 4.51368004, 4.63850926,
+  4.76265791, 4.88610778, 5.00884076, 5.13083883, 5.25208409, 5.37255877,
+  5.49224517, 5.61112575, 5.72918306, 5.84639977, 5.96275869, 6.07824275,
+  6.192835, 6.30651863, 6.41927695, 6.53109344, 6.64195167, 6.75183539,
+  6.86072847, 6.96861494, 7.07547896, 7.18130486, 7.28607711, 7.38978034,
+  7.49239933, 7.59391902, 7.69432453, 7.79360111, 7.89173421, 7.98870942,
+  8.08451252, 8.17912945, 8.27254632, 8.36474944, 8.45572527, 8.54546047,
+  8.63394186, 8.72115648, 8.80709151, 8.89173436, 8.9750726, 9.057094,
+  9.13778654, 9.21713837, 9.29513785, 9.37177354, 9.44703418, 9.52090875,
+  9.5933864, 9.66445649, 9.7341086, 9.80233251, 9.86911821, 9.9344559,
+  9.998336, 10.0607491, 10.1216861, 10.1811381, 10.2390962, 10.2955521,
+  10.3504973, 10.403924, 10.4558241, 10.5061902, 10.5550148, 10.6022907,
+  10.6480111, 10.6921692, 10.7347585, 10.7757727, 10.815206, 10.8530524,
+  10.8893065, 10.9239628, 10.9570164, 10.9884624, 11.0182961, 11.0465132,
+  11.0731095, 11.0980812, 11.1214246, 11.1431362, 11.1632129, 11.1816516,
+  11.1984499, 11.213605, 11.2271149, 11.2389775, 11.2491911, 11.2577543,
+  11.2646656, 11.2699243, 11.2735293, 11.2699243, 11.2646656, 11.2577543,
+  11.2491911, 11.2389775, 11.2271149, 11.213605, 11.1984499, 11.1816516,
+  11.1632129, 11.1431362, 11.1214246, 11.0980812, 11.0731095, 11.0465132,
+  11.0182961, 10.9884624, 10.9570164, 10.9239628, 10.8893065, 10.8530524,
+  10.815206, 10.7757727, 10.7347585, 10.6921692, 10.6480111, 10.6022907,
+  10.5550148, 10.5061902, 10.4558241, 10.403924, 10.3504973, 10.2955521,
+  10.2390962, 10.1811381, 10.1216861, 10.0607491, 9.998336, 9.9344559,
+  9.86911821, 9.80233251, 9.7341086, 9.66445649, 9.5933864, 9.52090875,
+  9.44703418, 9.37177354, 9.29513785, 9.21713837, 9.13778654, 9.057094,
+  8.9750726, 8.89173436, 8.80709151, 8.72115648, 8.63394186, 8.54546047,
+  8.45572527, 8.36474944, 8.27254632, 8.17912945, 8.08451252, 7.98870942,
+  7.89173421, 7.79360111, 7.69432453, 7.59391902, 7.49239933, 7.38978034,
+  7.28607711, 7.18130486, 7.07547896, 6.96861494, 6.86072847, 6.75183539,
+  6.64195167, 6.53109344, 6.41927695, 6.30651863, 6.192835, 6.07824275,
+  5.96275869, 5.84639977, 5.72918306, 5.61112575, 5.49224517, 5.37255877,
+  5.25208409, 5.13083883, 5.00884076, 4.88610778, 4.76265791, 4.63850926,
+  4.51368004, 4.38818857, 4.26205326, 4.13529261, 4.00792522, 3.87996979,
+  3.75144509, 3.62236997, 3.49276337, 3.3626443, 3.23203187, 3.10094523,
+  2.96940361, 2.83742632, 2.70503272, 2.57224223, 2.43907434, 2.30554859,
+  2.17168456, 2.0375019, 1.90302029, 1.76825948, 1.63323922, 1.49797933,
+  1.36249965, 1.22682007, 1.09096048, 0.954940831, 0.818781069, 0.682501175,
+  0.546121144, 0.409660985, 0.27314072, 0.13658038, 0,
+};
+static constexpr float SWEPT_TURN_45_ACCEL_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  317.18673, 317.163461, 317.093657, 316.977329, 316.814494, 316.605175,
+  316.349404, 316.047217, 315.69866, 315.303782, 314.862643, 314.375307,
+  313.841846, 313.262337, 312.636866, 311.965524, 311.248411, 310.485631,
+  309.677295, 308.823524, 307.924442, 306.98018, 305.990878, 304.956681,
+  303.87774, 302.754214, 301.586267, 300.374071, 299.117804, 297.81765,
+  296.4738, 295.086451, 293.655806, 292.182076, 290.665476, 289.10623,
+  287.504565, 285.860718, 284.174929, 282.447445, 280.67852, 278.868414,
+  277.017391, 275.125725, 273.193691, 271.221575, 269.209664, 267.158254,
+  265.067647, 262.938149, 260.770072, 258.563734, 256.31946, 254.037578,
+  251.718424, 249.362337, 246.969663, 244.540754, 242.075965, 239.575659,
+  237.040201, 234.469965, 231.865327, 229.22667, 226.55438, 223.84885,
+  221.110477, 218.339661, 215.536811, 212.702337, 209.836655, 206.940186,
+  204.013353, 201.056588, 198.070324, 195.054998, 192.011054, 188.938938,
+  185.8391, 182.711996, 179.558084, 176.377827, 173.171691, 169.940148,
+  166.683671, 163.402738, 160.09783, 156.769432, 153.418033, 150.044124,
+  146.648201, 143.230761, 139.792306, 136.333341, 132.854373, 129.355912,
+  125.838472, 122.302569, 118.748721, 115.17745, 111.589281, 107.984738,
+  104.364353, 100.728654, 97.0781771, 93.4134563, 89.7350299, 86.0434374,
+  82.3392204, 78.6229226, 74.8950891, 71.1562669, 67.4070046, 63.6478522,
+  59.8793614, 56.1020849, 52.3165771, 48.5233934, 44.7230902, 40.9162252,
+  37.1033569, 33.2850448, 29.461849, 25.6343306, 21.803051, 17.9685725,
+  14.1314577, 10.2922694, 6.45157103, -10.2922694, -14.1314577, -17.9685725,
+  -21.803051, -25.6343306, -29.461849, -33.2850448, -37.1033569, -40.9162252,
+  -44.7230902, -48.5233934, -52.3165771, -56.1020849, -59.8793614, -63.6478522,
+  -67.4070046, -71.1562669, -74.8950891, -78.6229226, -82.3392204, -86.0434374,
+  -89.7350299, -93.4134563, -97.0781771, -100.728654, -104.364353, -107.984738,
+  -111.589281, -115.17745, -118.748721, -122.302569, -125.838472, -129.355912,
+  -132.854373, -136.333341, -139.792306, -143.230761, -146.648201, -150.044124,
+  -153.418033, -156.769432, -160.09783, -163.402738, -166.683671, -169.940148,
+  -173.171691, -176.377827, -179.558084, -182.711996, -185.8391, -188.938938,
+  -192.011054, -195.054998, -198.070324, -201.056588, -204.013353, -206.940186,
+  -209.836655, -212.702337, -215.536811, -218.339661, -221.110477, -223.84885,
+  -226.55438, -229.22667, -231.865327, -234.469965, -237.040201, -239.575659,
+  -242.075965, -244.540754, -246.969663, -249.362337, -251.718424, -254.037578,
+  -256.31946, -258.563734, -260.770072, -262.938149, -265.067647, -267.158254,
+  -269.209664, -271.221575, -273.193691, -275.125725, -277.017391, -278.868414,
+  -280.67852, -282.447445, -284.174929, -285.860718, -287.504565, -289.10623,
+  -290.665476, -292.182076, -293.655806, -295.086451, -296.4738, -297.81765,
+  -299.117804, -300.374071, -301.586267, -302.754214, -303.87774, -304.956681,
+  -305.990878, -306.98018, -307.924442, -308.823524, -309.677295, -310.485631,
+  -311.248411, -311.965524, -312.636866, -313.262337, -313.841846, -314.375307,
+  -314.862643, -315.303782, -315.69866, -316.047217, -316.349404, -316.605175,
+  -316.814494, -316.977329, -317.093657, -317.163461, -317.18673,
+};
+
+#define SWEPT_TURN_90_TABLE_SOURCE { 0.84, 90.0 }
+#define SWEPT_TURN_90_DURATION 0.176535001
+static constexpr float SWEPT_TURN_90_ANGLE_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 7.54143579e-05, 0.000301630979, 0.000678570513, 0.00120610074, 0.00188403663,
+  0.00271214037, 0.00369012149, 0.00481763696, 0.00609429127, 0.00751963662, 0.00909317303,
+  0.0108143486, 0.0126825595, 0.0146971505, 0.016857415, 0.0191625951, 0.0216118823,
+  0.0242044175, 0.0269392913, 0.0298155443, 0.0328321678, 0.0359881035, 0.0392822444,
+  0.0427134351, 0.0462804721, 0.049982104, 0.0538170326, 0.0577839126, 0.0618813526,
+  0.0661079153, 0.0704621183, 0.0749424341, 0.0795472912, 0.0842750744, 0.0891241254,
+  0.0940927432, 0.0991791851, 0.104381667, 0.109698363, 0.11512741, 0.120666903,
+  0.126314898, 0.132069415, 0.137928434, 0.143889902, 0.149951726, 0.156111781,
+  0.162367906, 0.168717906, 0.175159554, 0.18169059, 0.188308724, 0.195011634,
+  0.201796968, 0.208662348, 0.215605365, 0.222623582, 0.229714539, 0.236875749,
+  0.244104699, 0.251398853, 0.258755654, 0.26617252, 0.273646851, 0.281176023,
+  0.288757397, 0.296388312, 0.304066093, 0.311788046, 0.319551463, 0.32735362,
+  0.335191781, 0.343063196, 0.350965104, 0.358894733, 0.366849303, 0.374826023,
+  0.382822094, 0.390834712, 0.398861067, 0.406898343, 0.414943721, 0.422994379,
+  0.431047494, 0.439100918, 0.447154343, 0.455207767, 0.463261191, 0.471314616,
+  0.47936804, 0.487421464, 0.495474889, 0.503528313, 0.511581737, 0.519635161,
+  0.527688586, 0.53574201, 0.543795434, 0.551848859, 0.559902283, 0.567955707,
+  0.576009132, 0.584062556, 0.59211598, 0.600169404, 0.608222829, 0.616276253,
+  0.624329677, 0.632383102, 0.640436526, 0.64848995, 0.656543375, 0.664596799,
+  0.672650223, 0.680703647, 0.688757072, 0.696810496, 0.70486392, 0.712917345,
+  0.720970769, 0.729024193, 0.737077618, 0.745131042, 0.753184466, 0.76123789,
+  0.769291315, 0.777344739, 0.785398163, 0.793451588, 0.801505012, 0.809558436,
+  0.817611861, 0.825665285, 0.833718709, 0.841772134, 0.849825558, 0.857878982,
+  0.865932406, 0.873985831, 0.882039255, 0.890092679, 0.898146104, 0.906199528,
+  0.914252952, 0.922306377, 0.930359801, 0.938413225, 0.946466649, 0.954520074,
+  0.962573498, 0.970626922, 0.978680347, 0.986733771, 0.994787195, 1.00284062,
+  1.01089404, 1.01894747, 1.02700089, 1.03505432, 1.04310774, 1.05116117,
+  1.05921459, 1.06726801, 1.07532144, 1.08337486, 1.09142829, 1.09948171,
+  1.10753514, 1.11558856, 1.12364198, 1.13169541, 1.13974883, 1.14780195,
+  1.15585261, 1.16389798, 1.17193526, 1.17996161, 1.18797423, 1.1959703,
+  1.20394702, 1.21190159, 1.21983122, 1.22773313, 1.23560455, 1.24344271,
+  1.25124486, 1.25900828, 1.26673023, 1.27440801, 1.28203893, 1.2896203,
+  1.29714948, 1.30462381, 1.31204067, 1.31939747, 1.32669163, 1.33392058,
+  1.34108179, 1.34817274, 1.35519096, 1.36213398, 1.36899936, 1.37578469,
+  1.3824876, 1.38910574, 1.39563677, 1.40207842, 1.40842842, 1.41468455,
+  1.4208446, 1.42690642, 1.43286789, 1.43872691, 1.44448143, 1.45012942,
+  1.45566892, 1.46109796, 1.46641466, 1.47161714, 1.47670358, 1.4816722,
+  1.48652125, 1.49124904, 1.49585389, 1.50033421, 1.50468841, 1.50891497,
+  1.51301241, 1.51697929, 1.52081422, 1.52451585, 1.52808289, 1.53151408,
+  1.53480822, 1.53796416, 1.54098078, 1.54385704, 1.54659191, 1.54918444,
+  1.55163373, 1.55393891, 1.55609918, 1.55811377, 1.55998198, 1.56170315,
+  1.56327669, 1.56470204, 1.56597869, 1.56710621, 1.56808419, 1.56891229,
+  1.56959023, 1.57011776, 1.5704947, 1.57072091, 1.57079633,
+};
+static constexpr float SWEPT_TURN_90_VELOCITY_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 0.218715962, 0.437355205, 0.655841038, 0.874096823, 1.092046,
+  1.30961213, 1.52671889, 1.74329012, 1.95924986, 2.17452236, 2.38903211,
+  2.60270387, 2.81546267, 3.02723391, 3.23794329, 3.4475169, 3.65588124,
+  3.86296321, 4.06869018, 4.27298998, 4.47579096, 4.67702197, 4.87661244,
+  5.07449235, 5.27059229, 5.46484347, 5.65717777, 5.84752771, 6.03582652,
+  6.22200816, 6.40600733, 6.58775947, 6.76720084, 6.94426849, 7.11890032,
+  7.29103507, 7.46061236, 7.62757271, 7.79185755, 7.95340926, 8.11217117,
+  8.26808759, 8.42110383, 8.57116623, 8.71822213, 8.86221997, 9.00310922,
+  9.14084047, 9.27536541, 9.40663686, 9.53460876, 9.65923622, 9.78047554,
+  9.89828418, 10.0126208, 10.1234454, 10.2307189, 10.3344039, 10.4344639,
+  10.5308638, 10.6235698, 10.7125494, 10.7977714, 10.8792059, 10.9568243,
+  11.0305994, 11.1005054, 11.1665176, 11.228613, 11.2867698, 11.3409675,
+  11.3911871, 11.4374112, 11.4796233, 11.5178087, 11.5519541, 11.5820475,
+  11.6080782, 11.6300372, 11.6479167, 11.6617105, 11.6714138, 11.6770231,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714,
+  11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6785714, 11.6770231,
+  11.6714138, 11.6617105, 11.6479167, 11.6300372, 11.6080782, 11.5820475,
+  11.5519541, 11.5178087, 11.4796233, 11.4374112, 11.3911871, 11.3409675,
+  11.2867698, 11.228613, 11.1665176, 11.1005054, 11.0305994, 10.9568243,
+  10.8792059, 10.7977714, 10.7125494, 10.6235698, 10.5308638, 10.4344639,
+  10.3344039, 10.2307189, 10.1234454, 10.0126208, 9.89828418, 9.78047554,
+  9.65923622, 9.53460876, 9.40663686, 9.27536541, 9.14084047, 9.00310922,
+  8.86221997, 8.71822213, 8.57116623, 8.42110383, 8.26808759, 8.11217117,
+  7.95340926, 7.79185755, 7.62757271, 7.46061236, 7.29103507, 7.11890032,
+  6.94426849, 6.76720084, 6.58775947, 6.40600733, 6.22200816, 6.03582652,
+  5.84752771, 5.65717777, 5.46484347, 5.27059229, 5.07449235, 4.87661244,
+  4.67702197, 4.47579096, 4.27298998, 4.06869018, 3.86296321, 3.65588124,
+  3.4475169, 3.23794329, 3.02723391, 2.81546267, 2.60270387, 2.38903211,
+  2.17452236, 1.95924986, 1.74329012, 1.52671889, 1.30961213, 1.092046,
+  0.874096823, 0.655841038, 0.437355205, 0.218715962, 0,
+};
+static constexpr float SWEPT_TURN_90_ACCEL_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  317.18673, 317.131101, 316.964232, 316.686182, 316.297049, 315.79697,
+  315.186119, 314.46471, 313.632998, 312.691274, 311.639867, 310.479147,
+  309.209522, 307.831435, 306.345371, 304.751851, 303.051434, 301.244717,
+  299.332332, 297.314951, 295.193282, 292.968069, 290.640091, 288.210167,
+  285.679148, 283.047922, 280.317411, 277.488575, 274.562404, 271.539926,
+  268.4222, 265.210321, 261.905414, 258.50864, 255.021188, 251.444284,
+  247.779181, 244.027165, 240.189553, 236.267689, 232.262951, 228.176742,
+  224.010496, 219.765675, 215.443767, 211.046288, 206.57478, 202.030814,
+  197.415981, 192.731901, 187.980217, 183.162595, 178.280726, 173.336322,
+  168.331117, 163.266867, 158.145349, 152.968358, 147.73771, 142.455241,
+  137.122804, 131.742268, 126.315521, 120.844466, 115.331024, 109.777127,
+  104.184724, 98.5557756, 92.8922575, 87.1961558, 81.4694685, 75.7142043,
+  69.9323821, 64.1260298, 58.2971842, 52.4478898, 46.5801983, 40.6961681,
+  34.7978629, 28.8873518, 22.966708, 17.0380081, 11.1033319, 5.16476096,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, -5.16476096,
+  -11.1033319, -17.0380081, -22.966708, -28.8873518, -34.7978629, -40.6961681,
+  -46.5801983, -52.4478898, -58.2971842, -64.1260298, -69.9323821, -75.7142043,
+  -81.4694685, -87.1961558, -92.8922575, -98.5557756, -104.184724, -109.777127,
+  -115.331024, -120.844466, -126.315521, -131.742268, -137.122804, -142.455241,
+  -147.73771, -152.968358, -158.145349, -163.266867, -168.331117, -173.336322,
+  -178.280726, -183.162595, -187.980217, -192.731901, -197.415981, -202.030814,
+  -206.57478, -211.046288, -215.443767, -219.765675, -224.010496, -228.176742,
+  -232.262951, -236.267689, -240.189553, -244.027165, -247.779181, -251.444284,
+  -255.021188, -258.50864, -261.905414, -265.210321, -268.4222, -271.539926,
+  -274.562404, -277.488575, -280.317411, -283.047922, -285.679148, -288.210167,
+  -290.640091, -292.968069, -295.193282, -297.314951, -299.332332, -301.244717,
+  -303.051434, -304.751851, -306.345371, -307.831435, -309.209522, -310.479147,
+  -311.639867, -312.691274, -313.632998, -314.46471, -315.186119, -315.79697,
+  -316.297049, -316.686182, -316.964232, -317.131101, -317.18673,
+};
+
+#define SWEPT_TURN_135_TABLE_SOURCE { 0.8975, 135.0 }
+#define SWEPT_TURN_135_DURATION 0.254903844
+static constexpr float SWEPT_TURN_135_ANGLE_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 0.000157227184, 0.000628777478, 0.00141425721, 0.00251301064, 0.00392412046,
+  0.00564640865, 0.00767843735, 0.0100185101, 0.0126646735, 0.0156147182, 0.0188661814,
+  0.0224163488, 0.0262622565, 0.0304006937, 0.0348282056, 0.0395410958, 0.0445354299,
+  0.0498070384, 0.0553515204, 0.061164247, 0.0672403655, 0.0735748035, 0.0801622726,
+  0.0869972734, 0.0940740996, 0.101386843, 0.1089294, 0.116695472, 0.124678576,
+  0.132872048, 0.141269047, 0.149862563, 0.158645423, 0.167610293, 0.17674969,
+  0.186055983, 0.195521404, 0.20513805, 0.214897892, 0.224792784, 0.234814463,
+  0.244954565, 0.255204623, 0.26555608, 0.276000294, 0.286528546, 0.297132048,
+  0.307801945, 0.318529332, 0.329305251, 0.340120708, 0.350966673, 0.36183409,
+  0.372713888, 0.383597376, 0.394480936, 0.405364496, 0.416248055, 0.427131615,
+  0.438015175, 0.448898735, 0.459782295, 0.470665855, 0.481549415, 0.492432974,
+  0.503316534, 0.514200094, 0.525083654, 0.535967214, 0.546850774, 0.557734334,
+  0.568617893, 0.579501453, 0.590385013, 0.601268573, 0.612152133, 0.623035693,
+  0.633919252, 0.644802812, 0.655686372, 0.666569932, 0.677453492, 0.688337052,
+  0.699220612, 0.710104171, 0.720987731, 0.731871291, 0.742754851, 0.753638411,
+  0.764521971, 0.775405531, 0.78628909, 0.79717265, 0.80805621, 0.81893977,
+  0.82982333, 0.84070689, 0.85159045, 0.862474009, 0.873357569, 0.884241129,
+  0.895124689, 0.906008249, 0.916891809, 0.927775368, 0.938658928, 0.949542488,
+  0.960426048, 0.971309608, 0.982193168, 0.993076728, 1.00396029, 1.01484385,
+  1.02572741, 1.03661097, 1.04749453, 1.05837809, 1.06926165, 1.08014521,
+  1.09102877, 1.10191233, 1.11279589, 1.12367945, 1.13456301, 1.14544657,
+  1.15633013, 1.16721369, 1.17809725, 1.1889808, 1.19986436, 1.21074792,
+  1.22163148, 1.23251504, 1.2433986, 1.25428216, 1.26516572, 1.27604928,
+  1.28693284, 1.2978164, 1.30869996, 1.31958352, 1.33046708, 1.34135064,
+  1.3522342, 1.36311776, 1.37400132, 1.38488488, 1.39576844, 1.406652,
+  1.41753556, 1.42841912, 1.43930268, 1.45018624, 1.4610698, 1.47195336,
+  1.48283692, 1.49372048, 1.50460404, 1.5154876, 1.52637116, 1.53725472,
+  1.54813828, 1.55902184, 1.5699054, 1.58078896, 1.59167252, 1.60255608,
+  1.61343964, 1.6243232, 1.63520676, 1.64609032, 1.65697388, 1.66785744,
+  1.678741, 1.68962456, 1.70050812, 1.71139168, 1.72227524, 1.7331588,
+  1.74404236, 1.75492592, 1.76580948, 1.77669304, 1.7875766, 1.79846016,
+  1.80934372, 1.82022728, 1.83111084, 1.8419944, 1.85287796, 1.86376152,
+  1.87464508, 1.88552864, 1.8964122, 1.90729576, 1.91817932, 1.92906287,
+  1.93994643, 1.95082999, 1.96171355, 1.97259711, 1.9834806, 1.9943604,
+  2.00522782, 2.01607378, 2.02688924, 2.03766516, 2.04839254, 2.05906244,
+  2.06966594, 2.0801942, 2.09063841, 2.10098987, 2.11123993, 2.12138003,
+  2.13140171, 2.1412966, 2.15105644, 2.16067309, 2.17013851, 2.1794448,
+  2.1885842, 2.19754907, 2.20633193, 2.21492544, 2.22332244, 2.23151591,
+  2.23949902, 2.24726509, 2.25480765, 2.26212039, 2.26919722, 2.27603222,
+  2.28261969, 2.28895412, 2.29503024, 2.30084297, 2.30638745, 2.31165906,
+  2.31665339, 2.32136628, 2.3257938, 2.32993223, 2.33377814, 2.33732831,
+  2.34057977, 2.34352982, 2.34617598, 2.34851605, 2.35054808, 2.35227037,
+  2.35368148, 2.35478023, 2.35556571, 2.35603726, 2.35619449,
+};
+static constexpr float SWEPT_TURN_135_VELOCITY_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 0.315784636, 0.631305641, 0.946299608, 1.26050356, 1.5736552,
+  1.88549309, 2.19575689, 2.50418758, 2.81052768, 3.11452143, 3.41591506,
+  3.71445694, 4.00989784, 4.30199111, 4.59049291, 4.87516238, 5.15576187,
+  5.43205711, 5.70381746, 5.97081602, 6.23282991, 6.48964038, 6.74103303,
+  6.986798, 7.2267301, 7.46062904, 7.68829954, 7.90955153, 8.12420031,
+  8.33206668, 8.5329771, 8.72676385, 8.91326514, 9.09232527, 9.26379477,
+  9.42753047, 9.58339568, 9.73126029, 9.87100085, 10.0025007, 10.12565,
+  10.2403461, 10.3464931, 10.4440024, 10.5327927, 10.6127897, 10.6839268,
+  10.7461444, 10.7993908, 10.8436214, 10.8787993, 10.9048951, 10.9218871,
+  10.9297611, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9303621,
+  10.9303621, 10.9303621, 10.9303621, 10.9303621, 10.9297611, 10.9218871,
+  10.9048951, 10.8787993, 10.8436214, 10.7993908, 10.7461444, 10.6839268,
+  10.6127897, 10.5327927, 10.4440024, 10.3464931, 10.2403461, 10.12565,
+  10.0025007, 9.87100085, 9.73126029, 9.58339568, 9.42753047, 9.26379477,
+  9.09232527, 8.91326514, 8.72676385, 8.5329771, 8.33206668, 8.12420031,
+  7.90955153, 7.68829954, 7.46062904, 7.2267301, 6.986798, 6.74103303,
+  6.48964038, 6.23282991, 5.97081602, 5.70381746, 5.43205711, 5.15576187,
+  4.87516238, 4.59049291, 4.30199111, 4.00989784, 3.71445694, 3.41591506,
+  3.11452143, 2.81052768, 2.50418758, 2.19575689, 1.88549309, 1.5736552,
+  1.26050356, 0.946299608, 0.631305641, 0.315784636, 0,
+};
+static constexpr float SWEPT_TURN_135_ACCEL_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  317.18673, 317.05433, 316.65724, 315.995792, 315.070537, 313.882249,
+  312.431919, 310.720759, 308.750196, 306.521876, 304.037659, 301.299619,
+  298.310042, 295.071424, 291.586468, 287.858084, 283.889384, 279.683682,
+  275.244488, 270.57551, 265.680644, 260.563977, 255.22978, 249.682507,
+  243.92679, 237.967432, 231.809409, 225.457863, 218.918095, 212.195566,
+  205.295887, 198.224818, 190.988264, 183.592265, 176.042995, 168.346758,
+  160.509978, 152.539198, 144.441072, 136.22236, 127.889925, 119.450722,
+  110.911796, 102.280277, 93.5633706, 84.7683533, 75.902568, 66.9734161,
+  57.9883522, 48.9548771, 39.8805326, 30.7728942, 21.6395653, 12.4881709,
+  3.32635075, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, -3.32635075, -12.4881709,
+  -21.6395653, -30.7728942, -39.8805326, -48.9548771, -57.9883522, -66.9734161,
+  -75.902568, -84.7683533, -93.5633706, -102.280277, -110.911796, -119.450722,
+  -127.889925, -136.22236, -144.441072, -152.539198, -160.509978, -168.346758,
+  -176.042995, -183.592265, -190.988264, -198.224818, -205.295887, -212.195566,
+  -218.918095, -225.457863, -231.809409, -237.967432, -243.92679, -249.682507,
+  -255.22978, -260.563977, -265.680644, -270.57551, -275.244488, -279.683682,
+  -283.889384, -287.858084, -291.586468, -295.071424, -298.310042, -301.299619,
+  -304.037659, -306.521876, -308.750196, -310.720759, -312.431919, -313.882249,
+  -315.070537, -315.995792, -316.65724, -317.05433, -317.18673,
+};
+
+#define SWEPT_TURN_180_TABLE_SOURCE { 0.935, 180.0 }
+#define SWEPT_TURN_180_DURATION 0.337189921
+static constexpr float SWEPT_TURN_180_ANGLE_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 0.000275103977, 0.00109997977, 0.00247331966, 0.0043929464, 0.00685581671,
+  0.00985802606, 0.0133948149, 0.0174605761, 0.022048864, 0.0271524045, 0.0327631067,
+  0.0388720757, 0.0454696265, 0.0525452997, 0.0600878778, 0.068085403, 0.0765251966,
+  0.0853938783, 0.0946773883, 0.104361009, 0.114429388, 0.124866563, 0.135655988,
+  0.146780558, 0.158222637, 0.169964084, 0.181986285, 0.194270181, 0.206796297,
+  0.219544776, 0.232495405, 0.245627654, 0.258920704, 0.27235348, 0.285904686,
+  0.299552839, 0.313276302, 0.327053318, 0.340862046, 0.354681207, 0.368500697,
+  0.382320187, 0.396139677, 0.409959167, 0.423778657, 0.437598147, 0.451417637,
+  0.465237127, 0.479056617, 0.492876107, 0.506695597, 0.520515087, 0.534334577,
+  0.548154067, 0.561973557, 0.575793047, 0.589612537, 0.603432027, 0.617251517,
+  0.631071007, 0.644890497, 0.658709987, 0.672529477, 0.686348967, 0.700168457,
+  0.713987947, 0.727807437, 0.741626927, 0.755446417, 0.769265907, 0.783085397,
+  0.796904887, 0.810724377, 0.824543867, 0.838363357, 0.852182847, 0.866002337,
+  0.879821827, 0.893641317, 0.907460807, 0.921280297, 0.935099787, 0.948919277,
+  0.962738767, 0.976558257, 0.990377747, 1.00419724, 1.01801673, 1.03183622,
+  1.04565571, 1.0594752, 1.07329469, 1.08711418, 1.10093367, 1.11475316,
+  1.12857265, 1.14239214, 1.15621163, 1.17003112, 1.18385061, 1.1976701,
+  1.21148959, 1.22530908, 1.23912857, 1.25294806, 1.26676755, 1.28058704,
+  1.29440653, 1.30822602, 1.32204551, 1.335865, 1.34968449, 1.36350398,
+  1.37732347, 1.39114296, 1.40496245, 1.41878194, 1.43260143, 1.44642092,
+  1.46024041, 1.4740599, 1.48787939, 1.50169888, 1.51551837, 1.52933786,
+  1.54315735, 1.55697684, 1.57079633, 1.58461582, 1.59843531, 1.6122548,
+  1.62607429, 1.63989378, 1.65371327, 1.66753276, 1.68135225, 1.69517174,
+  1.70899123, 1.72281072, 1.73663021, 1.7504497, 1.76426919, 1.77808868,
+  1.79190817, 1.80572766, 1.81954715, 1.83336664, 1.84718613, 1.86100562,
+  1.87482511, 1.8886446, 1.90246409, 1.91628358, 1.93010307, 1.94392256,
+  1.95774205, 1.97156154, 1.98538103, 1.99920052, 2.01302001, 2.0268395,
+  2.04065899, 2.05447848, 2.06829797, 2.08211746, 2.09593695, 2.10975644,
+  2.12357593, 2.13739542, 2.15121491, 2.1650344, 2.17885389, 2.19267338,
+  2.20649287, 2.22031236, 2.23413185, 2.24795134, 2.26177083, 2.27559032,
+  2.28940981, 2.3032293, 2.31704879, 2.33086828, 2.34468777, 2.35850726,
+  2.37232675, 2.38614624, 2.39996573, 2.41378522, 2.42760471, 2.4414242,
+  2.45524369, 2.46906318, 2.48288267, 2.49670216, 2.51052165, 2.52434114,
+  2.53816063, 2.55198012, 2.56579961, 2.5796191, 2.59343859, 2.60725808,
+  2.62107757, 2.63489706, 2.64871655, 2.66253604, 2.67635553, 2.69017502,
+  2.70399451, 2.717814, 2.73163349, 2.74545298, 2.75927247, 2.77309196,
+  2.78691145, 2.80073061, 2.81453934, 2.82831635, 2.84203981, 2.85568797,
+  2.86923917, 2.88267195, 2.895965, 2.90909725, 2.92204788, 2.93479636,
+  2.94732247, 2.95960637, 2.97162857, 2.98337002, 2.9948121, 3.00593667,
+  3.01672609, 3.02716327, 3.03723164, 3.04691527, 3.05619878, 3.06506746,
+  3.07350725, 3.08150478, 3.08904735, 3.09612303, 3.10272058, 3.10882955,
+  3.11444025, 3.11954379, 3.12413208, 3.12819784, 3.13173463, 3.13473684,
+  3.13719971, 3.13911933, 3.14049267, 3.14131755, 3.14159265,
+};
+static constexpr float SWEPT_TURN_180_VELOCITY_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  0, 0.417671513, 0.834680868, 1.25036696, 1.66407077, 2.07513643,
+  2.48291226, 2.88675179, 3.28601479, 3.68006828, 4.06828754, 4.45005712,
+  4.82477177, 5.19183744, 5.55067219, 5.90070714, 6.24138736, 6.57217276,
+  6.89253892, 7.20197794, 7.49999925, 7.78613039, 8.05991773, 8.32092723,
+  8.56874508, 8.80297842, 9.02325589, 9.22922828, 9.42056904, 9.59697485,
+  9.75816602, 9.90388701, 10.0339068, 10.1480193, 10.2460435, 10.3278241,
+  10.3932314, 10.4421618, 10.4745375, 10.4903074, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786, 10.4919786,
+  10.4919786, 10.4903074, 10.4745375, 10.4421618, 10.3932314, 10.3278241,
+  10.2460435, 10.1480193, 10.0339068, 9.90388701, 9.75816602, 9.59697485,
+  9.42056904, 9.22922828, 9.02325589, 8.80297842, 8.56874508, 8.32092723,
+  8.05991773, 7.78613039, 7.49999925, 7.20197794, 6.89253892, 6.57217276,
+  6.24138736, 5.90070714, 5.55067219, 5.19183744, 4.82477177, 4.45005712,
+  4.06828754, 3.68006828, 3.28601479, 2.88675179, 2.48291226, 2.07513643,
+  1.66407077, 1.25036696, 0.834680868, 0.417671513, 0,
+};
+static constexpr float SWEPT_TURN_180_ACCEL_TABLE[SWEPT_TURN_TABLE_SIZE] = {
+  317.18673, 316.935303, 316.18142, 314.926277, 313.171863, 310.92096,
+  308.177137, 304.944742, 301.228901, 297.035505, 292.371202, 287.243386,
+  281.660186, 275.630455, 269.163751, 262.270326, 254.961109, 247.247688,
+  239.142291, 230.657768, 221.80757, 212.605728, 203.06683, 193.205998,
+  183.038866, 172.581552, 161.850635, 150.863126, 139.636446, 128.188392,
+  116.537114, 104.701083, 92.6990628, 80.5500819, 68.2734003, 55.888481,
+  43.4149586, 30.8726079, 18.2813131, 5.66103591, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0,
+  0, -5.66103591, -18.2813131, -30.8726079, -43.4149586, -55.888481,
+  -68.2734003, -80.5500819, -92.6990628, -104.701083, -116.537114, -128.188392,
+  -139.636446, -150.863126, -161.850635, -172.581552, -183.038866, -193.205998,
+  -203.06683, -212.605728, -221.80757, -230.657768, -239.142291, -247.247688,
+  -254.961109, -262.270326, -269.163751, -275.630455, -281.660186, -287.243386,
+  -292.371202, -297.035505, -301.228901, -304.944742, -308.177137, -310.92096,
+  -313.171863, -314.926277, -316.18142, -316.935303, -317.18673,
+};
+
+#endif
@@ -4,10 +4,15 @@
 #include "../device/RangeSensor.h"
 #include "../device/RangeSensorContainer.h"
 #include "../device/sensors_encoders.h"
+#include "../device/WallEvidence.h"
 #include "../user_interaction/UserInterface.h"
 #include "../user_interaction/FreakOut.h"
 #include "../user_interaction/Logger.h"
 #include "../user_interaction/Menu.h"
+#include "../user_interaction/PerfCounters.h"
+#include "../motion/ControlScheduler.h"
+#include "../motion/Odometry.h"
+#include "../motion/WheelController.h"
 #include "../conf.h"
 #include "MotionCalc.h"
 #include "PIDController.h"
@@ -29,27 +34,15 @@ static float max_vel_straight = MAX_VEL_STRAIGHT;
 static float max_vel_diag = MAX_VEL_DIAG;
 static float max_vel_rotate = MAX_VEL_ROTATE;
 
-// instantiate the turn lookup tables
-const SweptTurnProfile turn_45_table(SWEPT_TURN_45_FORWARD_SPEED,
-                                     SWEPT_TURN_45_ANGLE);
-const SweptTurnProfile turn_90_table(SWEPT_TURN_90_FORWARD_SPEED,
-                                     SWEPT_TURN_90_ANGLE);
-const SweptTurnProfile turn_135_table(SWEPT_TURN_135_FORWARD_SPEED,
-                                      SWEPT_TURN_135_ANGLE);
-const SweptTurnProfile turn_180_table(SWEPT_TURN_180_FORWARD_SPEED,
-                                      SWEPT_TURN_180_ANGLE);
-
 void motion_forward(float distance, float current_speed, float exit_speed) {
   // HACK
   //distance *= 1.01;
-  float currentFrontRight, currentBackRight, currentFrontLeft, currentBackLeft;
-  float setpointFrontRight, setpointBackRight, setpointFrontLeft, setpointBackLeft;
   float correctionFrontRight, correctionBackRight, correctionFrontLeft, correctionBackLeft;
   float rangeOffset;
   float gyroOffset = 0;
   float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS / 360;
   float idealDistance, idealVelocity;
-  elapsedMicros moveTime;
+  uint32_t moveTime = 0;
 
   float currentExtrapolation = (enc_left_front_extrapolate() + enc_right_front_extrapolate()
                                  + enc_left_back_extrapolate() + enc_right_back_extrapolate())/4;
@@ -67,26 +60,28 @@ void motion_forward(float distance, float current_speed, float exit_speed) {
 
   Orientation& orientation = Orientation::getInstance();
 
-  PIDController left_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController left_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController wheels (KP_POSITION, KI_POSITION, KD_POSITION);
 
   PIDController range_PID (KP_RANGE, KI_RANGE, KD_RANGE);
   PIDController gyro_PID (KP_GYRO_FWD, KI_GYRO_FWD, KD_GYRO_FWD);
 
   // zero clock before move
-  moveTime = 0;
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   RangeSensors.updateReadings();
 
   //float lastRangeError = 0;
   bool passedMiddle = false;
-  orientation.handler_update_ = false;
-
   // execute motion
+  PERF_MOTION_TYPE('f');
   while (moveTime < motionCalc.getTotalTime()) {
+    moveTime = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
+    PERF_BEGIN(orientation);
     orientation.update();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
     //Run sensor protocol here.  Sensor protocol should use encoder_left/right_write() to adjust for encoder error
     idealDistance = motionCalc.idealDistance(moveTime);
     idealVelocity = motionCalc.idealVelocity(moveTime);
@@ -97,7 +92,16 @@ void motion_forward(float distance, float current_speed, float exit_speed) {
 
     // Add error from rangefinder data. Positive error is when it is too close
     // to the left wall, requiring a positive angle to fix it.
+    PERF_BEGIN(range);
     RangeSensors.updateReadings();
+    PERF_END(range, kPerfRange);
+    Odometry::observeWalls();
+    float encoderShift = Odometry::shiftEncoders();
+    wheels.shift(encoderShift, encoderShift);
+    // the straight ends at distance - drift, since the encoders were zeroed
+    // that far short of the last move's end
+    if (distance > 0)
+      wallEvidence.addSample(distance - drift - position * MM_PER_BLOCK);
     rangeOffset = range_PID.Calculate(RangeSensors.errorFromCenter(), 0);
     gyroOffset += gyro_PID.Calculate(orientation.getHeading()*distancePerDegree, rangeOffset);
 
@@ -105,24 +109,13 @@ void motion_forward(float distance, float current_speed, float exit_speed) {
       freakOut("BAD1");
     }
 
-    currentFrontLeft = enc_left_front_extrapolate();
-    currentBackLeft = enc_left_back_extrapolate();
-    currentFrontRight = enc_right_front_extrapolate();
-    currentBackRight = enc_right_back_extrapolate();
-
-    setpointFrontLeft = idealDistance + gyroOffset;
-    setpointBackLeft = idealDistance + gyroOffset;
-    setpointFrontRight = idealDistance - gyroOffset;
-    setpointBackRight = idealDistance - gyroOffset;
-
-    correctionFrontLeft = left_front_PID.Calculate(currentFrontLeft,
-                                                   setpointFrontLeft);
-    correctionBackLeft = left_back_PID.Calculate(currentBackLeft,
-                                                   setpointBackLeft);
-    correctionFrontRight = right_front_PID.Calculate(currentFrontRight,
-                                                   setpointFrontRight);
-    correctionBackRight = right_back_PID.Calculate(currentBackRight,
-                                                   setpointBackRight);
+    wheels.update(idealDistance + gyroOffset,
+                  idealDistance - gyroOffset);
+
+    correctionFrontLeft = wheels.getCorrection(WheelController::kLeftFront);
+    correctionBackLeft = wheels.getCorrection(WheelController::kLeftBack);
+    correctionFrontRight = wheels.getCorrection(WheelController::kRightFront);
+    correctionBackRight = wheels.getCorrection(WheelController::kRightBack);
 
     // Save isWall state for use by high-level code.
     if (!passedMiddle && position > distance / MM_PER_BLOCK - 0.5) {
@@ -142,6 +135,7 @@ void motion_forward(float distance, float current_speed, float exit_speed) {
     // Run PID to determine the offset that should be added/subtracted to the left/right wheels to fix the error.  Remember to remove or at the very least increase constraints on the I term
     // the offsets that are less than an encoder tick need to be added/subtracted from errorFrontLeft and errorFrontRight instead of encoderWrite being used.  Maybe add a third variable to the error calculation for these and other offsets
 
+    PERF_BEGIN(motors);
     motor_lf.Set(motionCalc.idealAccel(moveTime) + correctionFrontLeft,
                  idealVelocity);
     motor_rf.Set(motionCalc.idealAccel(moveTime) + correctionFrontRight,
@@ -150,16 +144,15 @@ void motion_forward(float distance, float current_speed, float exit_speed) {
                  idealVelocity);
     motor_lb.Set(motionCalc.idealAccel(moveTime) + correctionBackLeft,
                  idealVelocity);
+    PERF_END(motors, kPerfMotors);
 
     logger.logMotionType('f');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
 
-  uint8_t old_SREG = SREG;
-  noInterrupts();
   orientation.update();
-  orientation.handler_update_ = true;
-  SREG = old_SREG;
 
   enc_left_front_write(0);
   enc_right_front_write(0);
@@ -177,14 +170,12 @@ void motion_forward(float distance, float current_speed, float exit_speed) {
 }
 
 void motion_forward_diag(float distance, float current_speed, float exit_speed) {
-  float currentFrontRight, currentBackRight, currentFrontLeft, currentBackLeft;
-  float setpointFrontRight, setpointBackRight, setpointFrontLeft, setpointBackLeft;
   float correctionFrontRight, correctionBackRight, correctionFrontLeft, correctionBackLeft;
   float rangeOffset;
   float gyroOffset = 0;
   float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS / 360;
   float idealDistance, idealVelocity;
-  elapsedMicros moveTime;
+  uint32_t moveTime = 0;
 
   float currentExtrapolation = (enc_left_front_extrapolate() + enc_right_front_extrapolate()
                                  + enc_left_back_extrapolate() + enc_right_back_extrapolate())/4;
@@ -197,31 +188,36 @@ void motion_forward_diag(float distance, float current_speed, float exit_speed)
 
   Orientation& orientation = Orientation::getInstance();
 
-  PIDController left_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController left_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController wheels (KP_POSITION, KI_POSITION, KD_POSITION);
 
   PIDController range_PID (KP_RANGE, KI_RANGE, KD_RANGE);
   PIDController gyro_PID (0.0015, 0.000, 0.00);
 
   // zero clock before move
-  moveTime = 0;
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   RangeSensors.updateReadings();
 
-  orientation.handler_update_ = false;
-
   // execute motion
+  PERF_MOTION_TYPE('d');
   while (moveTime < motionCalc.getTotalTime()) {
+    moveTime = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
+    PERF_BEGIN(orientation);
     orientation.update();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
     //Run sensor protocol here.  Sensor protocol should use encoder_left/right_write() to adjust for encoder error
     idealDistance = motionCalc.idealDistance(moveTime);
     idealVelocity = motionCalc.idealVelocity(moveTime);
 
     // Add error from rangefinder data. Positive error is when it is too close
     // to the left wall, requiring a positive angle to fix it.
+    PERF_BEGIN(range);
     RangeSensors.updateReadings();
+    PERF_END(range, kPerfRange);
+    Odometry::observeWalls();
     //rangeOffset = range_PID.Calculate(RangeSensors.errorFromCenter(), 0);
     if (RangeSensors.frontRightSensor.getRange() < 150) {
       if (RangeSensors.frontLeftSensor.getRange() < 150) {
@@ -246,28 +242,18 @@ void motion_forward_diag(float distance, float current_speed, float exit_speed)
       //freakOut(buf);
     }
 
-    currentFrontLeft = enc_left_front_extrapolate();
-    currentBackLeft = enc_left_back_extrapolate();
-    currentFrontRight = enc_right_front_extrapolate();
-    currentBackRight = enc_right_back_extrapolate();
-
-    setpointFrontLeft = idealDistance + gyroOffset;
-    setpointBackLeft = idealDistance + gyroOffset;
-    setpointFrontRight = idealDistance - gyroOffset;
-    setpointBackRight = idealDistance - gyroOffset;
-
-    correctionFrontLeft = left_front_PID.Calculate(currentFrontLeft,
-                                                   setpointFrontLeft);
-    correctionBackLeft = left_back_PID.Calculate(currentBackLeft,
-                                                   setpointBackLeft);
-    correctionFrontRight = right_front_PID.Calculate(currentFrontRight,
-                                                   setpointFrontRight);
-    correctionBackRight = right_back_PID.Calculate(currentBackRight,
-                                                   setpointBackRight);
+    wheels.update(idealDistance + gyroOffset,
+                  idealDistance - gyroOffset);
+
+    correctionFrontLeft = wheels.getCorrection(WheelController::kLeftFront);
+    correctionBackLeft = wheels.getCorrection(WheelController::kLeftBack);
+    correctionFrontRight = wheels.getCorrection(WheelController::kRightFront);
+    correctionBackRight = wheels.getCorrection(WheelController::kRightBack);
 
     // Run PID to determine the offset that should be added/subtracted to the left/right wheels to fix the error.  Remember to remove or at the very least increase constraints on the I term
     // the offsets that are less than an encoder tick need to be added/subtracted from errorFrontLeft and errorFrontRight instead of encoderWrite being used.  Maybe add a third variable to the error calculation for these and other offsets
 
+    PERF_BEGIN(motors);
     motor_lf.Set(motionCalc.idealAccel(moveTime) + correctionFrontLeft,
                  idealVelocity);
     motor_rf.Set(motionCalc.idealAccel(moveTime) + correctionFrontRight,
@@ -276,16 +262,15 @@ void motion_forward_diag(float distance, float current_speed, float exit_speed)
                  idealVelocity);
     motor_lb.Set(motionCalc.idealAccel(moveTime) + correctionBackLeft,
                  idealVelocity);
+    PERF_END(motors, kPerfMotors);
 
     logger.logMotionType('d');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
 
-  uint8_t old_SREG = SREG;
-  noInterrupts();
   orientation.update();
-  orientation.handler_update_ = true;
-  SREG = old_SREG;
 
   enc_left_front_write(0);
   enc_right_front_write(0);
@@ -303,21 +288,16 @@ void motion_forward_diag(float distance, float current_speed, float exit_speed)
 }
 
 void motion_collect(float distance, float current_speed, float exit_speed){
-  float currentFrontRight, currentFrontLeft, currentBackRight, currentBackLeft;
-  float setpointFrontRight, setpointFrontLeft, setpointBackRight, setpointBackLeft;
   float correctionFrontRight, correctionFrontLeft, correctionBackRight, correctionBackLeft;
   float rotationOffset;
   float idealDistance, idealVelocity;
   float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS / 360;
-  elapsedMicros moveTime;
+  uint32_t moveTime = 0;
 
   MotionCalc motionCalc (distance, max_vel_straight, current_speed, exit_speed, max_accel_straight,
                          max_decel_straight);
 
-  PIDController left_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController left_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController wheels (KP_POSITION, KI_POSITION, KD_POSITION);
 
   PIDController rotation_PID (KP_ROTATION, KI_ROTATION, KD_ROTATION);
 
@@ -342,12 +322,15 @@ void motion_collect(float distance, float current_speed, float exit_speed){
   int reading_counter = 0;
 
   // zero clock before move
-  moveTime = 0;
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   // execute motion
   while (idealDistance != distance) {
+    moveTime = scheduler.waitForCycle();
     //Run sensor protocol here.  Sensor protocol should use encoder_left/right_write() to adjust for encoder error
     orientation.update();
+    Odometry::update();
     idealDistance = motionCalc.idealDistance(moveTime);
     idealVelocity = motionCalc.idealVelocity(moveTime);
 
@@ -389,24 +372,13 @@ void motion_collect(float distance, float current_speed, float exit_speed){
 
     rotationOffset += rotation_PID.Calculate(orientation.getHeading() * distancePerDegree, 0);
 
-    currentFrontLeft = enc_left_front_extrapolate();
-    currentBackLeft = enc_left_back_extrapolate();
-    currentFrontRight = enc_right_front_extrapolate();
-    currentBackRight = enc_right_back_extrapolate();
-
-    setpointFrontLeft = idealDistance + rotationOffset;
-    setpointBackLeft = idealDistance + rotationOffset;
-    setpointFrontRight = idealDistance - rotationOffset;
-    setpointBackRight = idealDistance - rotationOffset;
-
-    correctionFrontLeft = left_front_PID.Calculate(currentFrontLeft,
-                                                   setpointFrontLeft);
-    correctionBackLeft = left_back_PID.Calculate(currentBackLeft,
-                                                   setpointBackLeft);
-    correctionFrontRight = right_front_PID.Calculate(currentFrontRight,
-                                                   setpointFrontRight);
-    correctionBackRight = right_back_PID.Calculate(currentBackRight,
-                                                   setpointBackRight);
+    wheels.update(idealDistance + rotationOffset,
+                  idealDistance - rotationOffset);
+
+    correctionFrontLeft = wheels.getCorrection(WheelController::kLeftFront);
+    correctionBackLeft = wheels.getCorrection(WheelController::kLeftBack);
+    correctionFrontRight = wheels.getCorrection(WheelController::kRightFront);
+    correctionBackRight = wheels.getCorrection(WheelController::kRightBack);
 
     // Run PID to determine the offset that should be added/subtracted to the left/right wheels to fix the error.  Remember to remove or at the very least increase constraints on the I term
     // the offsets that are less than an encoder tick need to be added/subtracted from errorFrontLeft and errorFrontRight instead of encoderWrite being used.  Maybe add a third variable to the error calculation for these and other offsets
@@ -420,6 +392,7 @@ void motion_collect(float distance, float current_speed, float exit_speed){
     motor_lb.Set(motionCalc.idealAccel(moveTime) + correctionBackLeft,
                  idealVelocity);
   }
+  scheduler.stop();
 
   enc_left_front_write(0);
   enc_right_front_write(0);
@@ -463,12 +436,10 @@ void motion_collect(float distance, float current_speed, float exit_speed){
 void motion_rotate(float angle) {
   float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS_ROTATE / 360;
   float idealLinearDistance, idealLinearVelocity;
-  float currentFrontRight, currentBackRight, currentFrontLeft, currentBackLeft;
-  float setpointFrontRight, setpointBackRight, setpointFrontLeft, setpointBackLeft;
   float correctionFrontRight, correctionBackRight, correctionFrontLeft, correctionBackLeft;
   float gyro_correction;
   float linearDistance = distancePerDegree * angle;
-  elapsedMicros moveTime;
+  uint32_t moveTime = 0;
 
   float current_speed = ((enc_left_front_velocity() + enc_left_back_velocity()) - (enc_right_front_velocity() + enc_right_back_velocity()))/4;
   
@@ -482,19 +453,26 @@ void motion_rotate(float angle) {
 
   Orientation& orientation = Orientation::getInstance();
 
-  PIDController left_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController left_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController wheels (KP_POSITION, KI_POSITION, KD_POSITION);
   PIDController gyro_PID (KP_GYRO, KI_GYRO, KD_GYRO);
 
+  // walls seen before the heading changes are on other sides of the robot
+  // afterwards
+  wallEvidence.reset();
+
   // zero encoders and clock before move
-  moveTime = 0;
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   // the right will always be the negative of the left in order to rotate on a point.
-  orientation.handler_update_ = false;
+  PERF_MOTION_TYPE('p');
   while (idealLinearDistance != linearDistance - drift) {
+    moveTime = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
+    PERF_BEGIN(orientation);
     orientation.update();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
     if (orientation.getHeading() > 180)
       break;
 
@@ -510,25 +488,15 @@ void motion_rotate(float angle) {
       freakOut("BAD3");
     }
 
-    currentFrontLeft = enc_left_front_extrapolate();
-    currentBackLeft = enc_left_back_extrapolate();
-    currentFrontRight = enc_right_front_extrapolate();
-    currentBackRight = enc_right_back_extrapolate();
-
-    setpointFrontLeft = idealLinearDistance + gyro_correction;
-    setpointBackLeft = idealLinearDistance + gyro_correction;
-    setpointFrontRight = -idealLinearDistance - gyro_correction;
-    setpointBackRight = -idealLinearDistance - gyro_correction;
-
-    correctionFrontLeft = left_front_PID.Calculate(currentFrontLeft,
-                                                   setpointFrontLeft);
-    correctionBackLeft = left_back_PID.Calculate(currentBackLeft,
-                                                 setpointBackLeft);
-    correctionFrontRight = right_front_PID.Calculate(currentFrontRight,
-                                                     setpointFrontRight);
-    correctionBackRight = right_back_PID.Calculate(currentBackRight,
-                                                   setpointBackRight);
+    wheels.update(idealLinearDistance + gyro_correction,
+                  -idealLinearDistance - gyro_correction);
+
+    correctionFrontLeft = wheels.getCorrection(WheelController::kLeftFront);
+    correctionBackLeft = wheels.getCorrection(WheelController::kLeftBack);
+    correctionFrontRight = wheels.getCorrection(WheelController::kRightFront);
+    correctionBackRight = wheels.getCorrection(WheelController::kRightBack);
 
+    PERF_BEGIN(motors);
     motor_lf.Set(motionCalc.idealAccel(moveTime) + correctionFrontLeft,
                  idealLinearVelocity);
     motor_rf.Set(-motionCalc.idealAccel(moveTime) + correctionFrontRight,
@@ -537,18 +505,17 @@ void motion_rotate(float angle) {
                  -idealLinearVelocity);
     motor_lb.Set(motionCalc.idealAccel(moveTime) + correctionBackLeft,
                  idealLinearVelocity);
+    PERF_END(motors, kPerfMotors);
     //run PID loop here.  new PID loop will add or subtract from a predetermined PWM value that was calculated with the motor curve and current ideal speed
 
     logger.logMotionType('p');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
   //menu.showInt(orientation.getHeading(),4);
-  uint8_t old_SREG = SREG;
-  noInterrupts();
   orientation.update();
   orientation.incrementHeading(-angle);
-  orientation.handler_update_ = true;
-  SREG = old_SREG;
 
   enc_left_front_write(0);
   enc_right_front_write(0);
@@ -570,7 +537,7 @@ void motion_gyro_rotate(float angle) {
   float idealLinearDistance, idealLinearVelocity;
   float rotation_correction;
   float linearDistance = distancePerDegree * angle;
-  elapsedMicros moveTime;
+  uint32_t moveTime = 0;
 
   float current_speed = (enc_left_front_velocity() + enc_left_back_velocity()
                          - enc_right_front_velocity() - enc_right_back_velocity()) / 4;
@@ -581,13 +548,24 @@ void motion_gyro_rotate(float angle) {
 
   PIDController rotation_PID (KP_ROTATION, KI_ROTATION, KD_ROTATION);
 
+  // walls seen before the heading changes are on other sides of the robot
+  // afterwards
+  wallEvidence.reset();
+
   // zero encoders and clock before move
-  moveTime = 0;
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   // the right will always be the negative of the left in order to rotate on a point.
   idealLinearDistance = 0;
+  PERF_MOTION_TYPE('g');
   while (idealLinearDistance != linearDistance) {
+    moveTime = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
+    PERF_BEGIN(orientation);
     orientation.update();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
 
     //Run sensor protocol here.  Sensor protocol should use encoder_left/right_write() to adjust for encoder error
     idealLinearDistance = motionCalc.idealDistance(moveTime);
@@ -604,6 +582,7 @@ void motion_gyro_rotate(float angle) {
 
     // run PID loop here.  new PID loop will add or subtract from a predetermined
     //   PWM value that was calculated with the motor curve and current ideal speed
+    PERF_BEGIN(motors);
     motor_lf.Set(motionCalc.idealAccel(moveTime) + rotation_correction,
                  idealLinearVelocity);
     motor_rf.Set(-motionCalc.idealAccel(moveTime) - rotation_correction,
@@ -612,10 +591,13 @@ void motion_gyro_rotate(float angle) {
                  -idealLinearVelocity);
     motor_lb.Set(motionCalc.idealAccel(moveTime) + rotation_correction,
                  idealLinearVelocity);
+    PERF_END(motors, kPerfMotors);
 
     logger.logMotionType('g');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
 
   enc_left_front_write(0);
   enc_right_front_write(0);
@@ -635,13 +617,11 @@ void motion_gyro_rotate(float angle) {
 
 void motion_corner(SweptTurnType turn_type, float speed, float size_scaling) {
   int sign = 1;
-  float currentFrontRight, currentFrontLeft, currentBackRight, currentBackLeft;
-  float setpointFrontRight, setpointFrontLeft, setpointBackRight, setpointBackLeft;
   float idealDistance;
   float rotation_offset;
   float gyro_correction;
   float time_scaling = 1;
-  int move_time_scaled = 0;
+  float table_time = 0;
   float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS / 360;
   float total_time;
   const SweptTurnProfile* turn_table = NULL;
@@ -699,30 +679,39 @@ void motion_corner(SweptTurnType turn_type, float speed, float size_scaling) {
 
   total_time = turn_table->getTotalTime();
 
-  elapsedMicros move_time;
+  // seconds of turn table time per microsecond of move time
+  time_scaling /= size_scaling * 1000000;
+
+  uint32_t move_time = 0;
 
-  PIDController left_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController left_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController wheels (KP_POSITION, KI_POSITION, KD_POSITION);
   PIDController gyro_PID (KP_GYRO, KI_GYRO, KD_GYRO);
 
-  // zero clock before move
-  move_time = 0;
+  // walls seen before the heading changes are on other sides of the robot
+  // afterwards
+  wallEvidence.reset();
 
-  orientation.handler_update_ = false;
+  // zero clock before move
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   // execute motion
-  while (move_time_scaled < total_time * 1000000) {
+  PERF_MOTION_TYPE('s');
+  while (table_time < total_time) {
+    move_time = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
     //Run sensor protocol here.  Sensor protocol should use encoder_left/right_write() to adjust for encoder error
+    PERF_BEGIN(orientation);
     orientation.update();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
+
+    table_time = move_time * time_scaling;
 
-    move_time_scaled = move_time * time_scaling / size_scaling;
-    
     idealDistance = move_time * speed / 1000;
 
     rotation_offset = MM_BETWEEN_WHEELS / 2
-        * sign * turn_table->getAngle(move_time_scaled / 1000000.0);
+        * sign * turn_table->getAngle(table_time);
 
     gyro_correction = gyro_PID.Calculate(
         orientation.getHeading() * distancePerDegree,
@@ -732,15 +721,8 @@ void motion_corner(SweptTurnType turn_type, float speed, float size_scaling) {
       freakOut("BAD5");
     }
 
-    currentFrontLeft = enc_left_front_extrapolate();
-    currentBackLeft = enc_left_back_extrapolate();
-    currentFrontRight = enc_right_front_extrapolate();
-    currentBackRight = enc_right_back_extrapolate();
-
-    setpointFrontLeft = idealDistance + rotation_offset + gyro_correction;
-    setpointBackLeft = idealDistance + rotation_offset + gyro_correction;
-    setpointFrontRight = idealDistance - rotation_offset - gyro_correction;
-    setpointBackRight = idealDistance - rotation_offset - gyro_correction;
+    wheels.update(idealDistance + rotation_offset + gyro_correction,
+                  idealDistance - rotation_offset - gyro_correction);
 
 //    motor_l.Set(distancePerDegree
 //        * time_scaling
@@ -753,25 +735,25 @@ void motion_corner(SweptTurnType turn_type, float speed, float size_scaling) {
 //        + right_PID.Calculate(errorFrontRight),
 //        enc_right_velocity());
    
-    motor_lf.Set(left_front_PID.Calculate(currentFrontLeft, setpointFrontLeft),
+    PERF_BEGIN(motors);
+    motor_lf.Set(wheels.getCorrection(WheelController::kLeftFront),
                  enc_left_front_velocity());
-    motor_rf.Set(right_front_PID.Calculate(currentFrontRight, setpointFrontRight),
+    motor_rf.Set(wheels.getCorrection(WheelController::kRightFront),
                  enc_right_front_velocity());
-    motor_rb.Set(right_back_PID.Calculate(currentBackRight, setpointBackRight),
+    motor_rb.Set(wheels.getCorrection(WheelController::kRightBack),
                  enc_right_back_velocity());
-    motor_lb.Set(left_back_PID.Calculate(currentBackLeft, setpointBackLeft),
+    motor_lb.Set(wheels.getCorrection(WheelController::kLeftBack),
                  enc_left_back_velocity());
+    PERF_END(motors, kPerfMotors);
 
     logger.logMotionType('s');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
 
-  uint8_t old_SREG = SREG;
-  noInterrupts();
   orientation.update();
   orientation.incrementHeading(-sign * turn_table->getTotalAngle());
-  orientation.handler_update_ = true;
-  SREG = old_SREG;
 
   enc_left_front_write(0);
   enc_right_front_write(0);
@@ -789,47 +771,48 @@ void motion_corner(SweptTurnType turn_type, float speed, float size_scaling) {
 }
 
 void motion_hold(unsigned int time) {
-  float errorFrontRight, errorFrontLeft, errorBackRight, errorBackLeft;
   float rightFrontOutput, leftFrontOutput, rightBackOutput, leftBackOutput;
-  elapsedMicros currentTime;
+  uint32_t currentTime = 0;
 
-  PIDController left_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_front_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController left_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
-  PIDController right_back_PID (KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController wheels (KP_POSITION, KI_POSITION, KD_POSITION);
 
-  currentTime = 0;
+  // the loop runs at CONTROL_LOOP_RATE_HZ
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   Orientation& orientation = Orientation::getInstance();
+  orientation.setStationary(true);
 
-  orientation.handler_update_ = false;
-
+  PERF_MOTION_TYPE('h');
   while (currentTime / 1000 < time) {
+    currentTime = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
+    PERF_BEGIN(orientation);
     orientation.update();
-    errorFrontLeft = enc_left_front_extrapolate();
-    errorFrontRight = enc_right_front_extrapolate();
-    errorBackLeft = enc_left_back_extrapolate();
-    errorBackRight = enc_right_back_extrapolate();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
+    wheels.update(0, 0);
 
-    leftFrontOutput = left_front_PID.Calculate(errorFrontLeft, 0);
-    rightFrontOutput = right_front_PID.Calculate(errorFrontRight, 0);
-    leftBackOutput = left_back_PID.Calculate(errorBackLeft, 0);
-    rightBackOutput = right_back_PID.Calculate(errorBackRight, 0);
+    leftFrontOutput = wheels.getCorrection(WheelController::kLeftFront);
+    rightFrontOutput = wheels.getCorrection(WheelController::kRightFront);
+    leftBackOutput = wheels.getCorrection(WheelController::kLeftBack);
+    rightBackOutput = wheels.getCorrection(WheelController::kRightBack);
 
+    PERF_BEGIN(motors);
     motor_lf.Set(leftFrontOutput, 0);
     motor_rf.Set(rightFrontOutput, 0);
     motor_rb.Set(rightBackOutput,0);
     motor_lb.Set(leftBackOutput,0);
+    PERF_END(motors, kPerfMotors);
 
     logger.logMotionType('h');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
 
-  uint8_t old_SREG = SREG;
-  noInterrupts();
   orientation.update();
-  orientation.handler_update_ = true;
-  SREG = old_SREG;
+  orientation.setStationary(false);
 
   motor_lf.Set(0, 0);
   motor_rf.Set(0, 0);
@@ -839,21 +822,27 @@ void motion_hold(unsigned int time) {
 
 void motion_hold_range(int setpoint, unsigned int time) {
   float rightFrontOutput, leftFrontOutput, rightBackOutput, leftBackOutput;
-  elapsedMicros currentTime;
+  uint32_t currentTime = 0;
 
   PIDController left_front_PID (KP_HOLD_RANGE, KI_HOLD_RANGE, KD_HOLD_RANGE);
   PIDController right_front_PID (KP_HOLD_RANGE, KI_HOLD_RANGE, KD_HOLD_RANGE);
   PIDController left_back_PID (KP_HOLD_RANGE, KI_HOLD_RANGE, KD_HOLD_RANGE);
   PIDController right_back_PID (KP_HOLD_RANGE, KI_HOLD_RANGE, KD_HOLD_RANGE);
 
-  currentTime = 0;
+  // the loop runs at CONTROL_LOOP_RATE_HZ
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  scheduler.start();
 
   Orientation& orientation = Orientation::getInstance();
 
-  orientation.handler_update_ = false;
-
+  PERF_MOTION_TYPE('r');
   while (currentTime / 1000 < time) {
+    currentTime = scheduler.waitForCycle();
+    PERF_BEGIN(cycle);
+    PERF_BEGIN(orientation);
     orientation.update();
+    PERF_END(orientation, kPerfOrientation);
+    Odometry::update();
 
     RangeSensors.frontLeftSensor.updateRange();
     RangeSensors.frontRightSensor.updateRange();
@@ -880,25 +869,25 @@ void motion_hold_range(int setpoint, unsigned int time) {
     if (rightBackOutput > 17) rightBackOutput = 17;
     if (rightBackOutput < -17) rightBackOutput = -17;
 
+    PERF_BEGIN(motors);
     motor_lf.Set(leftFrontOutput, 0);
     motor_rf.Set(rightFrontOutput, 0);
     motor_rb.Set(rightBackOutput, 0);
     motor_lb.Set(leftBackOutput, 0);
+    PERF_END(motors, kPerfMotors);
 
     logger.logMotionType('r');
     logger.nextCycle();
+    PERF_END(cycle, kPerfCycle);
   }
+  scheduler.stop();
 
   enc_left_front_write(0);
   enc_right_front_write(0);
   enc_left_back_write(0);
   enc_right_back_write(0);
 
-  uint8_t old_SREG = SREG;
-  noInterrupts();
   orientation.update();
-  orientation.handler_update_ = true;
-  SREG = old_SREG;
 
   motor_lf.Set(0, 0);
   motor_rf.Set(0, 0);
@@ -10,20 +10,28 @@
 #include "device/Motor.h"
 #include "device/Orientation.h"
 #include "device/PersistantStorage.h"
+#include "device/RangeAcquisition.h"
 #include "device/sensors_encoders.h"
 #include "device/RangeSensorContainer.h"
 #include "legacy_motion/motion.h"
+#include "motion/Odometry.h"
+#include "user_interaction/Benchmarks.h"
+#include "user_interaction/DrivetrainIdentification.h"
 #include "user_interaction/PlayMelodies.h"
 #include "user_interaction/Log.h"
 #include "user_interaction/Logger.h"
 #include "user_interaction/Menu.h"
+#include "user_interaction/PerfCounters.h"
+#include "user_interaction/Trace.h"
 #include "user_interaction/UserInterface.h"
 #include "Navigator.h"
+#include "SpeedEscalation.h"
 #include "conf.h"
 #include "data.h"
 #include "driver.h"
 #include "parser.h"
 #include "knows_best_path.h"
+#include "fastest_path.h"
 
 #define PATCH_VER_MESSAGE "Pitt Micromouse patched library version mismatch"
 static_assert(PITT_MICROMOUSE_I2CDEV_PATCH_VERSION == 1, PATCH_VER_MESSAGE);
@@ -38,6 +46,7 @@ static void autoKaos(bool);
 static void mazeClear();
 static void run();
 static void kaos();
+static SpeedRunSettings kaosSettings();
 static void turn();
 static void check();
 static void options();
@@ -45,6 +54,12 @@ static void clear();
 static void startDirection();
 static void speeds();
 static void targetCell();
+#if PERF_ENABLED
+static void perfDump();
+#endif
+#if TRACE_ENABLED
+static void traceDump();
+#endif
 
 void micromouse_main()
 {
@@ -67,6 +82,8 @@ void micromouse_main()
   digitalWrite(EMITTER_FRONT_LEFT_PIN, LOW);
   digitalWrite(EMITTER_FRONT_RIGHT_PIN, LOW);
 
+  RangeAcquisition::start();
+
   pinMode(BUTTON1_PIN, INPUT_PULLUP);
   pinMode(BUTTON2_PIN, INPUT_PULLUP);
 
@@ -75,10 +92,20 @@ void micromouse_main()
 
   Turnable::setDefaultInitialDirection(PersistantStorage::getDefaultDirection());
 
+  if (PersistantStorage::hasDrivetrainParameters()) {
+    Motor::setFeedforward(PersistantStorage::getDrivetrainStatic(),
+                          PersistantStorage::getDrivetrainVelocity(),
+                          PersistantStorage::getDrivetrainAccel());
+  }
+
   LOG_INIT();
 
   Orientation::getInstance().resetHeading();
 
+  // after everything else is set up, so that the flight recorder gets the
+  // memory left over
+  logger.begin();
+
  /* MenuItem items[] = {
     { "AUTO", autoMode },
     { "CLR", clear },
@@ -116,39 +143,32 @@ void autoMode()
     state = PersistantStorage::getState();
     runs = PersistantStorage::getNumRuns();
 
-    if (state == 1){
+    if (state != PersistantStorage::kRunStateIdle){
       waiter = true;
     }
 
-    if (state == 0){
-      if (!knowsBestPath(target_x, target_y)) {
-        autoRun(waiter, runs);
-      }
-      else if (runs<4){
-        //increase speed if run!=4
-        autoKaos(waiter);
-      }
-      else{
-        autoKaos(waiter);
-      }
+    // A speed run that never got back here crashed, whether freakOut caught
+    // it or the robot was reset by hand
+    if (state == PersistantStorage::kRunStateSpeedRun) {
+      SpeedEscalation::afterCrash();
     }
-    else if (state == 1)
-    {
-      if (!knowsBestPath(target_x, target_y)){
-        autoRun(waiter, runs);
-      }
-      else{
-        //reduce speeds back first
-        autoKaos(waiter);
-      }
-      PersistantStorage::setState(0);
+
+    if (!knowsBestPath(target_x, target_y)) {
+      autoRun(waiter, runs);
     }
-    else {}
+    else {
+      // autoKaos raises the speeds after every run that goes well
+      autoKaos(waiter);
+    }
+    PersistantStorage::setState(PersistantStorage::kRunStateIdle);
 
     waiter = false;
     runs--;
     PersistantStorage::setNumRuns(runs);
-    delay(1000);
+
+    // the robot sits still between runs, which is a good time to refine
+    // the gyro bias
+    Orientation::getInstance().waitStationary(1000);
   }
 }
 
@@ -160,7 +180,7 @@ void autoRun(bool wait, uint8_t num_runs) {
     gUserInterface.waitForHand();
   }
   if (num_runs != 5){
-    delay(1000);
+    orientation.waitStationary(1000);
   }
   else {
     startMelody();
@@ -171,10 +191,11 @@ void autoRun(bool wait, uint8_t num_runs) {
   enc_left_back_write(0);
   enc_right_back_write(0);
   orientation.resetHeading();
+  Odometry::resetToStart(PersistantStorage::getDefaultDirection());
 
   navigator.findBox(PersistantStorage::getTargetXLocation(),
                     PersistantStorage::getTargetYLocation());
-  delay(4000);
+  orientation.waitStationary(4000);
   navigator.findBox(0, 0);
 
   motion_rotate(180.0);
@@ -190,14 +211,13 @@ void autoKaos(bool wait) {
     ContinuousRobotDriver maze_load_driver;
     Maze<16, 16> maze;
     maze_load_driver.loadState(maze);
-    FloodFillPath<16, 16> flood_path (maze, 0, 0, target_x, target_y);
-    KnownPath<16, 16> known_path (maze, 0, 0, target_x, target_y, flood_path);
-    PathParser parser (&known_path);
+    FastestPath fastest_path (maze, 0, 0, target_x, target_y, kaosSettings());
+    PathParser parser (&fastest_path);
     KaosDriver driver;
 
     if (wait){
       gUserInterface.waitForHand();
-       delay(1000);
+      orientation.waitStationary(1000);
     }
 
     enc_left_front_write(0);
@@ -205,17 +225,26 @@ void autoKaos(bool wait) {
     enc_left_back_write(0);
     enc_right_back_write(0);
     orientation.resetHeading();
+    Odometry::resetToStart(PersistantStorage::getDefaultDirection());
 
     Compass8 start_dir = maze_load_driver.getDirIMadeThisPublic();
     Compass8 delta_dir = parser.getTotalRotation();
     Compass8 end_dir = (Compass8)(((int)start_dir + (int)delta_dir) % 8);
 
+    orientation.resetMaxForwardAccel();
+    orientation.resetMaxRadialAccel();
+    PersistantStorage::setState(PersistantStorage::kRunStateSpeedRun);
+
     driver.execute(parser.getMoveList());
+
+    PersistantStorage::setState(PersistantStorage::kRunStateIdle);
+    SpeedEscalation::afterRun(SpeedEscalation::measureLastRun());
+
     char buf[5];
 
     snprintf(buf, 5, "%02d%02d", parser.end_x, parser.end_y);
     gUserInterface.showString(buf, 4);
-       delay(4000);
+    orientation.waitStationary(4000);
 
 
     ContinuousRobotDriver other_driver(parser.end_x, parser.end_y, end_dir, false);
@@ -256,6 +285,7 @@ void run()
   enc_left_back_write(0);
   enc_right_back_write(0);
   orientation.resetHeading();
+  Odometry::resetToStart(PersistantStorage::getDefaultDirection());
 
   navigator.findBox(PersistantStorage::getTargetXLocation(),
           PersistantStorage::getTargetYLocation());
@@ -264,6 +294,18 @@ void run()
   stopMelody();
 }
 
+// Same speeds KaosDriver::execute will use
+SpeedRunSettings kaosSettings()
+{
+  SpeedRunSettings settings;
+  settings.forward_velocity = PersistantStorage::getKaosForwardVelocity();
+  settings.diag_velocity = PersistantStorage::getKaosDiagVelocity();
+  settings.turn_velocity = PersistantStorage::getKaosTurnVelocity();
+  settings.accel = PersistantStorage::getKaosAccel();
+  settings.decel = -PersistantStorage::getKaosDecel();
+  return settings;
+}
+
 void kaos()
 {
   uint8_t target_x = PersistantStorage::getTargetXLocation();
@@ -275,9 +317,8 @@ void kaos()
   ContinuousRobotDriver maze_load_driver;
   Maze<16, 16> maze;
   maze_load_driver.loadState(maze);
-  FloodFillPath<16, 16> flood_path (maze, 0, 0, target_x, target_y);
-  KnownPath<16, 16> known_path (maze, 0, 0, target_x, target_y, flood_path);
-  PathParser parser (&known_path);
+  FastestPath fastest_path (maze, 0, 0, target_x, target_y, kaosSettings());
+  PathParser parser (&fastest_path);
   KaosDriver driver;
 
   gUserInterface.waitForHand();
@@ -288,6 +329,7 @@ void kaos()
   enc_left_back_write(0);
   enc_right_back_write(0);
   orientation.resetHeading();
+  Odometry::resetToStart(PersistantStorage::getDefaultDirection());
 
   Compass8 start_dir = maze_load_driver.getDirIMadeThisPublic();
   Compass8 delta_dir = parser.getTotalRotation();
@@ -365,12 +407,44 @@ void options()
   { "SDIR", startDirection },
   { "SPDS", speeds },
   { "TRGT", targetCell },
+  { "SYID", identifyDrivetrain },
+  {
+    "FFCL", menuFunction {
+    PersistantStorage::clearDrivetrainParameters();
+    Motor::resetFeedforward();
+    }
+  },
+#if PERF_ENABLED
+  { "PERF", perfDump },
+  { "BNCH", runBenchmarks },
+#endif
+#if TRACE_ENABLED
+  { "TRCE", traceDump },
+#endif
   {}
   };
 
   Menu(items).run();
 }
 
+#if PERF_ENABLED
+// Writes out the loop timing histograms and starts new ones
+void perfDump()
+{
+  PERF_DUMP();
+  PERF_RESET();
+}
+#endif
+
+#if TRACE_ENABLED
+// Writes out the event timeline and starts a new one
+void traceDump()
+{
+  TRACE_DUMP();
+  TRACE_RESET();
+}
+#endif
+
 void clear(){
   RobotDriver driver;
   driver.clearState();
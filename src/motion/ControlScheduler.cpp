@@ -0,0 +1,111 @@
+#include <Arduino.h>
+#include "../conf.h"
+#include "../user_interaction/PerfCounters.h"
+#include "ControlScheduler.h"
+
+volatile uint32_t ControlScheduler::ticks_ = 0;
+
+void ControlScheduler::tickHandler()
+{
+  ticks_++;
+}
+
+ControlScheduler& ControlScheduler::getInstance()
+{
+  static ControlScheduler inst;
+  return inst;
+}
+
+void ControlScheduler::run(ControlLoop& loop)
+{
+  start();
+
+  while (!loop.done()) {
+    waitForCycle();
+
+    PERF_BEGIN(cycle);
+
+    PERF_BEGIN(sense);
+    loop.sense();
+    PERF_END(sense, kPerfSense);
+
+    PERF_BEGIN(estimate);
+    loop.estimate();
+    PERF_END(estimate, kPerfEstimate);
+
+    PERF_BEGIN(control);
+    loop.control();
+    PERF_END(control, kPerfControl);
+
+    PERF_BEGIN(actuate);
+    loop.actuate();
+    PERF_END(actuate, kPerfActuate);
+
+    PERF_END(cycle, kPerfCycle);
+  }
+
+  stop();
+}
+
+void ControlScheduler::start()
+{
+  last_tick_ = 0;
+  tick_ = 0;
+  step_ = 0;
+  cycles_ = 0;
+  overruns_ = 0;
+
+  ticks_ = 0;
+  timer_.begin(tickHandler, period_);
+}
+
+uint32_t ControlScheduler::waitForCycle()
+{
+  while (ticks_ == last_tick_) {
+  }
+
+  uint32_t tick = ticks_;
+
+  if (tick - last_tick_ > 1) {
+    overruns_ += tick - last_tick_ - 1;
+  }
+
+  step_ = (tick - last_tick_) * period_;
+  last_tick_ = tick;
+
+  // the first cycle runs at time 0
+  tick_ = tick - 1;
+  cycles_++;
+
+  return getTime();
+}
+
+void ControlScheduler::stop()
+{
+  timer_.end();
+}
+
+uint32_t ControlScheduler::getPeriod()
+{
+  return period_;
+}
+
+uint32_t ControlScheduler::getTime()
+{
+  return tick_ * period_;
+}
+
+uint32_t ControlScheduler::getTimeStep()
+{
+  return step_;
+}
+
+uint32_t ControlScheduler::getCycles()
+{
+  return cycles_;
+}
+
+uint32_t ControlScheduler::getOverruns()
+{
+  return overruns_;
+}
@@ -0,0 +1,107 @@
+#ifndef MICROMOUSE_CONTROL_SCHEDULER_H_
+#define MICROMOUSE_CONTROL_SCHEDULER_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// One control loop, split into the phases that the ControlScheduler runs once
+// per cycle in this order
+class ControlLoop
+{
+  public:
+    // read encoders, gyro and range sensors
+    virtual void sense() = 0;
+
+    // work out where the robot is and where it should be
+    virtual void estimate() = 0;
+
+    // run the controllers
+    virtual void control() = 0;
+
+    // write the motor outputs
+    virtual void actuate() = 0;
+
+    // true once the loop has nothing left to do
+    virtual bool done() = 0;
+};
+
+// Runs a ControlLoop at a fixed rate set by a hardware timer
+//
+// The timer interrupt only counts ticks. The phases run in the foreground,
+// one cycle per tick, so they are free to use I2C and busy-wait on sensors.
+// If a cycle takes longer than one period, the ticks it covered are counted
+// as overruns and the next cycle starts right away, so the loop time returned
+// by getTime() never falls behind real time.
+//
+//   ControlScheduler& scheduler = ControlScheduler::getInstance();
+//   scheduler.run(some_control_loop);
+//   LOG("%lu overruns\n", scheduler.getOverruns());
+//
+// Loops that are written out inline, like the search motions in motion.cpp,
+// pace themselves with start(), waitForCycle() and stop() instead.
+//
+//   scheduler.start();
+//   while (move_time < total_time) {
+//     move_time = scheduler.waitForCycle();
+//     ...
+//   }
+//   scheduler.stop();
+//
+class ControlScheduler
+{
+  private:
+    ControlScheduler() = default;
+
+    static void tickHandler();
+
+    static volatile uint32_t ticks_;
+
+    IntervalTimer timer_;
+
+    uint32_t period_ = 1000000 / CONTROL_LOOP_RATE_HZ;
+    uint32_t last_tick_ = 0;
+    uint32_t tick_ = 0;
+    uint32_t step_ = 0;
+    uint32_t cycles_ = 0;
+    uint32_t overruns_ = 0;
+
+  public:
+    static ControlScheduler& getInstance();
+
+    // Runs loop every period until loop.done() returns true
+    void run(ControlLoop& loop);
+
+    // Starts the timer and the loop clock for a loop written inline
+    void start();
+
+    // Waits for the next tick and returns the time of the cycle it starts,
+    // the same as getTime()
+    uint32_t waitForCycle();
+
+    // Stops the timer
+    void stop();
+
+    // Returns the period of the loop in microseconds
+    uint32_t getPeriod();
+
+    // Returns the time of the current cycle in microseconds since run() was
+    // called. This advances by exactly one period per tick.
+    uint32_t getTime();
+
+    // Returns the time in microseconds between the start of the last cycle
+    // and the current one. This is one period, plus one period for every
+    // tick that was missed in between. The first cycle counts from one
+    // period before time 0.
+    uint32_t getTimeStep();
+
+    // Returns the number of cycles that were run in the last call to run()
+    uint32_t getCycles();
+
+    // Returns the number of ticks that were missed in the last call to run()
+    // because a cycle took too long
+    uint32_t getOverruns();
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include <cmath>
+
+#include "DrivetrainFit.h"
+
+// Fewest samples solve() will fit to
+static const size_t kMinSamples = 20;
+
+// Smallest pivot solve() will divide by, relative to the largest diagonal
+static const double kMinPivot = 1e-9;
+
+DrivetrainFit::DrivetrainFit(unsigned long sample_period, float min_velocity)
+    : dt_(sample_period / 1000000.0), min_velocity_(min_velocity)
+{
+  reset();
+}
+
+void DrivetrainFit::reset()
+{
+  for (size_t i = 0; i < kNumParameters; i++) {
+    for (size_t j = 0; j < kNumParameters; j++) {
+      ata_[i][j] = 0;
+    }
+    atb_[i] = 0;
+  }
+  btb_ = 0;
+  count_ = 0;
+
+  restart();
+}
+
+void DrivetrainFit::restart()
+{
+  history_ = 0;
+  previous_volts_ = 0;
+  previous_velocity_ = 0;
+  older_velocity_ = 0;
+}
+
+void DrivetrainFit::accumulate(double volts, double velocity, double accel)
+{
+  if (std::fabs(velocity) < min_velocity_)
+    return;
+
+  double row[kNumParameters] = {
+    velocity > 0 ? 1.0 : -1.0, velocity, accel
+  };
+
+  for (size_t i = 0; i < kNumParameters; i++) {
+    for (size_t j = 0; j < kNumParameters; j++) {
+      ata_[i][j] += row[i] * row[j];
+    }
+    atb_[i] += row[i] * volts;
+  }
+  btb_ += volts * volts;
+  count_++;
+}
+
+void DrivetrainFit::addSample(float volts, float velocity)
+{
+  // the previous sample now has a neighbour on both sides
+  if (history_ >= 2) {
+    accumulate(previous_volts_, previous_velocity_,
+               (velocity - older_velocity_) / (2 * dt_));
+  } else {
+    history_++;
+  }
+
+  older_velocity_ = previous_velocity_;
+  previous_velocity_ = velocity;
+  previous_volts_ = volts;
+}
+
+size_t DrivetrainFit::count() const
+{
+  return count_;
+}
+
+bool DrivetrainFit::solve(float* static_volts, float* volts_per_velocity,
+                          float* volts_per_accel, float* rms_error) const
+{
+  if (count_ < kMinSamples)
+    return false;
+
+  // Gaussian elimination with partial pivoting on a copy of the normal
+  // equations
+  double m[kNumParameters][kNumParameters + 1];
+  double scale = 0;
+  for (size_t i = 0; i < kNumParameters; i++) {
+    for (size_t j = 0; j < kNumParameters; j++) {
+      m[i][j] = ata_[i][j];
+    }
+    m[i][kNumParameters] = atb_[i];
+    scale = std::fmax(scale, ata_[i][i]);
+  }
+
+  for (size_t col = 0; col < kNumParameters; col++) {
+    size_t pivot = col;
+    for (size_t row = col + 1; row < kNumParameters; row++) {
+      if (std::fabs(m[row][col]) > std::fabs(m[pivot][col]))
+        pivot = row;
+    }
+
+    if (std::fabs(m[pivot][col]) <= kMinPivot * scale)
+      return false;
+
+    for (size_t j = 0; j <= kNumParameters; j++) {
+      double temp = m[col][j];
+      m[col][j] = m[pivot][j];
+      m[pivot][j] = temp;
+    }
+
+    for (size_t row = col + 1; row < kNumParameters; row++) {
+      double factor = m[row][col] / m[col][col];
+      for (size_t j = col; j <= kNumParameters; j++) {
+        m[row][j] -= factor * m[col][j];
+      }
+    }
+  }
+
+  double x[kNumParameters];
+  for (size_t i = kNumParameters; i-- > 0;) {
+    double sum = m[i][kNumParameters];
+    for (size_t j = i + 1; j < kNumParameters; j++) {
+      sum -= m[i][j] * x[j];
+    }
+    x[i] = sum / m[i][i];
+  }
+
+  *static_volts = x[0];
+  *volts_per_velocity = x[1];
+  *volts_per_accel = x[2];
+
+  // |Ax - b|^2 = x^T A^T A x - 2 x^T A^T b + b^T b
+  if (rms_error != NULL) {
+    double squared = btb_;
+    for (size_t i = 0; i < kNumParameters; i++) {
+      squared -= 2 * x[i] * atb_[i];
+      for (size_t j = 0; j < kNumParameters; j++) {
+        squared += x[i] * ata_[i][j] * x[j];
+      }
+    }
+    *rms_error = std::sqrt(std::fmax(squared, 0.0) / count_);
+  }
+
+  return true;
+}
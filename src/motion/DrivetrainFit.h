@@ -0,0 +1,73 @@
+#ifndef MICROMOUSE_DRIVETRAIN_FIT_H_
+#define MICROMOUSE_DRIVETRAIN_FIT_H_
+
+#include <cstddef>
+
+// Least squares fit of the motor feedforward to a drivetrain step response
+//
+// Fits the voltage applied to each motor to
+//
+//   static_volts * sign(velocity) + volts_per_velocity * velocity
+//     + volts_per_accel * accel
+//
+// which is the model Motor::Set drives with. Samples are given at a fixed
+// period, and the acceleration of each is the centered difference of its
+// neighbours' velocities. Call restart() whenever the samples stop being
+// contiguous, such as between steps. Samples slower than min_velocity are
+// left out, since the static friction there is not the sliding friction the
+// model has.
+//
+// Only sums are kept, so there is no limit on the number of samples. Nothing
+// here depends on the robot, so the same fit runs on a PC against a log.
+//
+//   DrivetrainFit fit(SYSID_SAMPLE_PERIOD, SYSID_MIN_VELOCITY);
+//   while (driving) {
+//     fit.addSample(duty * Battery::getVoltage(), velocity);
+//   }
+//   float ks, kv, ka;
+//   if (fit.solve(&ks, &kv, &ka)) Motor::setFeedforward(ks, kv, ka);
+//
+class DrivetrainFit
+{
+  private:
+    static const size_t kNumParameters = 3;
+
+    const double dt_;
+    const double min_velocity_;
+
+    // the two previous samples, needed for the centered difference
+    size_t history_;
+    double previous_volts_, previous_velocity_, older_velocity_;
+
+    // normal equations, A^T A and A^T b, and b^T b for the residual
+    double ata_[kNumParameters][kNumParameters];
+    double atb_[kNumParameters];
+    double btb_;
+    size_t count_;
+
+    void accumulate(double volts, double velocity, double accel);
+
+  public:
+    // sample_period in us, min_velocity in m/s
+    DrivetrainFit(unsigned long sample_period, float min_velocity);
+
+    // Forgets all samples
+    void reset();
+
+    // Starts a new run of contiguous samples, keeping the sums
+    void restart();
+
+    // volts applied to one motor, and the velocity in m/s at the same time
+    void addSample(float volts, float velocity);
+
+    // Number of samples used so far
+    size_t count() const;
+
+    // Solves for the parameters, returns false if the samples do not pin
+    // them all down. The root mean square error of the fit in volts is
+    // written to rms_error when it is not null.
+    bool solve(float* static_volts, float* volts_per_velocity,
+               float* volts_per_accel, float* rms_error = NULL) const;
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef MICROMOUSE_FIXED_H_
+#define MICROMOUSE_FIXED_H_
+
+#ifdef COMPILE_FOR_PC
+#include <cstdint>
+#else
+#include <Arduino.h>
+#endif
+
+// Q-format fixed point numbers for the control path
+//
+// The Teensy has no FPU, so every float operation is a library call. A
+// Fixed<16> holds a signed number with 16 fractional bits in an int32_t, for
+// a range of +/-32768 with a resolution of 1/65536, and its arithmetic is a
+// handful of integer instructions. Every operation saturates at the ends of
+// the range instead of wrapping around.
+//
+// Conversions to and from float still go through the float library, so keep
+// values in fixed point for as much of a loop as possible.
+//
+//   Q16 error = Q16::fromFloat(current) - Q16::fromFloat(target);
+//   Q16 output = error * Q16::fromFloat(3.5);
+//   float result = output.toFloat();
+//
+
+namespace fixed {
+
+static inline int32_t saturate(int64_t value)
+{
+  if (value > INT32_MAX)
+    return INT32_MAX;
+  if (value < INT32_MIN)
+    return INT32_MIN;
+  return value;
+}
+
+static inline int32_t add(int32_t a, int32_t b)
+{
+#if defined(__ARM_ARCH_7EM__)
+  int32_t result;
+  asm ("qadd %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+  return result;
+#else
+  return saturate((int64_t) a + b);
+#endif
+}
+
+static inline int32_t subtract(int32_t a, int32_t b)
+{
+#if defined(__ARM_ARCH_7EM__)
+  int32_t result;
+  asm ("qsub %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+  return result;
+#else
+  return saturate((int64_t) a - b);
+#endif
+}
+
+// Rounds to nearest, halves away from zero. Saturates at +/-2^62.
+static inline int64_t roundedShiftWide(int64_t value, int shift)
+{
+  if (shift <= 0) {
+    int64_t limit = ((int64_t) 1 << 62) >> -shift;
+    if (value > limit)
+      return (int64_t) 1 << 62;
+    if (value < -limit)
+      return -((int64_t) 1 << 62);
+    return value * ((int64_t) 1 << -shift);
+  }
+
+  int64_t half = (int64_t) 1 << (shift - 1);
+  if (value < 0)
+    return -((-value + half) >> shift);
+  return (value + half) >> shift;
+}
+
+static inline int32_t roundedShift(int64_t value, int shift)
+{
+  return saturate(roundedShiftWide(value, shift));
+}
+
+}
+
+template <int kFracBits>
+class Fixed
+{
+  private:
+    int32_t raw_;
+
+    explicit constexpr Fixed(int32_t raw) : raw_(raw) {}
+
+  public:
+    static const int32_t kOne = (int32_t) 1 << kFracBits;
+
+    constexpr Fixed() : raw_(0) {}
+
+    static constexpr Fixed fromRaw(int32_t raw)
+    {
+      return Fixed(raw);
+    }
+
+    static constexpr Fixed fromFloat(float value)
+    {
+      return Fixed(value * kOne >= 2147483647.0f ? INT32_MAX
+                   : value * kOne <= -2147483648.0f ? INT32_MIN
+                   : (int32_t) (value * kOne + (value < 0 ? -0.5f : 0.5f)));
+    }
+
+    static Fixed fromInt(int32_t value)
+    {
+      return Fixed(fixed::saturate((int64_t) value << kFracBits));
+    }
+
+    constexpr int32_t raw() const { return raw_; }
+
+    float toFloat() const { return (float) raw_ / kOne; }
+
+    // rounds toward negative infinity
+    int32_t toInt() const { return raw_ >> kFracBits; }
+
+    int32_t toRoundedInt() const { return fixed::roundedShift(raw_, kFracBits); }
+
+    // Converts to a different number of fractional bits
+    template <int kOtherFracBits>
+    Fixed<kOtherFracBits> convert() const
+    {
+      return Fixed<kOtherFracBits>::fromRaw(
+          fixed::roundedShift(raw_, kFracBits - kOtherFracBits));
+    }
+
+    Fixed operator+(Fixed other) const
+    {
+      return Fixed(fixed::add(raw_, other.raw_));
+    }
+
+    Fixed operator-(Fixed other) const
+    {
+      return Fixed(fixed::subtract(raw_, other.raw_));
+    }
+
+    Fixed operator-() const
+    {
+      return Fixed(fixed::subtract(0, raw_));
+    }
+
+    Fixed operator*(Fixed other) const
+    {
+      return Fixed(fixed::roundedShift((int64_t) raw_ * other.raw_,
+                                       kFracBits));
+    }
+
+    Fixed operator*(int32_t factor) const
+    {
+      return Fixed(fixed::saturate((int64_t) raw_ * factor));
+    }
+
+    // Division needs a 64 bit divide, which is also a library call. Divide
+    // by an int where possible.
+    Fixed operator/(Fixed other) const
+    {
+      if (other.raw_ == 0)
+        return Fixed(raw_ < 0 ? INT32_MIN : INT32_MAX);
+      return Fixed(fixed::saturate(((int64_t) raw_ << kFracBits)
+                                   / other.raw_));
+    }
+
+    Fixed operator/(int32_t divisor) const
+    {
+      if (divisor == 0)
+        return Fixed(raw_ < 0 ? INT32_MIN : INT32_MAX);
+      return Fixed(raw_ / divisor);
+    }
+
+    Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    Fixed& operator*=(Fixed other) { return *this = *this * other; }
+
+    bool operator<(Fixed other) const { return raw_ < other.raw_; }
+    bool operator>(Fixed other) const { return raw_ > other.raw_; }
+    bool operator<=(Fixed other) const { return raw_ <= other.raw_; }
+    bool operator>=(Fixed other) const { return raw_ >= other.raw_; }
+    bool operator==(Fixed other) const { return raw_ == other.raw_; }
+    bool operator!=(Fixed other) const { return raw_ != other.raw_; }
+
+    Fixed absolute() const { return raw_ < 0 ? -*this : *this; }
+
+    Fixed clamp(Fixed low, Fixed high) const
+    {
+      return raw_ < low.raw_ ? low : raw_ > high.raw_ ? high : *this;
+    }
+};
+
+typedef Fixed<16> Q16;
+
+// A constant factor of any size, for gains that Q16 cannot hold precisely
+//
+// Stored as a 23 bit mantissa and a shift, so factors from about 1e-9 to 1e9
+// keep full precision. Applying one is a 64 bit multiply and a shift. The
+// input is clipped to +/-2^40 so the product can not overflow, which leaves
+// room for a Q16 value times a time step in microseconds.
+//
+//   static const FixedMultiplier kGain(0.0000008);
+//   Q16 output = kGain.apply(error);
+//   Q16 integral = kGain.apply((int64_t) error.raw() * dt);
+//
+class FixedMultiplier
+{
+  private:
+    static const int kMantissaBits = 23;
+    static const int64_t kMaxInput = (int64_t) 1 << 40;
+
+    int32_t mantissa_;
+    int shift_;
+
+  public:
+    FixedMultiplier() : mantissa_(0), shift_(0) {}
+
+    explicit FixedMultiplier(float factor) : mantissa_(0), shift_(0)
+    {
+      if (factor == 0)
+        return;
+
+      float magnitude = factor < 0 ? -factor : factor;
+
+      // scale the factor up until the mantissa is full
+      shift_ = 0;
+      while (magnitude < (1L << (kMantissaBits - 1)) && shift_ < 62) {
+        magnitude *= 2;
+        shift_++;
+      }
+      while (magnitude >= (1L << kMantissaBits) && shift_ > -31) {
+        magnitude /= 2;
+        shift_--;
+      }
+
+      mantissa_ = (int32_t) (magnitude + 0.5f);
+      if (factor < 0)
+        mantissa_ = -mantissa_;
+    }
+
+    // Returns raw * factor, in the same format as raw, without saturating
+    // to 32 bits
+    int64_t applyWide(int64_t raw) const
+    {
+      if (raw > kMaxInput) {
+        raw = kMaxInput;
+      } else if (raw < -kMaxInput) {
+        raw = -kMaxInput;
+      }
+
+      return fixed::roundedShiftWide(raw * mantissa_, shift_);
+    }
+
+    // Returns raw * factor, in the same format as raw
+    int32_t apply(int64_t raw) const
+    {
+      return fixed::saturate(applyWide(raw));
+    }
+
+    template <int kFracBits>
+    Fixed<kFracBits> apply(Fixed<kFracBits> value) const
+    {
+      return Fixed<kFracBits>::fromRaw(apply((int64_t) value.raw()));
+    }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef MICROMOUSE_KAOS_GEOMETRY_H_
+#define MICROMOUSE_KAOS_GEOMETRY_H_
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Sizes of the segments that KaosDriver::execute() gives the executor
+//
+// estimateRunTime() prices a path from the same numbers, so that the path it
+// picks is timed on the segments the robot will actually drive. Corner
+// scalings are passed to TrajectoryExecutor::addCorner().
+//
+//   executor.addCorner(kLeftTurn45, speed, KaosGeometry::kCorner45Scaling);
+//
+class KaosGeometry
+{
+  public:
+    static constexpr float kSqrt2 = 1.41421356237;
+
+    // 90 degree turn from one diagonal to the next
+    static constexpr float kDiagonal90Scaling = 1 / kSqrt2;
+
+    // 45 degree turn onto or off of a diagonal
+    static constexpr float kCorner45Scaling = kSqrt2 / 2 / (kSqrt2 - 1);
+
+    // 135 degree turn onto or off of a diagonal, with the straight on the
+    // orthogonal side of it
+    static constexpr float kCorner135Scaling =
+        TURN_135_SCALING * (3 * kSqrt2 / 2 / (kSqrt2 + 1));
+    static constexpr float kCorner135Straight =
+        MM_PER_BLOCK * (.75 - .75 / (kSqrt2 + 1)); // mm
+
+    // one block along a diagonal
+    static constexpr float kDiagonalBlock = MM_PER_BLOCK * 0.707; // mm
+
+    // forward past the end of the path and back again, to stop square
+    static constexpr float kEndStraight = MM_PER_BLOCK / 6; // mm
+
+  private:
+    KaosGeometry();
+};
+
+#endif
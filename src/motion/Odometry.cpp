@@ -0,0 +1,228 @@
+#include <Arduino.h>
+#include <cmath>
+
+// Dependencies within Micromouse
+#include "../device/Orientation.h"
+#include "../device/RangeSensorContainer.h"
+#include "../device/sensors_encoders.h"
+#include "../conf.h"
+#include "Odometry.h"
+
+// Unit vectors of north, east, south and west, in that order
+static const int kForwardX[] = { 0, 1, 0, -1 };
+static const int kForwardY[] = { 1, 0, -1, 0 };
+
+// Uncertainty of the start position
+static const float kStartPositionVariance = 4; // mm^2
+static const float kStartHeadingVariance = 1; // deg^2
+
+PoseEstimator Odometry::pose_;
+float Odometry::last_odometer_ = 0;
+float Odometry::last_rotation_ = 0;
+uint32_t Odometry::last_wall_time_ = 0;
+WallEdgeDetector Odometry::left_edge_;
+WallEdgeDetector Odometry::right_edge_;
+int Odometry::edge_quadrant_ = 0;
+bool Odometry::has_post_ = false;
+float Odometry::post_odometer_ = 0;
+float Odometry::along_correction_ = 0;
+
+float Odometry::nearestHeading(float step)
+{
+  return step * roundf(pose_.getHeading() / step);
+}
+
+void Odometry::observeEdge(WallEdgeDetector& detector, int range,
+                           float forward_x, float forward_y)
+{
+  float along = forward_x * pose_.getX() + forward_y * pose_.getY();
+  float edge_along;
+  WallEdgeDetector::Edge edge = detector.update(range, along, &edge_along);
+  if (edge == WallEdgeDetector::kNoEdge)
+    return;
+
+  // the sensor leaves a wall past the far side of its post, and meets one at
+  // the near side
+  float seen = edge_along + POST_EDGE_LOOKAHEAD;
+  seen += edge == WallEdgeDetector::kWallEnds ? POST_HALF_WIDTH
+                                              : -POST_HALF_WIDTH;
+  float post = MM_PER_BLOCK * (roundf(seen / MM_PER_BLOCK - 0.5) + 0.5);
+
+  const float h[] = { forward_x, forward_y, 0 };
+  if (pose_.observe(h, along + post - seen, POSE_POST_VARIANCE)) {
+    has_post_ = true;
+    post_odometer_ = enc_odometer();
+  }
+}
+
+void Odometry::resetEdges()
+{
+  left_edge_.reset();
+  right_edge_.reset();
+  has_post_ = false;
+}
+
+void Odometry::reset(float x, float y, float heading)
+{
+  pose_.reset(x, y, heading, kStartPositionVariance, kStartHeadingVariance);
+  last_odometer_ = enc_odometer();
+  last_rotation_ = Orientation::getInstance().getTotalRotation();
+  resetEdges();
+  along_correction_ = 0;
+}
+
+void Odometry::resetToStart(Compass8 direction)
+{
+  int quadrant = direction / 2;
+  reset(-kForwardX[quadrant] * MM_FROM_BACK_TO_CENTER,
+        -kForwardY[quadrant] * MM_FROM_BACK_TO_CENTER, direction * 45);
+}
+
+void Odometry::update()
+{
+  float odometer = enc_odometer();
+  float rotation = Orientation::getInstance().getTotalRotation();
+
+  pose_.predict(odometer - last_odometer_, rotation - last_rotation_);
+
+  last_odometer_ = odometer;
+  last_rotation_ = rotation;
+}
+
+void Odometry::observeWalls()
+{
+  uint32_t reading_time = RangeSensors.diagLeftSensor.getReadingTime();
+  if (reading_time == last_wall_time_)
+    return;
+  last_wall_time_ = reading_time;
+
+  // the range sensors only make sense square to the maze
+  float cardinal = nearestHeading(90);
+  if (fabs(pose_.getHeading() - cardinal) > POSE_WALL_HEADING_TOLERANCE) {
+    resetEdges();
+    return;
+  }
+
+  int quadrant = ((int) (cardinal / 90) % 4 + 4) % 4;
+  float forward_x = kForwardX[quadrant];
+  float forward_y = kForwardY[quadrant];
+  float along_before = forward_x * pose_.getX() + forward_y * pose_.getY();
+
+  // corrections along another heading mean nothing to the encoders now
+  if (quadrant != edge_quadrant_) {
+    edge_quadrant_ = quadrant;
+    resetEdges();
+    along_correction_ = 0;
+  }
+
+  // right hand side of the heading
+  float right_x = forward_y;
+  float right_y = -forward_x;
+
+  int front_range = min(RangeSensors.frontLeftSensor.getRange(),
+                        RangeSensors.frontRightSensor.getRange());
+
+  // offset from the middle of the corridor, positive to the left
+  if ((RangeSensors.isWall(left) || RangeSensors.isWall(right))
+      && front_range >= RANGE_DIAG_CUTOFF_FRONT_DISTANCE) {
+    float lateral = right_x * pose_.getX() + right_y * pose_.getY();
+    float center = MM_PER_BLOCK * roundf(lateral / MM_PER_BLOCK);
+    float measured = center - RangeSensors.errorFromCenter()
+                              * POSE_LATERAL_PER_DIAG_RANGE;
+    const float h[] = { right_x, right_y, 0 };
+    pose_.observe(h, measured, POSE_SIDE_WALL_VARIANCE);
+  }
+
+  // distance to the wall at the far side of the current cell
+  if (RangeSensors.isWall(front) && front_range < POSE_FRONT_RANGE_MAX) {
+    float along = forward_x * pose_.getX() + forward_y * pose_.getY();
+    float wall = MM_PER_BLOCK * (roundf(along / MM_PER_BLOCK) + 0.5);
+    float measured = wall - MM_PER_BLOCK / 2 + POSE_FRONT_RANGE_AT_CENTER
+                     - front_range;
+    const float h[] = { forward_x, forward_y, 0 };
+    pose_.observe(h, measured, POSE_FRONT_WALL_VARIANCE);
+  }
+
+  // the diagonal sensors see the front wall when it is close
+  if (front_range >= RANGE_DIAG_CUTOFF_FRONT_DISTANCE) {
+    observeEdge(left_edge_, RangeSensors.diagLeftSensor.getRange(),
+                forward_x, forward_y);
+    observeEdge(right_edge_, RangeSensors.diagRightSensor.getRange(),
+                forward_x, forward_y);
+  } else {
+    // keep has_post_, the posts seen so far are still good for a turn
+    left_edge_.reset();
+    right_edge_.reset();
+  }
+
+  along_correction_ += forward_x * pose_.getX() + forward_y * pose_.getY()
+                       - along_before;
+}
+
+float Odometry::shiftEncoders()
+{
+  float shift = 0;
+
+  if (along_correction_ >= MM_PER_STEP) {
+    shift = MM_PER_STEP;
+  } else if (along_correction_ <= -MM_PER_STEP) {
+    shift = -MM_PER_STEP;
+  }
+
+  if (shift != 0) {
+    enc_shift(shift);
+    along_correction_ -= shift;
+  }
+
+  return shift;
+}
+
+bool Odometry::distanceToCellEdge(float* distance)
+{
+  if (!has_post_ || enc_odometer() - post_odometer_ > TURN_ENTRY_POST_RANGE)
+    return false;
+
+  float cardinal = nearestHeading(90);
+  int quadrant = ((int) (cardinal / 90) % 4 + 4) % 4;
+  if (quadrant != edge_quadrant_)
+    return false;
+
+  float along = kForwardX[quadrant] * pose_.getX()
+                + kForwardY[quadrant] * pose_.getY();
+  float edge = MM_PER_BLOCK * (roundf(along / MM_PER_BLOCK - 0.5) + 0.5);
+  *distance = edge - along;
+
+  along_correction_ = 0;
+  return true;
+}
+
+void Odometry::observeAligned()
+{
+  pose_.observeHeading(nearestHeading(90), POSE_ALIGNED_VARIANCE);
+
+  RangeSensors.updateReadings();
+  observeWalls();
+
+  // the robot is not on a straight, and the next motion starts from the
+  // encoders as they are
+  resetEdges();
+  along_correction_ = 0;
+}
+
+void Odometry::alignHeading()
+{
+  Orientation& orientation = Orientation::getInstance();
+  float relative = pose_.getHeading() - nearestHeading(45);
+  orientation.incrementHeading(relative - orientation.getHeading());
+}
+
+bool Odometry::isConfident()
+{
+  return pose_.getPositionError() < POSE_CONFIDENT_POSITION
+         && pose_.getHeadingError() < POSE_CONFIDENT_HEADING;
+}
+
+const PoseEstimator& Odometry::getPose()
+{
+  return pose_;
+}
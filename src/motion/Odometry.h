@@ -0,0 +1,117 @@
+#ifndef MICROMOUSE_ODOMETRY_H_
+#define MICROMOUSE_ODOMETRY_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../data.h"
+#include "PoseEstimator.h"
+#include "WallEdgeDetector.h"
+
+// Continuous position and heading of the robot in the maze
+//
+// Keeps a PoseEstimator up to date from the sensors. update() predicts with
+// the distance from enc_odometer() and the angle from
+// Orientation::getTotalRotation(), neither of which is reset between motion
+// primitives, so it can be called from any control loop at any rate.
+// observeWalls() corrects the estimate with the side and front range sensors
+// when the robot is close to square with the maze, and with the posts where
+// side walls start and end, found by a WallEdgeDetector on each diagonal
+// sensor. What that moves the estimate along the heading is handed back to the
+// encoders a count at a time by shiftEncoders(), so that straights end where
+// the posts say they should. Before a turn, distanceToCellEdge() gives the
+// drivers the distance to the cell edge from the last post instead.
+//
+// With the estimate tight enough, isConfident(), the drivers skip holding
+// against walls to realign, and alignHeading() gives the motion code the
+// corrected heading instead.
+//
+//   Odometry::resetToStart(kNorth);
+//   while (moving) {
+//     Odometry::update();
+//     RangeSensors.updateReadings();
+//     Odometry::observeWalls();
+//     float shift = Odometry::shiftEncoders();
+//     wheels.shift(shift, shift);
+//   }
+//
+class Odometry
+{
+  private:
+    static PoseEstimator pose_;
+    static float last_odometer_;
+    static float last_rotation_;
+
+    // time of the range reading last used, so each is only used once
+    static uint32_t last_wall_time_;
+
+    // posts seen along the current straight, facing edge_quadrant_
+    static WallEdgeDetector left_edge_, right_edge_;
+    static int edge_quadrant_;
+
+    // enc_odometer() at the last post used, if any was along this straight
+    static bool has_post_;
+    static float post_odometer_;
+
+    // mm the estimate has moved along the heading that the encoders have not
+    static float along_correction_;
+
+    // Returns the multiple of step degrees closest to the estimated heading
+    static float nearestHeading(float step);
+
+    // Corrects the position along the heading if the detector found a post
+    static void observeEdge(WallEdgeDetector& detector, int range,
+                            float forward_x, float forward_y);
+
+    // Forgets the posts seen along the current straight
+    static void resetEdges();
+
+  public:
+    // Sets the pose, in mm from the center of cell (0, 0) and degrees
+    // clockwise from north
+    static void reset(float x, float y, float heading);
+
+    // Sets the pose to the start position, backed up against the wall behind
+    // cell (0, 0) facing direction
+    static void resetToStart(Compass8 direction);
+
+    // Moves the estimate by what the wheels and gyro measured since the last
+    // update
+    static void update();
+
+    // Corrects the estimate with the range readings, if they are new since
+    // the last call. Call after RangeSensors.updateReadings().
+    static void observeWalls();
+
+    // Moves the encoders by up to one count towards where observeWalls() has
+    // put the robot along the heading, and returns how far they moved in mm.
+    // Call once per cycle on straights, and pass what it returns on to
+    // WheelController::shift().
+    static float shiftEncoders();
+
+    // If a post was seen within TURN_ENTRY_POST_RANGE along the current
+    // heading, writes the distance from the robot to the nearest cell edge
+    // along the heading, positive ahead, and returns true. The corrections
+    // not yet given to the encoders are dropped, as the distance includes
+    // them.
+    static bool distanceToCellEdge(float* distance);
+
+    // Corrects the heading after the robot has been squared up against a
+    // wall, and the position with fresh range readings
+    static void observeAligned();
+
+    // Sets the Orientation heading, which is relative to the direction the
+    // robot is meant to be going, from the estimated heading
+    static void alignHeading();
+
+    // True if the estimate is good enough that realigning against a wall is
+    // not needed
+    static bool isConfident();
+
+    static const PoseEstimator& getPose();
+
+  private:
+    Odometry();
+};
+
+#endif
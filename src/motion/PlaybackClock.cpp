@@ -0,0 +1,31 @@
+// Dependencies within Micromouse
+#include "PlaybackClock.h"
+
+PlaybackClock::PlaybackClock()
+{
+  reset();
+}
+
+void PlaybackClock::reset()
+{
+  time_ = 0;
+  last_loop_time_ = 0;
+  remainder_ = 0;
+}
+
+uint32_t PlaybackClock::advance(uint32_t loop_time, float rate)
+{
+  float step = (loop_time - last_loop_time_) * rate + remainder_;
+  uint32_t whole = step > 0 ? (uint32_t) step : 0;
+
+  remainder_ = step - whole;
+  time_ += whole;
+  last_loop_time_ = loop_time;
+
+  return time_;
+}
+
+uint32_t PlaybackClock::getTime() const
+{
+  return time_;
+}
@@ -0,0 +1,46 @@
+#ifndef MICROMOUSE_PLAYBACK_CLOCK_H_
+#define MICROMOUSE_PLAYBACK_CLOCK_H_
+
+#include <stdint.h>
+
+// Time into a precomputed trajectory, played back at a variable rate
+//
+// Each cycle the playback time moves by the loop time that has passed since
+// the last cycle, times the rate. The loop time comes from the
+// ControlScheduler, so cycles after an overrun catch up on the ticks that
+// were missed, and at a rate of 1 the playback time is the loop time. The
+// part of a microsecond left over each cycle is carried to the next, so a
+// rate below 1 does not drift either.
+//
+//   PlaybackClock clock;
+//   clock.reset();
+//   scheduler.start();
+//   while (clock.getTime() < table.getTotalTime()) {
+//     uint32_t loop_time = scheduler.waitForCycle();
+//     table.lookup(clock.advance(loop_time, rate), setpoint);
+//     ...
+//   }
+//
+class PlaybackClock
+{
+  private:
+    uint32_t time_;
+    uint32_t last_loop_time_;
+    float remainder_;
+
+  public:
+    PlaybackClock();
+
+    // Starts over at time 0, for a loop whose first cycle is at time 0
+    void reset();
+
+    // Moves on to the cycle at loop_time, in microseconds since the loop
+    // started, and returns the new playback time. rate is the playback time
+    // per unit of loop time since the last cycle.
+    uint32_t advance(uint32_t loop_time, float rate);
+
+    // Returns the playback time in microseconds
+    uint32_t getTime() const;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include <cmath>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "../legacy_motion/FastMath.h"
+#include "PoseEstimator.h"
+
+static const float kRadiansPerDegree = M_PI / 180;
+
+PoseEstimator::PoseEstimator()
+{
+  reset(0, 0, 0, 0, 0);
+}
+
+void PoseEstimator::reset(float x, float y, float heading,
+                          float position_variance, float heading_variance)
+{
+  state_[kX] = x;
+  state_[kY] = y;
+  state_[kHeading] = heading;
+
+  for (size_t i = 0; i < kNumStates; i++) {
+    for (size_t j = 0; j < kNumStates; j++) {
+      covariance_[i][j] = 0;
+    }
+  }
+  covariance_[kX][kX] = position_variance;
+  covariance_[kY][kY] = position_variance;
+  covariance_[kHeading][kHeading] = heading_variance;
+}
+
+void PoseEstimator::predict(float distance, float rotation)
+{
+  // move along the heading halfway through the turn
+  float middle = (state_[kHeading] + rotation / 2) * kRadiansPerDegree;
+  float sine = FastMath::sin(middle);
+  float cosine = FastMath::cos(middle);
+
+  state_[kX] += distance * sine;
+  state_[kY] += distance * cosine;
+  state_[kHeading] += rotation;
+
+  // Jacobian of the position with respect to the heading, the rest of the
+  // Jacobian is the identity
+  float dx = distance * cosine * kRadiansPerDegree;
+  float dy = -distance * sine * kRadiansPerDegree;
+
+  // P = F P F^T
+  float (&p)[kNumStates][kNumStates] = covariance_;
+  float pxh = p[kX][kHeading] + dx * p[kHeading][kHeading];
+  float pyh = p[kY][kHeading] + dy * p[kHeading][kHeading];
+  p[kX][kX] += dx * (p[kX][kHeading] + pxh);
+  p[kY][kY] += dy * (p[kY][kHeading] + pyh);
+  p[kX][kY] += dx * p[kHeading][kY] + dy * pxh;
+  p[kX][kHeading] = pxh;
+  p[kY][kHeading] = pyh;
+
+  // process noise along and across the heading, rotated into x and y
+  float travelled = std::fabs(distance);
+  float along = POSE_DISTANCE_VARIANCE * travelled;
+  float across = POSE_LATERAL_VARIANCE * travelled;
+  p[kX][kX] += along * sine * sine + across * cosine * cosine;
+  p[kY][kY] += along * cosine * cosine + across * sine * sine;
+  p[kX][kY] += (along - across) * sine * cosine;
+  p[kHeading][kHeading] += POSE_DRIFT_VARIANCE * travelled
+                           + POSE_ROTATION_VARIANCE * std::fabs(rotation);
+
+  p[kY][kX] = p[kX][kY];
+  p[kHeading][kX] = p[kX][kHeading];
+  p[kHeading][kY] = p[kY][kHeading];
+}
+
+bool PoseEstimator::observe(const float h[kNumStates], float value,
+                            float variance)
+{
+  // P h^T, and the innovation and its variance
+  float ph[kNumStates];
+  float predicted = 0;
+  float innovation_variance = variance;
+  for (size_t i = 0; i < kNumStates; i++) {
+    ph[i] = 0;
+    for (size_t j = 0; j < kNumStates; j++) {
+      ph[i] += covariance_[i][j] * h[j];
+    }
+    predicted += h[i] * state_[i];
+  }
+  for (size_t i = 0; i < kNumStates; i++) {
+    innovation_variance += h[i] * ph[i];
+  }
+
+  float innovation = value - predicted;
+  if (innovation * innovation
+      > POSE_GATE * POSE_GATE * innovation_variance) {
+    return false;
+  }
+
+  // K = P h^T / S, x += K y, P -= K h P
+  for (size_t i = 0; i < kNumStates; i++) {
+    float gain = ph[i] / innovation_variance;
+    state_[i] += gain * innovation;
+    for (size_t j = 0; j < kNumStates; j++) {
+      covariance_[i][j] -= gain * ph[j];
+    }
+  }
+
+  return true;
+}
+
+bool PoseEstimator::observeX(float x, float variance)
+{
+  static const float h[kNumStates] = { 1, 0, 0 };
+  return observe(h, x, variance);
+}
+
+bool PoseEstimator::observeY(float y, float variance)
+{
+  static const float h[kNumStates] = { 0, 1, 0 };
+  return observe(h, y, variance);
+}
+
+bool PoseEstimator::observeHeading(float heading, float variance)
+{
+  static const float h[kNumStates] = { 0, 0, 1 };
+  return observe(h, heading, variance);
+}
+
+float PoseEstimator::getX() const
+{
+  return state_[kX];
+}
+
+float PoseEstimator::getY() const
+{
+  return state_[kY];
+}
+
+float PoseEstimator::getHeading() const
+{
+  return state_[kHeading];
+}
+
+float PoseEstimator::getCovariance(State i, State j) const
+{
+  return covariance_[i][j];
+}
+
+float PoseEstimator::getPositionError() const
+{
+  float worst = covariance_[kX][kX] > covariance_[kY][kY]
+                ? covariance_[kX][kX] : covariance_[kY][kY];
+  return std::sqrt(worst);
+}
+
+float PoseEstimator::getHeadingError() const
+{
+  return std::sqrt(covariance_[kHeading][kHeading]);
+}
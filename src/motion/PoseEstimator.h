@@ -0,0 +1,66 @@
+#ifndef MICROMOUSE_POSE_ESTIMATOR_H_
+#define MICROMOUSE_POSE_ESTIMATOR_H_
+
+#include <cstddef>
+
+// Extended Kalman filter for the position and heading of the robot
+//
+// The state is (x, y, heading), with x east and y north in mm and the heading
+// in degrees clockwise from north, along with its 3x3 covariance. predict()
+// moves the state by the distance the wheels covered and the angle the gyro
+// turned, and grows the covariance with both. Observations are scalar, so
+// each correction is a handful of multiplies with no matrix inverse, and
+// every call costs the same no matter what it is given.
+//
+// An observation further than POSE_GATE standard deviations from what the
+// state predicts is ignored, which keeps gaps in the walls and readings of
+// the wrong wall from pulling the estimate away.
+//
+//   PoseEstimator pose;
+//   pose.reset(0, 0, 0, 1, 1);
+//   pose.predict(wheel_distance, gyro_rotation);
+//   pose.observeX(wall_x, POSE_SIDE_WALL_VARIANCE);
+//
+class PoseEstimator
+{
+  public:
+    enum State { kX, kY, kHeading, kNumStates };
+
+  private:
+    float state_[kNumStates];
+    float covariance_[kNumStates][kNumStates];
+
+  public:
+    PoseEstimator();
+
+    // Sets the state, with independent errors of the given variances in mm^2
+    // and deg^2
+    void reset(float x, float y, float heading, float position_variance,
+               float heading_variance);
+
+    // Moves forward by distance mm while turning clockwise by rotation
+    // degrees
+    void predict(float distance, float rotation);
+
+    // Corrects the state with a scalar observation of h * state, where value
+    // is the observed value and variance is its variance. Returns false if
+    // the observation was rejected.
+    bool observe(const float h[kNumStates], float value, float variance);
+
+    bool observeX(float x, float variance);
+    bool observeY(float y, float variance);
+    bool observeHeading(float heading, float variance);
+
+    float getX() const;
+    float getY() const;
+    float getHeading() const;
+    float getCovariance(State i, State j) const;
+
+    // Standard deviation of the position along its worse axis, in mm
+    float getPositionError() const;
+
+    // Standard deviation of the heading, in degrees
+    float getHeadingError() const;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include <cmath>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "SlipDetector.h"
+
+// degrees per second of yaw for each m/s of difference between the sides
+static const float kDegreesPerSecondPerVelocity = 180 / M_PI * 1000
+                                                  / MM_BETWEEN_WHEELS;
+
+SlipDetector::SlipDetector()
+{
+  reset();
+}
+
+void SlipDetector::reset()
+{
+  slip_ = 0;
+  front_back_error_ = 0;
+  yaw_rate_error_ = 0;
+}
+
+void SlipDetector::update(float left_front, float left_back,
+                          float right_front, float right_back, float yaw_rate)
+{
+  float left_error = std::fabs(left_front - left_back);
+  float right_error = std::fabs(right_front - right_back);
+  front_back_error_ = left_error > right_error ? left_error : right_error;
+
+  // clockwise is positive, which has the left wheels going faster
+  float left = (left_front + left_back) / 2;
+  float right = (right_front + right_back) / 2;
+  yaw_rate_error_ = (left - right) * kDegreesPerSecondPerVelocity - yaw_rate;
+
+  float front_back = front_back_error_ / SLIP_FRONT_BACK_TOLERANCE;
+  float yaw = std::fabs(yaw_rate_error_) / SLIP_YAW_RATE_TOLERANCE;
+  float sample = front_back > yaw ? front_back : yaw;
+
+  slip_ += (sample - slip_) * SLIP_FILTER_GAIN;
+}
+
+float SlipDetector::getSlip() const
+{
+  return slip_;
+}
+
+bool SlipDetector::isSlipping() const
+{
+  return slip_ > SLIP_THRESHOLD;
+}
+
+float SlipDetector::getFrontBackError() const
+{
+  return front_back_error_;
+}
+
+float SlipDetector::getYawRateError() const
+{
+  return yaw_rate_error_;
+}
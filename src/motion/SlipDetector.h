@@ -0,0 +1,56 @@
+#ifndef MICROMOUSE_SLIP_DETECTOR_H_
+#define MICROMOUSE_SLIP_DETECTOR_H_
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Detects wheel slip from disagreement between the encoders and the gyro
+//
+// Wheels on the same side are geared to move together, and the yaw rate
+// implied by the left and right wheel speeds should match the gyro. A wheel
+// that spins or skids breaks one of those, so each cycle this compares:
+//
+//   - front and back wheel speeds, on each side
+//   - (left - right) / MM_BETWEEN_WHEELS with the gyro yaw rate
+//
+// Each difference is divided by its tolerance, and the largest is low pass
+// filtered into the slip. A slip of 0 means the sensors agree, and anything
+// past SLIP_THRESHOLD is treated as slipping.
+//
+//   SlipDetector slip;
+//   slip.update(enc_left_front_velocity(), enc_left_back_velocity(),
+//               enc_right_front_velocity(), enc_right_back_velocity(),
+//               orientation.getAngularVelocity());
+//   if (slip.isSlipping()) ...
+//
+class SlipDetector
+{
+  private:
+    float slip_;
+    float front_back_error_;
+    float yaw_rate_error_;
+
+  public:
+    SlipDetector();
+
+    // Forgets the filtered slip
+    void reset();
+
+    // Wheel speeds in m/s, and the gyro yaw rate in degrees per second
+    // clockwise, all from the same cycle
+    void update(float left_front, float left_back, float right_front,
+                float right_back, float yaw_rate);
+
+    // Filtered slip, in multiples of the tolerances
+    float getSlip() const;
+
+    bool isSlipping() const;
+
+    // Differences from the last update, unfiltered. The front to back error
+    // is the larger of the two sides in m/s, the yaw rate error is the wheel
+    // yaw rate minus the gyro in degrees per second.
+    float getFrontBackError() const;
+    float getYawRateError() const;
+};
+
+#endif
@@ -0,0 +1,570 @@
+#include <Arduino.h>
+#include "../device/Motor.h"
+#include "../device/Orientation.h"
+#include "../device/RangeSensorContainer.h"
+#include "../device/sensors_encoders.h"
+#include "../legacy_motion/MotionCalc.h"
+#include "../legacy_motion/PIDController.h"
+#include "../legacy_motion/SCurveProfile.h"
+#include "../legacy_motion/SweptTurnProfile.h"
+#include "../legacy_motion/motion.h"
+#include "../user_interaction/FreakOut.h"
+#include "../user_interaction/Log.h"
+#include "../user_interaction/Logger.h"
+#include "../user_interaction/PerfCounters.h"
+#include "../user_interaction/Trace.h"
+#include "../conf.h"
+#include "Odometry.h"
+#include "TrajectoryExecutor.h"
+
+// Finds the lookup table, its reference speed and the turn direction for a
+// swept turn
+static const SweptTurnProfile* turnTable(SweptTurnType turn_type,
+                                         float* reference_speed, int* sign)
+{
+  const SweptTurnProfile* turn_table = NULL;
+
+  switch (turn_type) {
+    case kLeftTurn45:
+    case kRightTurn45:
+      turn_table = &turn_45_table;
+      *reference_speed = SWEPT_TURN_45_FORWARD_SPEED;
+      break;
+    case kLeftTurn90:
+    case kRightTurn90:
+      turn_table = &turn_90_table;
+      *reference_speed = SWEPT_TURN_90_FORWARD_SPEED;
+      break;
+    case kLeftTurn135:
+    case kRightTurn135:
+      turn_table = &turn_135_table;
+      *reference_speed = SWEPT_TURN_135_FORWARD_SPEED;
+      break;
+    case kLeftTurn180:
+    case kRightTurn180:
+      turn_table = &turn_180_table;
+      *reference_speed = SWEPT_TURN_180_FORWARD_SPEED;
+      break;
+    default:
+      freakOut("OOPS");
+      break;
+  }
+
+  switch (turn_type) {
+    case kLeftTurn45:
+    case kLeftTurn90:
+    case kLeftTurn135:
+    case kLeftTurn180:
+      *sign = -1;
+      break;
+    default:
+      *sign = 1;
+      break;
+  }
+
+  return turn_table;
+}
+
+TrajectoryTable TrajectoryExecutor::table_;
+
+TrajectoryExecutor::TrajectoryExecutor(float max_accel, float max_decel)
+    : max_accel_(max_accel), max_decel_(max_decel), current_speed_(0),
+      total_time_(0), base_distance_(0), base_offset_(0), base_heading_(0),
+      heading_offset_(0), max_heading_error_(0), max_position_error_(0),
+      playback_rate_(1), slip_cycles_(0),
+      wheels_(KP_POSITION, KI_POSITION, KD_POSITION),
+      range_PID_(KP_RANGE, KI_RANGE, KD_RANGE),
+      straight_gyro_PID_(KP_GYRO_FWD, KI_GYRO_FWD, KD_GYRO_FWD),
+      diag_gyro_PID_(0.0015, 0.000, 0.00),
+      turn_gyro_PID_(KP_GYRO, KI_GYRO, KD_GYRO)
+{
+}
+
+void TrajectoryExecutor::enqueue(const Segment& segment)
+{
+  if (segments_.isFull()) {
+    freakOut("TRJ1");
+  }
+
+  segments_.enqueue(segment);
+  total_time_ += segment.duration;
+}
+
+void TrajectoryExecutor::addStraight(float distance, float max_velocity,
+                                     float exit_speed)
+{
+  Segment segment;
+  segment.type = kStraight;
+  segment.distance = distance;
+  segment.max_velocity = max_velocity;
+  segment.start_speed = current_speed_;
+  segment.exit_speed = exit_speed;
+
+  SCurveProfile profile(distance, max_velocity, current_speed_, exit_speed,
+                        max_accel_, max_decel_, MAX_JERK_STRAIGHT);
+  segment.duration = profile.getTotalTime();
+
+  enqueue(segment);
+  current_speed_ = exit_speed;
+}
+
+void TrajectoryExecutor::addDiagonal(float distance, float max_velocity,
+                                     float exit_speed)
+{
+  Segment segment;
+  segment.type = kDiagonal;
+  segment.distance = distance;
+  segment.max_velocity = max_velocity;
+  segment.start_speed = current_speed_;
+  segment.exit_speed = exit_speed;
+
+  SCurveProfile profile(distance, max_velocity, current_speed_, exit_speed,
+                        max_accel_, max_decel_, MAX_JERK_STRAIGHT);
+  segment.duration = profile.getTotalTime();
+
+  enqueue(segment);
+  current_speed_ = exit_speed;
+}
+
+void TrajectoryExecutor::addCorner(SweptTurnType turn_type, float speed,
+                                   float size_scaling)
+{
+  float reference_speed = 1;
+  int sign;
+  const SweptTurnProfile* turn_table = turnTable(turn_type, &reference_speed,
+                                                 &sign);
+
+  Segment segment;
+  segment.type = kCorner;
+  segment.turn_type = turn_type;
+  segment.max_velocity = speed;
+  segment.start_speed = speed;
+  segment.exit_speed = speed;
+  segment.size_scaling = size_scaling;
+  segment.duration = turn_table->getTotalTime() * 1000000 * size_scaling
+                     * reference_speed / speed;
+
+  enqueue(segment);
+  current_speed_ = speed;
+}
+
+void TrajectoryExecutor::addPivot(float angle)
+{
+  float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS_ROTATE / 360;
+
+  Segment segment;
+  segment.type = kPivot;
+  segment.distance = angle;
+  segment.start_speed = 0;
+  segment.exit_speed = 0;
+
+  MotionCalc motionCalc(distancePerDegree * angle, motion_get_maxVel_rotate(),
+                        0, 0, motion_get_maxAccel_rotate(),
+                        motion_get_maxDecel_rotate());
+  segment.duration = motionCalc.getTotalTime();
+
+  enqueue(segment);
+  current_speed_ = 0;
+}
+
+void TrajectoryExecutor::compileStraight(const Segment& segment,
+                                         uint32_t start_time,
+                                         uint32_t& sample_time)
+{
+  TrajectorySetpoint setpoint;
+  uint32_t end_time = start_time + segment.duration;
+
+  SCurveProfile profile(segment.distance, segment.max_velocity,
+                        segment.start_speed, segment.exit_speed,
+                        max_accel_, max_decel_, MAX_JERK_STRAIGHT);
+
+  for (; sample_time < end_time; sample_time += table_.getTick()) {
+    int32_t move_time = sample_time - start_time;
+    float distance;
+
+    profile.getState(move_time, &distance, &setpoint.velocity,
+                     &setpoint.accel);
+
+    setpoint.distance = base_distance_ + distance;
+    setpoint.offset = base_offset_;
+    setpoint.heading = base_heading_;
+    setpoint.offset_velocity = 0;
+    setpoint.offset_accel = 0;
+    setpoint.type = segment.type == kDiagonal ? 'd' : 'f';
+
+    if (!table_.add(setpoint)) {
+      freakOut("TRJ2");
+    }
+  }
+
+  base_distance_ += segment.distance;
+}
+
+void TrajectoryExecutor::compileCorner(const Segment& segment,
+                                       uint32_t start_time,
+                                       uint32_t& sample_time)
+{
+  TrajectorySetpoint setpoint;
+  uint32_t end_time = start_time + segment.duration;
+  float reference_speed = 1;
+  int sign;
+  float speed = segment.max_velocity;
+  const SweptTurnProfile* turn_table = turnTable(segment.turn_type,
+                                                 &reference_speed, &sign);
+
+  // rate at which time passes in the turn table
+  float time_scaling = speed / reference_speed / segment.size_scaling;
+
+  for (; sample_time < end_time; sample_time += table_.getTick()) {
+    int32_t move_time = sample_time - start_time;
+    float table_time = move_time * time_scaling / 1000000.0;
+
+    float angle = sign * turn_table->getAngle(table_time);
+    float angular_velocity = sign * time_scaling
+        * turn_table->getAngularVelocity(table_time);
+    float angular_accel = sign * time_scaling * time_scaling
+        * turn_table->getAngularAcceleration(table_time);
+
+    setpoint.distance = base_distance_ + move_time * speed / 1000;
+    setpoint.offset = base_offset_ + MM_BETWEEN_WHEELS / 2 * angle;
+    setpoint.heading = base_heading_ + angle * 180 / M_PI;
+    setpoint.velocity = speed;
+    setpoint.offset_velocity = MM_BETWEEN_WHEELS / 2 / 1000 * angular_velocity;
+    setpoint.accel = 0;
+    setpoint.offset_accel = MM_BETWEEN_WHEELS / 2 / 1000 * angular_accel;
+    setpoint.type = 's';
+
+    if (!table_.add(setpoint)) {
+      freakOut("TRJ2");
+    }
+  }
+
+  base_distance_ += segment.duration * speed / 1000;
+  base_offset_ += MM_BETWEEN_WHEELS / 2 * sign * turn_table->getTotalAngle()
+                  * M_PI / 180;
+  base_heading_ += sign * turn_table->getTotalAngle();
+}
+
+void TrajectoryExecutor::compilePivot(const Segment& segment,
+                                      uint32_t start_time,
+                                      uint32_t& sample_time)
+{
+  TrajectorySetpoint setpoint;
+  uint32_t end_time = start_time + segment.duration;
+  float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS_ROTATE / 360;
+  float linearDistance = distancePerDegree * segment.distance;
+
+  MotionCalc motionCalc(linearDistance, motion_get_maxVel_rotate(), 0, 0,
+                        motion_get_maxAccel_rotate(),
+                        motion_get_maxDecel_rotate());
+
+  for (; sample_time < end_time; sample_time += table_.getTick()) {
+    int32_t move_time = sample_time - start_time;
+    float idealLinearDistance = motionCalc.idealDistance(move_time);
+
+    setpoint.distance = base_distance_;
+    setpoint.offset = base_offset_ + idealLinearDistance;
+    setpoint.heading = base_heading_ + idealLinearDistance / distancePerDegree;
+    setpoint.velocity = 0;
+    setpoint.offset_velocity = motionCalc.idealVelocity(move_time);
+    setpoint.accel = 0;
+    setpoint.offset_accel = motionCalc.idealAccel(move_time);
+    setpoint.type = 'p';
+
+    if (!table_.add(setpoint)) {
+      freakOut("TRJ2");
+    }
+  }
+
+  base_offset_ += linearDistance;
+  base_heading_ += segment.distance;
+}
+
+void TrajectoryExecutor::compile()
+{
+  uint32_t segment_start = 0;
+  uint32_t sample_time = 0;
+  char last_type = 'f';
+
+  // Stretch the tick for long runs so that the whole run fits
+  uint32_t tick = TRAJECTORY_TICK_US;
+  if (total_time_ / tick + 2 > TrajectoryTable::kMaxPoints) {
+    tick = total_time_ / (TrajectoryTable::kMaxPoints - 2) + 1;
+  }
+  table_.clear(tick);
+
+  base_distance_ = 0;
+  base_offset_ = 0;
+  base_heading_ = 0;
+
+  while (!segments_.isEmpty()) {
+    Segment segment = segments_.dequeue();
+
+    switch (segment.type) {
+      case kStraight:
+      case kDiagonal:
+        compileStraight(segment, segment_start, sample_time);
+        last_type = segment.type == kDiagonal ? 'd' : 'f';
+        break;
+      case kCorner:
+        compileCorner(segment, segment_start, sample_time);
+        last_type = 's';
+        break;
+      case kPivot:
+        compilePivot(segment, segment_start, sample_time);
+        last_type = 'p';
+        break;
+    }
+
+    segment_start += segment.duration;
+  }
+
+  // Final resting point, so the last tick has something to interpolate to
+  TrajectorySetpoint setpoint;
+  setpoint.distance = base_distance_;
+  setpoint.offset = base_offset_;
+  setpoint.heading = base_heading_;
+  setpoint.velocity = setpoint.offset_velocity = 0;
+  setpoint.accel = setpoint.offset_accel = 0;
+  setpoint.type = last_type;
+
+  if (!table_.add(setpoint)) {
+    freakOut("TRJ2");
+  }
+
+  total_time_ = 0;
+}
+
+void TrajectoryExecutor::sense()
+{
+  dt_ = ControlScheduler::getInstance().getTimeStep();
+
+  PERF_BEGIN(orientation);
+  Orientation::getInstance().update();
+  PERF_END(orientation, kPerfOrientation);
+  heading_ = Orientation::getInstance().getHeading();
+  yaw_rate_ = Orientation::getInstance().getAngularVelocity();
+
+  wheels_.readEncoders();
+  Odometry::update();
+  wheel_velocities_[WheelController::kLeftFront] = enc_left_front_velocity();
+  wheel_velocities_[WheelController::kLeftBack] = enc_left_back_velocity();
+  wheel_velocities_[WheelController::kRightFront] = enc_right_front_velocity();
+  wheel_velocities_[WheelController::kRightBack] = enc_right_back_velocity();
+
+  // range sensors are only needed on straights
+  if (setpoint_.type == 'f' || setpoint_.type == 'd') {
+    PERF_BEGIN(range);
+    RangeSensors.updateReadings();
+    PERF_END(range, kPerfRange);
+    Odometry::observeWalls();
+    float shift = Odometry::shiftEncoders();
+    wheels_.shift(shift, shift);
+  }
+}
+
+void TrajectoryExecutor::estimate()
+{
+  slip_.update(wheel_velocities_[WheelController::kLeftFront],
+               wheel_velocities_[WheelController::kLeftBack],
+               wheel_velocities_[WheelController::kRightFront],
+               wheel_velocities_[WheelController::kRightBack], yaw_rate_);
+
+  float rate_step = SLIP_PLAYBACK_SLEW * dt_ / 1000000.0;
+  if (slip_.isSlipping()) {
+    slip_cycles_++;
+    if (setpoint_.accel * setpoint_.velocity >= 0) {
+      playback_rate_ = constrain(playback_rate_ - rate_step,
+                                 SLIP_MIN_PLAYBACK_RATE, 1);
+    }
+  } else {
+    playback_rate_ = constrain(playback_rate_ + rate_step,
+                               SLIP_MIN_PLAYBACK_RATE, 1);
+  }
+
+  const char last_type = setpoint_.type;
+  uint32_t loop_time = ControlScheduler::getInstance().getTime();
+  table_.lookup(playback_.advance(loop_time, playback_rate_), setpoint_);
+  if (setpoint_.type != last_type) {
+    TRACE_END("segment");
+    TRACE_BEGIN("segment", setpoint_.type);
+  }
+
+  float accel_scaling = playback_rate_ * playback_rate_;
+  setpoint_.velocity *= playback_rate_;
+  setpoint_.offset_velocity *= playback_rate_;
+  setpoint_.accel *= accel_scaling;
+  setpoint_.offset_accel *= accel_scaling;
+  PERF_MOTION_TYPE(setpoint_.type);
+
+  heading_error_ = heading_ - setpoint_.heading;
+  if (fabs(heading_error_) > max_heading_error_) {
+    max_heading_error_ = fabs(heading_error_);
+  }
+
+  if (abs(heading_error_) > 60) {
+    switch (setpoint_.type) {
+      case 'f':
+        freakOut("BAD1");
+      case 'd':
+        freakOut("BAD2");
+      case 'p':
+        freakOut("BAD3");
+      default:
+        freakOut("BAD5");
+    }
+  }
+
+  // Positive range error is when it is too close to the left wall, requiring
+  // a positive angle to fix it.
+  range_offset_ = 0;
+
+  if (setpoint_.type == 'f') {
+    range_offset_ = range_PID_.Calculate(RangeSensors.errorFromCenter(), 0,
+                                         dt_);
+  } else if (setpoint_.type == 'd') {
+    if (RangeSensors.frontRightSensor.getRange() < 150) {
+      if (RangeSensors.frontLeftSensor.getRange() < 150) {
+        range_offset_ = 0;
+      } else {
+        range_offset_ = RangeSensors.frontRightSensor.getRange() - 150;
+      }
+    } else if (RangeSensors.frontLeftSensor.getRange() < 150) {
+      range_offset_ = 150 - RangeSensors.frontLeftSensor.getRange();
+    }
+    range_offset_ *= KP_DIAG_RANGE;
+  }
+}
+
+void TrajectoryExecutor::control()
+{
+  float distancePerDegree = 3.14159265359 * MM_BETWEEN_WHEELS / 360;
+  float distancePerDegreeRotate = 3.14159265359 * MM_BETWEEN_WHEELS_ROTATE / 360;
+
+  gyro_correction_ = 0;
+
+  switch (setpoint_.type) {
+    case 'f':
+      heading_offset_ += straight_gyro_PID_.Calculate(
+          heading_error_ * distancePerDegree, range_offset_, dt_);
+      break;
+    case 'd':
+      heading_offset_ += diag_gyro_PID_.Calculate(
+          heading_error_ * distancePerDegree, range_offset_, dt_);
+      break;
+    case 's':
+      gyro_correction_ = turn_gyro_PID_.Calculate(
+          heading_error_ * distancePerDegree, 0, dt_);
+      break;
+    case 'p':
+      gyro_correction_ = turn_gyro_PID_.Calculate(
+          heading_error_ * distancePerDegreeRotate, 0, dt_);
+      break;
+  }
+
+  float offset = setpoint_.offset + heading_offset_ + gyro_correction_;
+  float left_setpoint = setpoint_.distance + offset;
+  float right_setpoint = setpoint_.distance - offset;
+
+  wheels_.update(left_setpoint, right_setpoint, dt_);
+
+  float errors[] = {
+    left_setpoint - wheels_.getPosition(WheelController::kLeftFront),
+    left_setpoint - wheels_.getPosition(WheelController::kLeftBack),
+    right_setpoint - wheels_.getPosition(WheelController::kRightFront),
+    right_setpoint - wheels_.getPosition(WheelController::kRightBack)
+  };
+  for (float error : errors) {
+    if (fabs(error) > max_position_error_) {
+      max_position_error_ = fabs(error);
+    }
+  }
+}
+
+void TrajectoryExecutor::actuate()
+{
+  float left_accel = setpoint_.accel + setpoint_.offset_accel;
+  float right_accel = setpoint_.accel - setpoint_.offset_accel;
+  float left_velocity = setpoint_.velocity + setpoint_.offset_velocity;
+  float right_velocity = setpoint_.velocity - setpoint_.offset_velocity;
+
+  PERF_BEGIN(motors);
+  motor_lf.Set(left_accel + wheels_.getCorrection(WheelController::kLeftFront),
+               left_velocity);
+  motor_rf.Set(right_accel + wheels_.getCorrection(WheelController::kRightFront),
+               right_velocity);
+  motor_rb.Set(right_accel + wheels_.getCorrection(WheelController::kRightBack),
+               right_velocity);
+  motor_lb.Set(left_accel + wheels_.getCorrection(WheelController::kLeftBack),
+               left_velocity);
+  PERF_END(motors, kPerfMotors);
+
+  logger.logMotionType(setpoint_.type);
+  logger.nextCycle();
+}
+
+bool TrajectoryExecutor::done()
+{
+  return playback_.getTime() >= table_.getTotalTime();
+}
+
+float TrajectoryExecutor::getMaxHeadingError() const
+{
+  return max_heading_error_;
+}
+
+float TrajectoryExecutor::getMaxPositionError() const
+{
+  return max_position_error_;
+}
+
+void TrajectoryExecutor::run()
+{
+  Orientation& orientation = Orientation::getInstance();
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+
+  compile();
+
+  enc_left_front_write(0);
+  enc_right_front_write(0);
+  enc_left_back_write(0);
+  enc_right_back_write(0);
+
+  heading_offset_ = 0;
+  max_heading_error_ = 0;
+  max_position_error_ = 0;
+  slip_.reset();
+  playback_.reset();
+  playback_rate_ = 1;
+  slip_cycles_ = 0;
+  table_.lookup(0, setpoint_);
+
+  RangeSensors.updateReadings();
+
+  TRACE_BEGIN("segment", setpoint_.type);
+  scheduler.run(*this);
+  TRACE_END("segment");
+
+  LOG("Control loop overruns: %lu in %lu cycles\n",
+      scheduler.getOverruns(), scheduler.getCycles());
+  LOG("Slipping for %lu cycles\n", slip_cycles_);
+
+  orientation.update();
+  orientation.incrementHeading(-base_heading_);
+
+  enc_left_front_write(0);
+  enc_right_front_write(0);
+  enc_left_back_write(0);
+  enc_right_back_write(0);
+
+  float current_left_velocity = (enc_left_front_velocity()
+                                  + enc_left_back_velocity()) / 2;
+  float current_right_velocity = (enc_right_front_velocity()
+                                   + enc_right_back_velocity()) / 2;
+  motor_lf.Set(0, current_left_velocity);
+  motor_rf.Set(0, current_right_velocity);
+  motor_rb.Set(0, current_right_velocity);
+  motor_lb.Set(0, current_left_velocity);
+
+  current_speed_ = 0;
+}
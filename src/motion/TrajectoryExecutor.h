@@ -0,0 +1,174 @@
+#ifndef MICROMOUSE_TRAJECTORY_EXECUTOR_H_
+#define MICROMOUSE_TRAJECTORY_EXECUTOR_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../legacy_motion/PIDController.h"
+#include "../legacy_motion/SweptTurnProfile.h"
+#include "../data.h"
+#include "ControlScheduler.h"
+#include "PlaybackClock.h"
+#include "SlipDetector.h"
+#include "TrajectoryTable.h"
+#include "WheelController.h"
+
+// Runs a whole program of motion primitives in one control loop
+//
+// The motion_* functions each build new PID controllers, zero the encoders and
+// hand the gyro back to the interrupt handler when they finish, so chaining
+// them loses controller history and position at every transition. This class
+// queues the primitives up front and then drives them back to back:
+//
+//   - encoders are zeroed once, and wheel setpoints keep accumulating across
+//     segments
+//   - the heading target is cumulative, so heading error carries from one
+//     segment into the next instead of being absorbed by incrementHeading()
+//   - the controllers live as long as the executor
+//   - each segment starts at the exact time the previous one was planned to
+//     end, so time overshot at the end of a segment is not lost
+//
+// Before the run starts, the program is compiled into a TrajectoryTable, so
+// the control loop only looks up setpoints and never evaluates a motion
+// profile. Straights and diagonals use a jerk limited SCurveProfile. The loop
+// itself is run by the ControlScheduler at CONTROL_LOOP_RATE_HZ.
+//
+// While the SlipDetector sees the wheels slipping, the table is played back
+// slower, down to SLIP_MIN_PLAYBACK_RATE. Velocities scale with the playback
+// rate and accelerations with its square, so the path stays the same and the
+// robot just takes longer over it. The rate only drops while speeding up or
+// cruising, since slowing playback while braking would brake harder.
+//
+// Entry speed of each segment is the exit speed of the one before it.
+//
+//   TrajectoryExecutor executor(max_accel, max_decel);
+//   executor.addStraight(MM_FROM_BACK_TO_CENTER, max_vel, turn_vel);
+//   executor.addCorner(kRightTurn90, turn_vel);
+//   executor.addStraight(MM_PER_BLOCK * 3, max_vel, 0);
+//   executor.run();
+//
+class TrajectoryExecutor : public ControlLoop
+{
+  private:
+    static const size_t kMaxSegments = 128;
+
+    enum SegmentType { kStraight, kDiagonal, kCorner, kPivot };
+
+    struct Segment {
+      SegmentType type;
+      SweptTurnType turn_type;
+
+      // mm for straights, degrees for pivots
+      float distance;
+      float max_velocity;
+      float start_speed;
+      float exit_speed;
+
+      float size_scaling;
+
+      // microseconds
+      uint32_t duration;
+    };
+
+    Queue<Segment, kMaxSegments> segments_;
+
+    const float max_accel_;
+    const float max_decel_;
+
+    // setpoints for the run, shared by all executors to keep it off the stack
+    static TrajectoryTable table_;
+
+    // speed the robot will be moving at after the last queued segment
+    float current_speed_;
+
+    // microseconds needed for all queued segments
+    uint32_t total_time_;
+
+    // Setpoints at the start of the segment being compiled
+    // along track distance in mm, differential wheel offset in mm, and
+    // heading target in degrees
+    float base_distance_;
+    float base_offset_;
+    float base_heading_;
+
+    // integrated heading correction for straights, in mm of wheel offset
+    float heading_offset_;
+
+    // State passed between the phases of the control loop
+    // microseconds since the last cycle, including any missed ticks
+    uint32_t dt_;
+    float wheel_velocities_[WheelController::kNumWheels];
+    float yaw_rate_;
+    TrajectorySetpoint setpoint_;
+    float heading_;
+    float heading_error_;
+    float range_offset_;
+    float gyro_correction_;
+
+    // Largest tracking errors of the last run, in degrees of heading and mm
+    // of any wheel's position
+    float max_heading_error_;
+    float max_position_error_;
+
+    SlipDetector slip_;
+
+    // time into the table, which runs slower than real time while slipping
+    PlaybackClock playback_;
+    float playback_rate_;
+    uint32_t slip_cycles_;
+
+    WheelController wheels_;
+    PIDController range_PID_;
+    PIDController straight_gyro_PID_;
+    PIDController diag_gyro_PID_;
+    PIDController turn_gyro_PID_;
+
+    void enqueue(const Segment& segment);
+
+    // Adds table entries for every tick from sample_time until the end of
+    // the segment, which starts at start_time microseconds into the run, and
+    // moves the base setpoints to the end of the segment.
+    void compileStraight(const Segment& segment, uint32_t start_time,
+                         uint32_t& sample_time);
+    void compileCorner(const Segment& segment, uint32_t start_time,
+                       uint32_t& sample_time);
+    void compilePivot(const Segment& segment, uint32_t start_time,
+                      uint32_t& sample_time);
+
+    // Compiles every queued segment into table_
+    void compile();
+
+  public:
+    TrajectoryExecutor(float max_accel, float max_decel);
+
+    // Queues a forward move of distance mm. Negative distances move backwards.
+    void addStraight(float distance, float max_velocity, float exit_speed);
+
+    // Queues a move of distance mm along a diagonal
+    void addDiagonal(float distance, float max_velocity, float exit_speed);
+
+    // Queues a swept turn, same arguments as motion_corner()
+    void addCorner(SweptTurnType turn_type, float speed,
+                   float size_scaling = 1);
+
+    // Queues a turn in place, clockwise degrees are positive
+    void addPivot(float angle);
+
+    // Drives every queued segment, and returns when the last one is done.
+    // Encoders are zeroed at the start and end, and the heading is left
+    // relative to the final direction, the same as the motion_* functions.
+    void run();
+
+    // ControlLoop phases, called by the ControlScheduler during run()
+    void sense() override;
+    void estimate() override;
+    void control() override;
+    void actuate() override;
+    bool done() override;
+
+    // Largest tracking errors seen during the last run()
+    float getMaxHeadingError() const;
+    float getMaxPositionError() const;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include <Arduino.h>
+#include "TrajectoryTable.h"
+
+// Rounds value * scale to the nearest integer
+static int32_t toFixed(float value, float scale)
+{
+  value *= scale;
+  return (int32_t) (value >= 0 ? value + 0.5 : value - 0.5);
+}
+
+static int16_t toFixed16(float value, float scale)
+{
+  return (int16_t) constrain(toFixed(value, scale), -32767, 32767);
+}
+
+TrajectoryTable::TrajectoryTable()
+{
+  clear(TRAJECTORY_TICK_US);
+}
+
+void TrajectoryTable::clear(uint32_t tick)
+{
+  size_ = 0;
+  tick_ = tick;
+  tick_reciprocal_ = 4294967296ULL / tick;
+}
+
+bool TrajectoryTable::add(const TrajectorySetpoint& setpoint)
+{
+  if (size_ >= kMaxPoints)
+    return false;
+
+  Point& point = points_[size_];
+  point.distance = toFixed(setpoint.distance, 1024);
+  point.offset = toFixed(setpoint.offset, 1024);
+  point.heading = toFixed(setpoint.heading, 1024);
+  point.velocity = toFixed16(setpoint.velocity, 1000);
+  point.offset_velocity = toFixed16(setpoint.offset_velocity, 1000);
+  point.accel = toFixed16(setpoint.accel, 1000);
+  point.offset_accel = toFixed16(setpoint.offset_accel, 1000);
+  point.type = setpoint.type;
+
+  size_++;
+  return true;
+}
+
+void TrajectoryTable::lookup(uint32_t time, TrajectorySetpoint& setpoint)
+{
+  if (size_ == 0) {
+    setpoint.distance = setpoint.offset = setpoint.heading = 0;
+    setpoint.velocity = setpoint.offset_velocity = 0;
+    setpoint.accel = setpoint.offset_accel = 0;
+    setpoint.type = 'h';
+    return;
+  }
+
+  size_t index = ((uint64_t) time * tick_reciprocal_) >> 32;
+  int32_t dt = time - index * tick_;
+
+  // the reciprocal is rounded down, so the index may be one short
+  if (dt >= (int32_t) tick_) {
+    index++;
+    dt -= tick_;
+  }
+
+  if (index >= size_ - 1) {
+    index = size_ - 1;
+    dt = 0;
+  }
+
+  const Point& point = points_[index];
+
+  int32_t distance = point.distance;
+  int32_t offset = point.offset;
+  int32_t heading = point.heading;
+  int32_t velocity = point.velocity;
+  int32_t offset_velocity = point.offset_velocity;
+  int32_t accel = point.accel;
+  int32_t offset_accel = point.offset_accel;
+
+  if (dt > 0) {
+    const Point& next = points_[index + 1];
+
+    // Positions use a cubic Hermite spline through the positions and
+    // velocities at both ends of the tick, which stays accurate when the
+    // acceleration changes partway through a tick. Fractions are Q16.
+    int64_t s1 = ((int64_t) dt * tick_reciprocal_) >> 16;
+    int64_t s2 = (s1 * s1) >> 16;
+    int64_t s3 = (s2 * s1) >> 16;
+    int64_t h10 = s3 - 2 * s2 + s1;
+    int64_t h01 = -2 * s3 + 3 * s2;
+    int64_t h11 = s3 - s2;
+
+    // distance covered in a whole tick at each stored velocity
+    //   4295 / 2^22 ~= 1024 / 10^6    (mm/s * us -> 1/1024 mm)
+    int64_t tick_distance = ((int64_t) tick_ * 4295) >> 6;
+    int64_t v0 = (point.velocity * tick_distance) >> 16;
+    int64_t v1 = (next.velocity * tick_distance) >> 16;
+    int64_t w0 = (point.offset_velocity * tick_distance) >> 16;
+    int64_t w1 = (next.offset_velocity * tick_distance) >> 16;
+
+    distance += (int32_t) ((h10 * v0 + h01 * (next.distance - point.distance)
+                            + h11 * v1) >> 16);
+    offset += (int32_t) ((h10 * w0 + h01 * (next.offset - point.offset)
+                          + h11 * w1) >> 16);
+
+    // Velocities are the derivative of the same spline, so they agree with
+    // the positions and have no steps where a segment boundary falls inside
+    // a tick. The chord is the average velocity over the tick:
+    //   15625 / 2^36 = 10^6 / (1024 * 2^32)    (1/1024 mm * 2^32/us -> mm/s)
+    int64_t d10 = 3 * s2 - 4 * s1 + 65536;
+    int64_t d01 = 6 * s1 - 6 * s2;
+    int64_t d11 = 3 * s2 - 2 * s1;
+    int64_t chord = ((int64_t) (next.distance - point.distance)
+                     * tick_reciprocal_ * 15625) >> 36;
+    int64_t offset_chord = ((int64_t) (next.offset - point.offset)
+                            * tick_reciprocal_ * 15625) >> 36;
+
+    velocity = (int32_t) ((d10 * point.velocity + d01 * chord
+                           + d11 * next.velocity) >> 16);
+    offset_velocity = (int32_t) ((d10 * point.offset_velocity
+                                  + d01 * offset_chord
+                                  + d11 * next.offset_velocity) >> 16);
+
+    // Accelerations and the heading have no stored rate, so they are
+    // interpolated linearly. Holding the acceleration for the whole tick
+    // would step the feedforward by up to a tick's worth of jerk at once.
+    accel += (int32_t) ((s1 * (next.accel - point.accel)) >> 16);
+    offset_accel += (int32_t) ((s1 * (next.offset_accel - point.offset_accel))
+                               >> 16);
+    heading += (int32_t) ((s1 * (next.heading - point.heading)) >> 16);
+  }
+
+  setpoint.distance = distance / 1024.0f;
+  setpoint.offset = offset / 1024.0f;
+  setpoint.heading = heading / 1024.0f;
+  setpoint.velocity = velocity / 1000.0f;
+  setpoint.offset_velocity = offset_velocity / 1000.0f;
+  setpoint.accel = accel / 1000.0f;
+  setpoint.offset_accel = offset_accel / 1000.0f;
+  setpoint.type = point.type;
+}
+
+size_t TrajectoryTable::getSize()
+{
+  return size_;
+}
+
+uint32_t TrajectoryTable::getTick()
+{
+  return tick_;
+}
+
+uint32_t TrajectoryTable::getTotalTime()
+{
+  return size_ > 0 ? (size_ - 1) * tick_ : 0;
+}
@@ -0,0 +1,81 @@
+#ifndef MICROMOUSE_TRAJECTORY_TABLE_H_
+#define MICROMOUSE_TRAJECTORY_TABLE_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Setpoints for one instant of a run
+//
+// The offset terms are added to the left wheels and subtracted from the right
+// wheels. type is the motion type character that is also sent to the logger.
+struct TrajectorySetpoint {
+  float distance; // mm
+  float offset; // mm
+  float heading; // degrees, clockwise positive
+  float velocity; // m/s
+  float offset_velocity; // m/s
+  float accel; // m/s/s
+  float offset_accel; // m/s/s
+  char type;
+};
+
+// Time indexed table of setpoints, compiled before a run starts
+//
+// Setpoints are stored in fixed point once per tick. Between ticks, positions
+// follow a cubic Hermite spline through the stored positions and velocities,
+// velocities are the derivative of that spline, and accelerations and the
+// heading are interpolated linearly, all in integer math, so the control loop
+// never has to evaluate a motion profile.
+//
+//   table.clear(tick);
+//   table.add(setpoint);   // once per tick, starting at time 0
+//   ...
+//   table.lookup(run_time, setpoint);
+//
+class TrajectoryTable
+{
+  public:
+    static const size_t kMaxPoints = TRAJECTORY_TABLE_SIZE;
+
+  private:
+    struct Point {
+      int32_t distance; // 1/1024 mm
+      int32_t offset; // 1/1024 mm
+      int32_t heading; // 1/1024 degree
+      int16_t velocity; // mm/s
+      int16_t offset_velocity; // mm/s
+      int16_t accel; // mm/s/s
+      int16_t offset_accel; // mm/s/s
+      char type;
+    };
+
+    Point points_[kMaxPoints];
+    size_t size_;
+    uint32_t tick_;
+
+    // 2^32 / tick_, so that lookups do not need to divide
+    uint32_t tick_reciprocal_;
+
+  public:
+    TrajectoryTable();
+
+    // Empties the table and sets the time between entries in microseconds
+    void clear(uint32_t tick);
+
+    // Adds the setpoint for the next tick. Returns false if the table is full.
+    bool add(const TrajectorySetpoint& setpoint);
+
+    // Fills in the setpoint at the given time in microseconds since the first
+    // entry. Times past the end give the last entry.
+    void lookup(uint32_t time, TrajectorySetpoint& setpoint);
+
+    size_t getSize();
+    uint32_t getTick();
+
+    // Returns the time in microseconds covered by the table
+    uint32_t getTotalTime();
+};
+
+#endif
@@ -0,0 +1,54 @@
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "WallEdgeDetector.h"
+
+static const float kMiddleRange = (POST_EDGE_WALL_RANGE
+                                   + POST_EDGE_OPEN_RANGE) / 2.0;
+
+WallEdgeDetector::WallEdgeDetector()
+{
+  reset();
+}
+
+void WallEdgeDetector::reset()
+{
+  has_sample_ = false;
+  wall_ = false;
+  last_range_ = 0;
+  last_distance_ = 0;
+  crossing_ = 0;
+}
+
+WallEdgeDetector::Edge WallEdgeDetector::update(float range, float distance,
+                                                float* edge_distance)
+{
+  if (!has_sample_) {
+    has_sample_ = true;
+    wall_ = range < kMiddleRange;
+    last_range_ = range;
+    last_distance_ = distance;
+    crossing_ = distance;
+    return kNoEdge;
+  }
+
+  // remember where the readings crossed the middle of the band
+  if ((last_range_ < kMiddleRange) != (range < kMiddleRange)) {
+    float fraction = (kMiddleRange - last_range_) / (range - last_range_);
+    crossing_ = last_distance_ + (distance - last_distance_) * fraction;
+  }
+
+  last_range_ = range;
+  last_distance_ = distance;
+
+  if (wall_ && range > POST_EDGE_OPEN_RANGE) {
+    wall_ = false;
+    *edge_distance = crossing_;
+    return kWallEnds;
+  } else if (!wall_ && range < POST_EDGE_WALL_RANGE) {
+    wall_ = true;
+    *edge_distance = crossing_;
+    return kWallStarts;
+  }
+
+  return kNoEdge;
+}
@@ -0,0 +1,50 @@
+#ifndef MICROMOUSE_WALL_EDGE_DETECTOR_H_
+#define MICROMOUSE_WALL_EDGE_DETECTOR_H_
+
+// Dependencies within Micromouse
+#include "../conf.h"
+
+// Finds where a side wall starts or ends along a straight
+//
+// A diagonal range sensor reads short while it looks at a side wall and long
+// once it looks past the wall's end into the next cell, so its readings step
+// where the wall meets a post. This tracks one sensor's readings, with
+// hysteresis between POST_EDGE_WALL_RANGE and POST_EDGE_OPEN_RANGE, and
+// reports the distance along the straight where they cross over. The crossing
+// is interpolated between the two samples on either side of the middle of
+// the hysteresis band.
+//
+//   WallEdgeDetector detector;
+//   float edge;
+//   if (detector.update(range, distance, &edge)) ...
+//
+class WallEdgeDetector
+{
+  public:
+    enum Edge { kNoEdge, kWallStarts, kWallEnds };
+
+  private:
+    bool has_sample_;
+    bool wall_;
+
+    // last sample, for interpolating the crossing
+    float last_range_;
+    float last_distance_;
+
+    // where the readings last crossed the middle of the band, which is the
+    // edge once they have gone all the way across
+    float crossing_;
+
+  public:
+    WallEdgeDetector();
+
+    // Forgets the state, for when the readings stop being along one straight
+    void reset();
+
+    // Takes a range in mm and the distance along the straight in mm it was
+    // read at. Returns the type of edge if one was found, with its distance
+    // along the straight written to edge_distance.
+    Edge update(float range, float distance, float* edge_distance);
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../device/sensors_encoders.h"
+#include "../conf.h"
+#include "WheelController.h"
+
+// Two int16_t in one word, a in the low half
+static inline uint32_t pack(int32_t a, int32_t b)
+{
+  return (uint16_t) a | ((uint32_t) (uint16_t) b << 16);
+}
+
+// Saturates to an int16_t
+static inline int32_t saturate16(int32_t value)
+{
+#if defined(__ARM_ARCH_7EM__)
+  int32_t result;
+  asm ("ssat %0, #16, %1" : "=r" (result) : "r" (value));
+  return result;
+#else
+  if (value > INT16_MAX)
+    return INT16_MAX;
+  if (value < INT16_MIN)
+    return INT16_MIN;
+  return value;
+#endif
+}
+
+// accumulator + low(x) * low(y) + high(x) * high(y)
+static inline int32_t smlad(uint32_t x, uint32_t y, int32_t accumulator)
+{
+#if defined(__ARM_ARCH_7EM__)
+  int32_t result;
+  asm ("smlad %0, %1, %2, %3"
+       : "=r" (result) : "r" (x), "r" (y), "r" (accumulator));
+  return result;
+#else
+  return accumulator + (int16_t) x * (int16_t) y
+    + (int16_t) (x >> 16) * (int16_t) (y >> 16);
+#endif
+}
+
+WheelController::WheelController(float kp, float ki, float kd, float i_bound)
+    : kp_(kp), kd_(kd), ki_(ki), has_integral_(ki != 0),
+      i_bound_(Q16::fromFloat(i_bound)), packed_gains_(0), gain_shift_(0),
+      gains_dt_(0), has_last_position_(false)
+{
+  for (size_t i = 0; i < kNumWheels; i++) {
+    position_[i] = 0;
+    position_fixed_[i] = 0;
+    last_position_[i] = 0;
+    i_term_[i] = Q16();
+    correction_[i] = Q16();
+  }
+}
+
+void WheelController::setTimeStep(uint32_t dt)
+{
+  float kd_dt = dt > 0 ? kd_ / dt : 0;
+  float largest = max(fabs(kp_), fabs(kd_dt));
+
+  // scale both gains by the same power of two, as far as they will go
+  gain_shift_ = 0;
+  if (largest > 0) {
+    while (largest * 2 <= kMaxGain && gain_shift_ < 40) {
+      largest *= 2;
+      gain_shift_++;
+    }
+    while (largest > kMaxGain) {
+      largest /= 2;
+      gain_shift_--;
+    }
+  }
+
+  float scale = ldexp(1, gain_shift_);
+  packed_gains_ = pack(lround(-kp_ * scale), lround(kd_dt * scale));
+  gains_dt_ = dt;
+}
+
+void WheelController::readEncoders()
+{
+  position_[kLeftFront] = enc_left_front_extrapolate();
+  position_[kLeftBack] = enc_left_back_extrapolate();
+  position_[kRightFront] = enc_right_front_extrapolate();
+  position_[kRightBack] = enc_right_back_extrapolate();
+}
+
+void WheelController::update(float left_setpoint, float right_setpoint,
+                             uint32_t dt)
+{
+  const float scale = 1 << kPositionBits;
+  int32_t setpoint[kNumWheels];
+
+  uint32_t tolerance = gains_dt_ / kTimeStepTolerance;
+  if (dt > gains_dt_ + tolerance || dt + tolerance < gains_dt_)
+    setTimeStep(dt);
+
+  setpoint[kLeftFront] = setpoint[kLeftBack] = lround(left_setpoint * scale);
+  setpoint[kRightFront] = setpoint[kRightBack] = lround(right_setpoint * scale);
+
+  for (size_t i = 0; i < kNumWheels; i++) {
+    position_fixed_[i] = lround(position_[i] * scale);
+  }
+
+  if (!has_last_position_) {
+    for (size_t i = 0; i < kNumWheels; i++) {
+      last_position_[i] = position_fixed_[i];
+    }
+    has_last_position_ = true;
+  }
+
+  // The products are in 2^-(kPositionBits + gain_shift_) units
+  int output_shift = kPositionBits + gain_shift_ - 16;
+
+  for (size_t i = 0; i < kNumWheels; i++) {
+    int32_t error = saturate16(position_fixed_[i] - setpoint[i]);
+    int32_t change = saturate16(last_position_[i] - position_fixed_[i]);
+
+    int32_t sum = smlad(pack(error, change), packed_gains_, 0);
+    correction_[i] = Q16::fromRaw(fixed::roundedShift(sum, output_shift));
+
+    last_position_[i] = position_fixed_[i];
+  }
+
+  if (has_integral_) {
+    for (size_t i = 0; i < kNumWheels; i++) {
+      int32_t error = position_fixed_[i] - setpoint[i];
+
+      // ki * error * dt in Q8, then up to Q16
+      Q16 step = Q16::fromRaw(
+          fixed::roundedShift(ki_.applyWide((int64_t) error * dt),
+                              kPositionBits - 16));
+      i_term_[i] = (i_term_[i] + step).clamp(-i_bound_, i_bound_);
+      correction_[i] -= i_term_[i];
+    }
+  }
+
+  elapsed_time_ = 0;
+}
+
+void WheelController::update(float left_setpoint, float right_setpoint)
+{
+  uint32_t dt = elapsed_time_;
+
+  readEncoders();
+  update(left_setpoint, right_setpoint, dt);
+}
+
+void WheelController::shift(float left, float right)
+{
+  const float scale = 1 << kPositionBits;
+  const int32_t left_fixed = lround(left * scale);
+  const int32_t right_fixed = lround(right * scale);
+
+  position_[kLeftFront] += left;
+  position_[kLeftBack] += left;
+  position_[kRightFront] += right;
+  position_[kRightBack] += right;
+
+  last_position_[kLeftFront] += left_fixed;
+  last_position_[kLeftBack] += left_fixed;
+  last_position_[kRightFront] += right_fixed;
+  last_position_[kRightBack] += right_fixed;
+}
+
+float WheelController::getPosition(Wheel wheel)
+{
+  return position_[wheel];
+}
+
+float WheelController::getCorrection(Wheel wheel)
+{
+  return correction_[wheel].toFloat();
+}
+
+Q16 WheelController::getCorrectionFixed(Wheel wheel)
+{
+  return correction_[wheel];
+}
@@ -0,0 +1,105 @@
+#ifndef MICROMOUSE_WHEEL_CONTROLLER_H_
+#define MICROMOUSE_WHEEL_CONTROLLER_H_
+
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "Fixed.h"
+
+// Position PID controllers for all four wheels, updated together
+//
+// Does the same job as four PIDController objects with the same gains, but
+// reads the encoders, works out the setpoints and runs the controllers in one
+// call with one time step. State is kept as one array per quantity so the
+// four wheels go through the same straight line code.
+//
+// Errors are kept in 1/256 mm and saturate at +/-128 mm, far past the point
+// where the motors saturate. The proportional and derivative terms of each
+// wheel are one packed 16 bit multiply-accumulate (SMLAD) on the Cortex-M4,
+// with a plain C version everywhere else. The integral term is only run for
+// a nonzero ki.
+//
+//   WheelController wheels(KP_POSITION, KI_POSITION, KD_POSITION);
+//   while (moving) {
+//     wheels.update(left_setpoint, right_setpoint);
+//     motor_lf.Set(accel + wheels.getCorrection(WheelController::kLeftFront),
+//                  velocity);
+//     ...
+//   }
+//
+class WheelController
+{
+  public:
+    enum Wheel { kLeftFront, kLeftBack, kRightFront, kRightBack, kNumWheels };
+
+  private:
+    // Largest packed gain, leaves room for two products and the integral in
+    // an int32_t
+    static const int32_t kMaxGain = 16383;
+
+    // fractional bits of positions and errors
+    static const int kPositionBits = 8;
+
+    // The gains are only repacked when the time step moves by more than
+    // 1/kTimeStepTolerance of the one they were packed for, so that the
+    // jitter of a loop timed by the ControlScheduler does not cost a float
+    // divide every cycle. The derivative term is off by at most as much.
+    static const uint32_t kTimeStepTolerance = 16;
+
+    const float kp_, kd_;
+    const FixedMultiplier ki_;
+    const bool has_integral_;
+    const Q16 i_bound_;
+
+    // -kp and kd/gains_dt_ as two int16_t, scaled up by 2^gain_shift_
+    uint32_t packed_gains_;
+    int gain_shift_;
+    uint32_t gains_dt_;
+
+    elapsedMicros elapsed_time_;
+    bool has_last_position_;
+
+    // mm
+    float position_[kNumWheels];
+
+    // 1/256 mm
+    int32_t position_fixed_[kNumWheels];
+    int32_t last_position_[kNumWheels];
+
+    Q16 i_term_[kNumWheels];
+    Q16 correction_[kNumWheels];
+
+    // Repacks the gains for a new time step
+    void setTimeStep(uint32_t dt);
+
+  public:
+    WheelController(float kp, float ki, float kd, float i_bound = 10000);
+
+    // Reads all four encoders
+    void readEncoders();
+
+    // Runs all four controllers on the last encoder readings, with the time
+    // step in microseconds since the last update
+    void update(float left_setpoint, float right_setpoint, uint32_t dt);
+
+    // Reads the encoders and runs the controllers with the time since the
+    // last update
+    void update(float left_setpoint, float right_setpoint);
+
+    // Moves the positions of the wheels on each side by the given mm, both
+    // the last readings and the ones the derivative is taken from, for when
+    // the encoders are shifted without the wheels moving. Without this the
+    // derivative term kicks on the cycle that sees the shift.
+    void shift(float left, float right);
+
+    // Returns the position of the given wheel at the last readEncoders() in mm
+    float getPosition(Wheel wheel);
+
+    // Returns the output of the given wheel's controller, same units as
+    // PIDController::Calculate()
+    float getCorrection(Wheel wheel);
+    Q16 getCorrectionFixed(Wheel wheel);
+};
+
+#endif
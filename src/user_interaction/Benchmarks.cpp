@@ -0,0 +1,138 @@
+#ifdef COMPILE_FOR_PC
+#include <cmath>
+#include <cstdio>
+#else
+#include <Arduino.h>
+#endif
+
+#include "../conf.h"
+#include "../legacy_motion/FastMath.h"
+#include "../legacy_motion/PIDController.h"
+#include "../motion/Fixed.h"
+#include "../motion/WheelController.h"
+#include "Benchmarks.h"
+#include "PerfCounters.h"
+
+#ifdef COMPILE_FOR_PC
+#define BENCH_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define BENCH_PRINTF(...) Serial.printf(__VA_ARGS__)
+#endif
+
+static const size_t kIterations = 1000;
+
+// volatile so that none of the work can be hoisted out of the loops
+static volatile float float_a = 1.2345, float_b = -0.5432;
+static volatile int32_t fixed_a = Q16::fromFloat(1.2345).raw();
+static volatile int32_t fixed_b = Q16::fromFloat(-0.5432).raw();
+static volatile float float_sink;
+static volatile int32_t fixed_sink;
+
+static void report(const char* name, uint32_t start, uint32_t end)
+{
+  BENCH_PRINTF("%s\t%lu\n", name,
+               (unsigned long) ((end - start) / kIterations));
+}
+
+// Prints the worst difference between a fast function and libm over
+// kAccuracySamples inputs from low to high
+static const size_t kAccuracySamples = 5000;
+
+#define ACCURACY(name, low, high, fast, exact, relative) \
+  do { \
+    float worst = 0; \
+    for (size_t i = 0; i <= kAccuracySamples; i++) { \
+      float x = low + (high - low) * i / kAccuracySamples; \
+      float error = fabs((fast) - (exact)); \
+      if (relative) \
+        error /= fabs(exact); \
+      worst = max(worst, error); \
+    } \
+    BENCH_PRINTF("%s\t%g\n", name, worst); \
+  } while (0)
+
+#define BENCHMARK(name, statement) \
+  do { \
+    uint32_t start = PerfCounters::now(); \
+    for (size_t i = 0; i < kIterations; i++) { \
+      statement; \
+    } \
+    report(name, start, PerfCounters::now()); \
+  } while (0)
+
+void runBenchmarks()
+{
+  PerfCounters::now();
+
+  BENCH_PRINTF("operation\tcycles\n");
+
+  BENCHMARK("loop", fixed_sink = fixed_a);
+
+  BENCHMARK("float add", float_sink = float_a + float_b);
+  BENCHMARK("float mul", float_sink = float_a * float_b);
+  BENCHMARK("float div", float_sink = float_a / float_b);
+  BENCHMARK("float to Q16", fixed_sink = Q16::fromFloat(float_a).raw());
+  BENCHMARK("Q16 to float",
+            float_sink = Q16::fromRaw(fixed_a).toFloat());
+
+  BENCHMARK("Q16 add",
+            fixed_sink = (Q16::fromRaw(fixed_a) + Q16::fromRaw(fixed_b)).raw());
+  BENCHMARK("Q16 mul",
+            fixed_sink = (Q16::fromRaw(fixed_a) * Q16::fromRaw(fixed_b)).raw());
+  BENCHMARK("Q16 div",
+            fixed_sink = (Q16::fromRaw(fixed_a) / Q16::fromRaw(fixed_b)).raw());
+
+  FixedMultiplier multiplier(KI_GYRO);
+  BENCHMARK("Q16 gain", fixed_sink = multiplier.apply((int64_t) fixed_a));
+
+  PIDController pid(KP_POSITION, KI_POSITION, KD_POSITION);
+  BENCHMARK("PID float", float_sink = pid.Calculate(float_a, float_b, 1000));
+
+  // four wheels, the way the motion primitives used to run them
+  PIDController wheel_pids[4] = {
+    { KP_POSITION, KI_POSITION, KD_POSITION },
+    { KP_POSITION, KI_POSITION, KD_POSITION },
+    { KP_POSITION, KI_POSITION, KD_POSITION },
+    { KP_POSITION, KI_POSITION, KD_POSITION }
+  };
+  BENCHMARK("PID x4", for (size_t j = 0; j < 4; j++) {
+    float_sink = wheel_pids[j].Calculate(float_a, float_b, 1000);
+  });
+
+  WheelController wheels(KP_POSITION, KI_POSITION, KD_POSITION);
+  BENCHMARK("wheels", {
+    wheels.update(float_a, float_b, 1000);
+    float_sink = wheels.getCorrection(WheelController::kLeftFront);
+  });
+
+  BENCHMARK("sin", float_sink = sin(float_a));
+  BENCHMARK("fast sin", float_sink = FastMath::sin(float_a));
+  BENCHMARK("fast sin phase",
+            float_sink = FastMath::sinPhase((FastMath::Phase) fixed_a));
+  BENCHMARK("atan2", float_sink = atan2(float_a, float_b));
+  BENCHMARK("fast atan2", float_sink = FastMath::atan2(float_a, float_b));
+  BENCHMARK("sqrt", float_sink = sqrt(float_a));
+  BENCHMARK("fast sqrt", float_sink = FastMath::sqrt(float_a));
+  BENCHMARK("hypot", float_sink = hypot(float_a, float_b));
+  BENCHMARK("fast hypot", float_sink = FastMath::hypot(float_a, float_b));
+  BENCHMARK("pow", float_sink = pow(float_a, float_b));
+  BENCHMARK("fast pow", float_sink = FastMath::pow(float_a, float_b));
+
+  BENCH_PRINTF("function\tworst error\n");
+
+  ACCURACY("sin", -10.0f, 10.0f, FastMath::sin(x), sin(x), false);
+  ACCURACY("cos", -10.0f, 10.0f, FastMath::cos(x), cos(x), false);
+  ACCURACY("atan2 x", -5.0f, 5.0f, FastMath::atan2(1, x), atan2(1, x), false);
+  ACCURACY("atan2 y", -5.0f, 5.0f, FastMath::atan2(x, -1), atan2(x, -1),
+           false);
+  ACCURACY("sqrt", 0.001f, 1000.0f, FastMath::sqrt(x), sqrt(x), true);
+  ACCURACY("hypot", -100.0f, 100.0f, FastMath::hypot(x, 3), hypot(x, 3),
+           true);
+  ACCURACY("pow", 0.01f, 100.0f, FastMath::pow(x, 2.5f), pow(x, 2.5f), true);
+
+#if CONTROL_FIXED_POINT
+  BENCHMARK("PID Q16", fixed_sink = pid.Calculate(Q16::fromRaw(fixed_a),
+                                                  Q16::fromRaw(fixed_b),
+                                                  1000).raw());
+#endif
+}
@@ -0,0 +1,12 @@
+#ifndef MICROMOUSE_BENCHMARKS_H_
+#define MICROMOUSE_BENCHMARKS_H_
+
+// Cycle counts for the arithmetic in the control path, printed over serial
+//
+// Each benchmark runs its operation many times on data the compiler can not
+// see through, and prints the mean cost of one operation in CPU cycles
+// (nanoseconds on a PC). The FastMath functions are also checked against
+// libm, and the worst error of each is printed.
+void runBenchmarks();
+
+#endif
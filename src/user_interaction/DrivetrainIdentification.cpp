@@ -0,0 +1,110 @@
+#include <Arduino.h>
+
+// Dependencies within Micromouse
+#include "../conf.h"
+#include "../device/Battery.h"
+#include "../device/Motor.h"
+#include "../device/PersistantStorage.h"
+#include "../device/sensors_encoders.h"
+#include "../motion/DrivetrainFit.h"
+#include "DrivetrainIdentification.h"
+#include "UserInterface.h"
+
+static const float kDutyCycles[] = SYSID_DUTY_CYCLES;
+
+// Largest parameter PersistantStorage can hold
+static const float kMaxParameter = 65535
+    / pow(10, PERSISTANT_STORAGE_DRIVETRAIN_DIGITS);
+
+static void setAllMotors(int pwm)
+{
+  motor_lf.SetPWM(pwm);
+  motor_lb.SetPWM(pwm);
+  motor_rf.SetPWM(pwm);
+  motor_rb.SetPWM(pwm);
+}
+
+static float meanVelocity()
+{
+  return (enc_left_front_velocity() + enc_left_back_velocity()
+          + enc_right_front_velocity() + enc_right_back_velocity()) / 4;
+}
+
+// Drives at one duty cycle for duration us, logging every sample and adding
+// it to the fit if fitting is set
+static void runSegment(float duty, uint32_t duration, uint32_t start_time,
+                       DrivetrainFit& fit, bool fitting)
+{
+  int pwm = round(duty * PWM_SPEED_STEPS);
+  float applied = (float) pwm / PWM_SPEED_STEPS;
+
+  setAllMotors(pwm);
+  fit.restart();
+
+  uint32_t segment_start = micros();
+  uint32_t next_sample = segment_start;
+  while (micros() - segment_start < duration) {
+    while ((int32_t) (micros() - next_sample) < 0) {
+      // wait
+    }
+    uint32_t sample_time = next_sample - start_time;
+    next_sample += SYSID_SAMPLE_PERIOD;
+
+    float volts = applied * Battery::getVoltage();
+    float velocity = meanVelocity();
+
+    if (fitting) {
+      fit.addSample(volts, velocity);
+    }
+
+    Serial.printf("%lu,%.4f,%.4f,%.4f\n",
+                  (unsigned long) sample_time, applied, volts, velocity);
+  }
+}
+
+static bool inRange(float parameter)
+{
+  return parameter > 0 && parameter < kMaxParameter;
+}
+
+void identifyDrivetrain()
+{
+  DrivetrainFit fit(SYSID_SAMPLE_PERIOD, SYSID_MIN_VELOCITY);
+
+  gUserInterface.waitForHand();
+  delay(1000);
+
+  Serial.println("time,duty,voltage,velocity");
+
+  uint32_t start_time = micros();
+  for (size_t i = 0; i < sizeof(kDutyCycles) / sizeof(kDutyCycles[0]); i++) {
+    runSegment(kDutyCycles[i], SYSID_STEP_TIME, start_time, fit, true);
+    runSegment(0, SYSID_COAST_TIME, start_time, fit, false);
+    runSegment(-kDutyCycles[i], SYSID_STEP_TIME, start_time, fit, true);
+    runSegment(0, SYSID_COAST_TIME, start_time, fit, false);
+  }
+  setAllMotors(0);
+
+  float static_volts, volts_per_velocity, volts_per_accel, rms_error;
+  if (!fit.solve(&static_volts, &volts_per_velocity, &volts_per_accel,
+                 &rms_error)
+      || !inRange(static_volts) || !inRange(volts_per_velocity)
+      || !inRange(volts_per_accel)) {
+    Serial.println("# fit failed");
+    gUserInterface.showString("FAIL", 4);
+    delay(1000);
+    return;
+  }
+
+  Serial.printf("# static %.4f V, velocity %.4f V/(m/s), accel %.4f V/(m/s^2),"
+                " rms %.4f V over %u samples\n", static_volts,
+                volts_per_velocity, volts_per_accel, rms_error,
+                (unsigned) fit.count());
+
+  PersistantStorage::setDrivetrainParameters(static_volts, volts_per_velocity,
+                                             volts_per_accel);
+  Motor::setFeedforward(static_volts, volts_per_velocity, volts_per_accel);
+
+  gUserInterface.showString("DONE", 4);
+  delay(1000);
+}
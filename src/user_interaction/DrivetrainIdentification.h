@@ -0,0 +1,15 @@
+#ifndef MICROMOUSE_DRIVETRAIN_IDENTIFICATION_H_
+#define MICROMOUSE_DRIVETRAIN_IDENTIFICATION_H_
+
+// Measures the motor feedforward on the robot
+//
+// After a hand wave, drives all four motors at each of SYSID_DUTY_CYCLES,
+// forward and then backward, coasting in between. The applied voltage and
+// mean wheel velocity are sampled every SYSID_SAMPLE_PERIOD, printed over
+// serial as CSV for tools/fit_drivetrain.py, and fitted with DrivetrainFit.
+// A good fit is saved to PersistantStorage and used by the motors right
+// away, and the display shows DONE. Otherwise it shows FAIL and nothing
+// changes.
+void identifyDrivetrain();
+
+#endif
@@ -18,7 +18,11 @@ void freakOut(const char* msg) {
   runs--;
   
   PersistantStorage::setNumRuns(runs);
-  PersistantStorage::setState(1);
+
+  // autoMode backs the speeds off after a speed run that did not finish
+  if (PersistantStorage::getState() != PersistantStorage::kRunStateSpeedRun) {
+    PersistantStorage::setState(PersistantStorage::kRunStateCrashed);
+  }
   
   gUserInterface.showString(msg);
   crashMelody();
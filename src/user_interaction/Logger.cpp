@@ -1,97 +1,104 @@
+#include <cstdlib>
+#include <cstring>
+
 #include "Logger.h"
 
-Logger::Logger() : cycles_(0) {}
+// end of the heap, from the C library
+extern "C" char* sbrk(int increment);
+
+static const char kMagic[] = "FREC";
+
+Logger::Logger() : records_(NULL), capacity_(0), count_(0) {
+  clearCurrent();
+}
+
+void Logger::clearCurrent() {
+  memset(&current_, 0, sizeof(current_));
+  current_.motion_type = ' ';
+}
+
+void Logger::begin() {
+  if (records_ != NULL) {
+    return;
+  }
+
+  char stack_top;
+  int32_t free_memory = &stack_top - sbrk(0) - LOG_RESERVED_MEMORY;
+  if (free_memory < (int32_t) sizeof(Record)) {
+    return;
+  }
+
+  capacity_ = free_memory / sizeof(Record);
+  records_ = (Record*) malloc(capacity_ * sizeof(Record));
+  if (records_ == NULL) {
+    capacity_ = 0;
+  }
+}
 
 void Logger::logForwardAccel(float value) {
-  forward_accel_log_.enqueue(value);
+  current_.forward_accel = constrain(value * 100, INT16_MIN, INT16_MAX);
 }
 
 void Logger::logRadialAccel(float value) {
-  radial_accel_log_.enqueue(value);
+  current_.radial_accel = constrain(value * 100, INT16_MIN, INT16_MAX);
 }
 
 void Logger::logGyro(float value) {
-  gyro_log_.enqueue(value);
+  current_.gyro = constrain(value, INT16_MIN, INT16_MAX);
 }
 
 void Logger::logHeading(float value) {
-  heading_log_.enqueue(value);
+  current_.heading = value;
 }
 
 void Logger::logMotionType(char value) {
-  motion_type_log_.enqueue(value);
+  current_.motion_type = value;
 }
 
 void Logger::logPrimaryPID(float value) {
-  primary_pid_log_.enqueue(value);
+  current_.primary_pid = value;
 }
 
 void Logger::logSecondaryPID(float value) {
-  secondary_pid_log_.enqueue(value);
+  current_.secondary_pid = value;
 }
 
 void Logger::logTertiaryPID(float value) {
-  tertiary_pid_log_.enqueue(value);
+  current_.tertiary_pid = value;
 }
 
 void Logger::nextCycle() {
-  cycles_++;
-
-  if (forward_accel_log_.getSize() < cycles_) {
-    forward_accel_log_.enqueue(0);
+  if (capacity_ == 0) {
+    return;
   }
 
-  if (radial_accel_log_.getSize() < cycles_) {
-    radial_accel_log_.enqueue(0);
-  }
-
-  if (gyro_log_.getSize() < cycles_) {
-    gyro_log_.enqueue(0);
-  }
-
-  if (heading_log_.getSize() < cycles_) {
-    heading_log_.enqueue(0);
-  }
-
-  if (motion_type_log_.getSize() < cycles_) {
-    motion_type_log_.enqueue(' ');
-  }
+  current_.time = micros();
+  records_[count_ % capacity_] = current_;
+  count_++;
 
-  if (primary_pid_log_.getSize() < cycles_) {
-    primary_pid_log_.enqueue(0);
-  }
-
-  if (secondary_pid_log_.getSize() < cycles_) {
-    secondary_pid_log_.enqueue(0);
-  }
-
-  if (tertiary_pid_log_.getSize() < cycles_) {
-    tertiary_pid_log_.enqueue(0);
-  }
+  clearCurrent();
 }
 
 void Logger::dump() {
-  nextCycle();
-  cycles_--;
-  while (cycles_ > 0) {
-    Serial.print(motion_type_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(forward_accel_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(radial_accel_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(gyro_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(heading_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(primary_pid_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(secondary_pid_log_.dequeue());
-    Serial.print("\t");
-    Serial.print(tertiary_pid_log_.dequeue());
-    Serial.println();
-    cycles_--;
+  uint32_t count = count_ < capacity_ ? count_ : capacity_;
+  uint8_t header[10];
+  memcpy(header, kMagic, 4);
+  header[4] = kVersion;
+  header[5] = sizeof(Record);
+  memcpy(header + 6, &count, sizeof(count));
+  Serial.write(header, sizeof(header));
+
+  uint16_t checksum = 0;
+  for (uint32_t i = count_ - count; i != count_; i++) {
+    const uint8_t* bytes = (const uint8_t*) &records_[i % capacity_];
+    for (size_t j = 0; j < sizeof(Record); j++) {
+      checksum += bytes[j];
+    }
+    Serial.write(bytes, sizeof(Record));
   }
+
+  Serial.write((const uint8_t*) &checksum, sizeof(checksum));
+  Serial.flush();
 }
 
 Logger logger;
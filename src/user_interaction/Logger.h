@@ -4,23 +4,59 @@
 #include <Arduino.h>
 
 #include "../conf.h"
-#include "../data.h"
 
+// Flight recorder for the control loops
+//
+// The log* functions fill in the record for the current cycle, and
+// nextCycle() stamps it with micros() and copies it into a ring in RAM,
+// overwriting the oldest record once the ring is full. begin() sizes the ring
+// to the memory that is free at startup, less LOG_RESERVED_MEMORY for the
+// stack. Values not logged in a cycle are recorded as zero.
+//
+// dump() writes the ring, oldest record first, to Serial as a binary stream:
+//
+//   "FREC", version (uint8), record size (uint8), record count (uint32)
+//   the records, as packed Logger::Record, little endian
+//   sum of the record bytes (uint16)
+//
+// tools/decode_flight_recorder.py turns a capture of that stream into CSV.
+//
+//   logger.begin();
+//   ...
+//   logger.logMotionType('f');
+//   logger.nextCycle();
+//
 class Logger {
+ public:
+  struct Record {
+    uint32_t time; // micros() at the end of the cycle
+    float heading; // degrees
+    float primary_pid;
+    float secondary_pid;
+    float tertiary_pid;
+    int16_t forward_accel; // cm/s/s
+    int16_t radial_accel; // cm/s/s
+    int16_t gyro; // raw
+    char motion_type;
+  } __attribute__((packed));
+
+  static const uint8_t kVersion = 1;
+
  private:
-  Queue<float, LOG_SIZE> forward_accel_log_;
-  Queue<float, LOG_SIZE> radial_accel_log_;
-  Queue<float, LOG_SIZE> gyro_log_;
-  Queue<float, LOG_SIZE> heading_log_;
-  Queue<char, LOG_SIZE> motion_type_log_;
-  Queue<float, LOG_SIZE> primary_pid_log_;
-  Queue<float, LOG_SIZE> secondary_pid_log_;
-  Queue<float, LOG_SIZE> tertiary_pid_log_;
-
-  size_t cycles_;
+  Record current_;
+  Record* records_;
+  uint32_t capacity_;
+
+  // records written since begin(), so the newest is at (count_ - 1) % capacity_
+  uint32_t count_;
+
+  void clearCurrent();
  public:
   Logger();
 
+  // Takes the free memory for the ring. Call once from setup().
+  void begin();
+
   void logForwardAccel(float value);
   void logRadialAccel(float value);
   void logGyro(float value);
@@ -0,0 +1,161 @@
+#ifdef COMPILE_FOR_PC
+#include <chrono>
+#include <cstdio>
+#else
+#include <Arduino.h>
+#endif
+
+#include "PerfCounters.h"
+
+#ifdef COMPILE_FOR_PC
+#define PERF_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define PERF_PRINTF(...) Serial.printf(__VA_ARGS__)
+#endif
+
+// Motion types in the same order as the histograms. Anything else is counted
+// as the last type.
+static const char kMotionTypes[] = "fdcpgshr?";
+
+static const char* const kPhaseNames[kPerfNumPhases] = {
+  "cycle", "orientation", "range", "translate", "motors",
+  "sense", "estimate", "control", "actuate"
+};
+
+PerfCounters::PerfCounters()
+{
+  reset();
+}
+
+uint32_t PerfCounters::now()
+{
+#ifdef COMPILE_FOR_PC
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+  return ARM_DWT_CYCCNT;
+#endif
+}
+
+size_t PerfCounters::bucketIndex(uint32_t ticks)
+{
+  if (ticks < (1UL << kMinOctave))
+    return 0;
+
+  int octave = 31 - __builtin_clz(ticks);
+  size_t half = (ticks >> (octave - 1)) & 1;
+  size_t index = 2 * (octave - kMinOctave) + half;
+
+  return index < kNumBuckets ? index : kNumBuckets - 1;
+}
+
+uint32_t PerfCounters::bucketLowerBound(size_t index)
+{
+  int octave = index / 2 + kMinOctave;
+  uint32_t lower = 1UL << octave;
+
+  if (index % 2)
+    lower += lower / 2;
+
+  return lower;
+}
+
+uint32_t PerfCounters::percentile(const Histogram& histogram, float fraction)
+{
+  uint32_t target = histogram.count * fraction;
+  uint32_t total = 0;
+
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    total += histogram.buckets[i];
+    if (total > target)
+      return bucketLowerBound(i);
+  }
+
+  return histogram.max;
+}
+
+void PerfCounters::setMotionType(char type)
+{
+  for (motion_type_ = 0; motion_type_ < kNumMotionTypes - 1; motion_type_++) {
+    if (kMotionTypes[motion_type_] == type)
+      return;
+  }
+}
+
+void PerfCounters::record(PerfPhase phase, uint32_t ticks)
+{
+  Histogram& histogram = histograms_[motion_type_][phase];
+  uint16_t& bucket = histogram.buckets[bucketIndex(ticks)];
+
+  if (histogram.count == 0 || ticks < histogram.min)
+    histogram.min = ticks;
+  if (ticks > histogram.max)
+    histogram.max = ticks;
+
+  histogram.count++;
+  histogram.total += ticks;
+
+  // saturate instead of wrapping around
+  if (bucket < 0xFFFF)
+    bucket++;
+}
+
+void PerfCounters::reset()
+{
+#ifndef COMPILE_FOR_PC
+  // make sure the cycle counter is running
+  ARM_DEMCR |= ARM_DEMCR_TRCENA;
+  ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+#endif
+
+  for (size_t type = 0; type < kNumMotionTypes; type++) {
+    for (size_t phase = 0; phase < kPerfNumPhases; phase++) {
+      Histogram& histogram = histograms_[type][phase];
+      histogram.count = 0;
+      histogram.min = 0;
+      histogram.max = 0;
+      histogram.total = 0;
+      for (size_t i = 0; i < kNumBuckets; i++) {
+        histogram.buckets[i] = 0;
+      }
+    }
+  }
+
+  motion_type_ = kNumMotionTypes - 1;
+}
+
+void PerfCounters::dump()
+{
+  PERF_PRINTF("type\tphase\tcount\tmin\tmean\tp99\tmax\n");
+
+  for (size_t type = 0; type < kNumMotionTypes; type++) {
+    for (size_t phase = 0; phase < kPerfNumPhases; phase++) {
+      const Histogram& histogram = histograms_[type][phase];
+
+      if (histogram.count == 0)
+        continue;
+
+      PERF_PRINTF("%c\t%s\t%lu\t%lu\t%lu\t%lu\t%lu\n",
+                  kMotionTypes[type], kPhaseNames[phase],
+                  (unsigned long) histogram.count,
+                  (unsigned long) histogram.min,
+                  (unsigned long) (histogram.total / histogram.count),
+                  (unsigned long) percentile(histogram, 0.99),
+                  (unsigned long) histogram.max);
+
+      // nonempty buckets as lower bound:count pairs
+      PERF_PRINTF("\t\t");
+      for (size_t i = 0; i < kNumBuckets; i++) {
+        if (histogram.buckets[i] > 0) {
+          PERF_PRINTF(" %lu:%u", (unsigned long) bucketLowerBound(i),
+                      histogram.buckets[i]);
+        }
+      }
+      PERF_PRINTF("\n");
+    }
+  }
+}
+
+#if PERF_ENABLED
+PerfCounters perfCounters;
+#endif
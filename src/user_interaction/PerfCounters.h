@@ -0,0 +1,113 @@
+#ifndef MICROMOUSE_PERF_COUNTERS_H_
+#define MICROMOUSE_PERF_COUNTERS_H_
+
+#ifdef COMPILE_FOR_PC
+#include <cstddef>
+#include <cstdint>
+#else
+#include <Arduino.h>
+#endif
+
+#define PERF_ENABLED false
+
+// Parts of a control loop iteration that are timed separately
+enum PerfPhase {
+  kPerfCycle, // a whole loop iteration
+  kPerfOrientation, // Orientation::update()
+  kPerfRange, // RangeSensorContainer::updateReadings()
+  kPerfRangeTranslate, // reading to distance conversion in RangeSensor
+  kPerfMotors, // Motor::Set() for all four motors
+  kPerfSense, // ControlLoop phases
+  kPerfEstimate,
+  kPerfControl,
+  kPerfActuate,
+  kPerfNumPhases
+};
+
+// Cycle time histograms for every phase of every motion primitive
+//
+// Times are counted in CPU cycles from the DWT cycle counter on the Teensy,
+// and in nanoseconds on a PC. Each histogram has two buckets per power of two,
+// which is enough to get the 99th percentile to within about 40%, and keeps
+// count, min, max and total for an exact mean.
+//
+// The motion type is the same character sent to Logger::logMotionType(). All
+// timings recorded after setMotionType() count toward that motion type.
+//
+// Use the macros so that none of this is compiled in unless PERF_ENABLED is
+// true. The histograms take several kB of RAM.
+//
+//   PERF_MOTION_TYPE('f');
+//   while (moving) {
+//     PERF_BEGIN(cycle);
+//     PERF_BEGIN(orientation);
+//     orientation.update();
+//     PERF_END(orientation, kPerfOrientation);
+//     ...
+//     PERF_END(cycle, kPerfCycle);
+//   }
+//   PERF_DUMP();
+//
+class PerfCounters
+{
+  public:
+    static const size_t kNumMotionTypes = 9;
+    static const size_t kNumBuckets = 36;
+
+    // Smallest power of two with its own bucket. Anything smaller is counted
+    // in the first bucket.
+    static const int kMinOctave = 4;
+
+  private:
+    struct Histogram {
+      uint32_t count;
+      uint32_t min;
+      uint32_t max;
+      uint64_t total;
+      uint16_t buckets[kNumBuckets];
+    };
+
+    Histogram histograms_[kNumMotionTypes][kPerfNumPhases];
+    size_t motion_type_;
+
+    static size_t bucketIndex(uint32_t ticks);
+    static uint32_t bucketLowerBound(size_t index);
+
+    // Returns the lower bound of the bucket containing the given percentile
+    static uint32_t percentile(const Histogram& histogram, float fraction);
+
+  public:
+    PerfCounters();
+
+    // Returns the current cycle count (nanoseconds on a PC)
+    static uint32_t now();
+
+    void setMotionType(char type);
+    void record(PerfPhase phase, uint32_t ticks);
+
+    // Clears every histogram
+    void reset();
+
+    // Writes out min, max, mean, p99 and the nonempty buckets of every
+    // histogram that has data
+    void dump();
+};
+
+#if PERF_ENABLED
+  extern PerfCounters perfCounters;
+
+  #define PERF_MOTION_TYPE(type) perfCounters.setMotionType(type)
+  #define PERF_BEGIN(name) uint32_t perf_begin_##name = PerfCounters::now()
+  #define PERF_END(name, phase) \
+    perfCounters.record(phase, PerfCounters::now() - perf_begin_##name)
+  #define PERF_RESET() perfCounters.reset()
+  #define PERF_DUMP() perfCounters.dump()
+#else
+  #define PERF_MOTION_TYPE(type)
+  #define PERF_BEGIN(name)
+  #define PERF_END(name, phase)
+  #define PERF_RESET()
+  #define PERF_DUMP()
+#endif
+
+#endif
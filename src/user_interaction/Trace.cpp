@@ -0,0 +1,71 @@
+#ifdef COMPILE_FOR_PC
+#include <chrono>
+#include <cstdio>
+#else
+#include <Arduino.h>
+#endif
+
+#include "Trace.h"
+
+#ifdef COMPILE_FOR_PC
+#define TRACE_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define TRACE_PRINTF(...) Serial.printf(__VA_ARGS__)
+#endif
+
+static_assert((Trace::kSize & (Trace::kSize - 1)) == 0,
+              "Trace::kSize must be a power of two");
+
+Trace::Trace()
+{
+  reset();
+}
+
+uint32_t Trace::now()
+{
+#ifdef COMPILE_FOR_PC
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+  return micros();
+#endif
+}
+
+void Trace::record(char phase, const char* name, int32_t arg)
+{
+  uint32_t index = count_.fetch_add(1, std::memory_order_relaxed);
+  Event& event = events_[index & (kSize - 1)];
+
+  event.time = now();
+  event.name = name;
+  event.arg = arg;
+  event.phase = phase;
+}
+
+void Trace::reset()
+{
+  count_.store(0, std::memory_order_relaxed);
+}
+
+void Trace::dump()
+{
+  uint32_t count = count_.load(std::memory_order_relaxed);
+  uint32_t first = count > kSize ? count - kSize : 0;
+
+  TRACE_PRINTF("time\tphase\tname\targ\n");
+
+  for (uint32_t i = first; i < count; i++) {
+    const Event& event = events_[i & (kSize - 1)];
+    TRACE_PRINTF("%lu\t%c\t%s\t%ld\n", (unsigned long) event.time,
+                 event.phase, event.name, (long) event.arg);
+  }
+
+  // so the host can tell that older events were lost
+  if (first > 0) {
+    TRACE_PRINTF("dropped %lu\n", (unsigned long) first);
+  }
+}
+
+#if TRACE_ENABLED
+Trace trace;
+#endif
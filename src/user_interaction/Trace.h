@@ -0,0 +1,89 @@
+#ifndef MICROMOUSE_TRACE_H_
+#define MICROMOUSE_TRACE_H_
+
+#ifdef COMPILE_FOR_PC
+#include <cstddef>
+#include <cstdint>
+#else
+#include <Arduino.h>
+#endif
+
+#include <atomic>
+
+#define TRACE_ENABLED false
+
+// Timeline of begin, end and instant events, for seeing when things happen
+// relative to one another
+//
+// Each event is a time in microseconds, a name, a phase and one integer
+// argument. The name must be a string literal, since only the pointer is
+// kept. Events go into a ring that keeps the last kSize of them, and a slot
+// is claimed with an atomic increment, so interrupt handlers can record
+// events too.
+//
+// dump() writes the events out oldest first as tab separated text, which
+// tools/trace_to_chrome.py turns into a file for chrome://tracing or
+// Perfetto. Events recorded while dumping may be garbled.
+//
+// Use the macros so that none of this is compiled in unless TRACE_ENABLED is
+// true. The ring takes 16 kB of RAM.
+//
+//   TRACE_BEGIN("solve", x);
+//   FloodFillPath<16, 16> path(maze, x, y, 0, 0);
+//   TRACE_END("solve");
+//   TRACE_INSTANT("wall", is_wall);
+//   ...
+//   TRACE_DUMP();
+//
+class Trace
+{
+  public:
+    static const size_t kSize = 1024;
+
+    static const char kBegin = 'B';
+    static const char kEnd = 'E';
+    static const char kInstant = 'i';
+
+  private:
+    struct Event {
+      uint32_t time; // us
+      const char* name;
+      int32_t arg;
+      char phase;
+    };
+
+    Event events_[kSize];
+    std::atomic<uint32_t> count_;
+
+  public:
+    Trace();
+
+    // Returns the current time in microseconds
+    static uint32_t now();
+
+    void record(char phase, const char* name, int32_t arg);
+
+    // Forgets every event
+    void reset();
+
+    // Writes out every event still in the ring, oldest first
+    void dump();
+};
+
+#if TRACE_ENABLED
+  extern Trace trace;
+
+  #define TRACE_BEGIN(name, arg) trace.record(Trace::kBegin, name, arg)
+  #define TRACE_END(name) trace.record(Trace::kEnd, name, 0)
+  #define TRACE_INSTANT(name, arg) trace.record(Trace::kInstant, name, arg)
+  #define TRACE_RESET() trace.reset()
+  #define TRACE_DUMP() trace.dump()
+#else
+  #define TRACE_BEGIN(name, arg)
+  #define TRACE_END(name)
+  #define TRACE_INSTANT(name, arg)
+  #define TRACE_RESET()
+  #define TRACE_DUMP()
+#endif
+
+#endif
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "../conf.h"
+#include "../device/Battery.h"
 #include "../device/RangeSensorContainer.h"
 #include "../device/Motor.h"
 #include "../device/Orientation.h"
@@ -219,7 +220,7 @@ void UserInterface::checkBattery()
   int whole;
   int decimal;
 
-  float voltage = (8.225 / 6.330) * (26 / 10) * (3.3 / 1023) * analogRead(BATTERY_PIN);
+  float voltage = Battery::read();
 
   if (voltage < BATTERY_VOLTAGE_WARNING) {
     tone(BUZZER_PIN, 2000);
@@ -249,6 +250,8 @@ void UserInterface::waitForHand()
   bool readyToStart = false;
   int state = 0;
 
+  orientation.setStationary(true);
+
   while (!readyToStart) {
 
     checkBattery();
@@ -284,5 +287,11 @@ void UserInterface::waitForHand()
     heading = orientation.getHeading();
 
     delay(100);
+
+    // take the samples from the delay, for the gyro bias
+    while (orientation.update()) {
+    }
   }
+
+  orientation.setStationary(false);
 }
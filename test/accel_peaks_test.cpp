@@ -0,0 +1,115 @@
+// Host tests for AccelPeaks, checking that a lone spike stays under the
+// point where SpeedEscalation backs a speed off, and a held acceleration
+// does not
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "conf.h"
+#include "device/AccelPeaks.h"
+#include "check.h"
+
+#include "device/AccelPeaks.cpp"
+
+// raw reading for an acceleration in m/s/s
+static int16_t raw(float accel)
+{
+  return lround(accel * ACCEL_LSB_PER_G / STANDARD_GRAVITY);
+}
+
+// SpeedEscalation::afterRun() backs a limit off when its usage is over 1
+static bool backsOff(float peak)
+{
+  return peak / ESCALATION_TRACTION_LIMIT > 1;
+}
+
+// A run at 70% of the traction limit with one packet at twice the limit,
+// the way a bump reads, in each direction
+static void testSpike()
+{
+  const float cruise = 0.7 * ESCALATION_TRACTION_LIMIT;
+  const float spike = 2 * ESCALATION_TRACTION_LIMIT;
+  AccelPeaks peaks;
+
+  for (int i = 0; i < 200; i++) {
+    float forward = i < 100 ? cruise : -cruise;
+    float radial = i % 2 == 0 ? cruise : cruise * 0.9;
+
+    if (i == 50 || i == 150) {
+      forward = forward > 0 ? spike : -spike;
+    }
+    if (i == 120) {
+      radial = spike;
+    }
+
+    peaks.add(raw(forward), raw(radial));
+  }
+
+  printf("spike of %.1f m/s/s over %.1f: peaks %.2f accel, %.2f decel, "
+         "%.2f radial against a limit of %.2f\n", spike, cruise,
+         peaks.getMaxForwardAccel(), peaks.getMaxForwardDecel(),
+         peaks.getMaxRadialAccel(), (float) ESCALATION_TRACTION_LIMIT);
+
+  CHECK(!backsOff(peaks.getMaxForwardAccel()));
+  CHECK(!backsOff(peaks.getMaxForwardDecel()));
+  CHECK(!backsOff(peaks.getMaxRadialAccel()));
+
+  // the spike still moves the average by its share of the window
+  CHECK_NEAR(peaks.getMaxForwardAccel(),
+             cruise + (spike - cruise) / AccelPeaks::kWindow, 0.01);
+}
+
+// Anything held for the whole window counts in full
+static void testHeld()
+{
+  const float over = 1.1 * ESCALATION_TRACTION_LIMIT;
+  AccelPeaks peaks;
+
+  for (size_t i = 0; i < AccelPeaks::kWindow; i++) {
+    peaks.add(raw(over), raw(-over));
+  }
+  CHECK_NEAR(peaks.getMaxForwardAccel(), over, 0.01);
+  CHECK_NEAR(peaks.getMaxRadialAccel(), over, 0.01);
+  CHECK(backsOff(peaks.getMaxForwardAccel()));
+  CHECK(backsOff(peaks.getMaxRadialAccel()));
+  CHECK(peaks.getMaxForwardDecel() == 0);
+
+  for (size_t i = 0; i < AccelPeaks::kWindow; i++) {
+    peaks.add(raw(-over), 0);
+  }
+  CHECK_NEAR(peaks.getMaxForwardDecel(), over, 0.01);
+  CHECK(backsOff(peaks.getMaxForwardDecel()));
+}
+
+// Resets forget the peaks but keep the window
+static void testReset()
+{
+  const float accel = 5;
+  AccelPeaks peaks;
+
+  for (size_t i = 0; i < AccelPeaks::kWindow; i++) {
+    peaks.add(raw(accel), raw(accel));
+  }
+
+  peaks.resetForward();
+  CHECK(peaks.getMaxForwardAccel() == 0);
+  CHECK_NEAR(peaks.getMaxRadialAccel(), accel, 0.01);
+
+  peaks.add(raw(accel), raw(accel));
+  CHECK_NEAR(peaks.getMaxForwardAccel(), accel, 0.01);
+
+  peaks.resetRadial();
+  CHECK(peaks.getMaxRadialAccel() == 0);
+
+  peaks.clear();
+  peaks.add(raw(accel), raw(accel));
+  CHECK_NEAR(peaks.getMaxForwardAccel(), accel / AccelPeaks::kWindow, 0.01);
+}
+
+int main()
+{
+  testSpike();
+  testHeld();
+  testReset();
+  return checkResult();
+}
@@ -0,0 +1,49 @@
+#ifndef MICROMOUSE_TEST_CHECK_H_
+#define MICROMOUSE_TEST_CHECK_H_
+
+#include <cmath>
+#include <cstdio>
+
+// Bare bones checks for the host tests
+//
+// A failed check prints where it was and what the values were, and the test
+// carries on so that one run shows every failure. main() returns
+// checkResult(), which is nonzero if anything failed.
+//
+//   CHECK(ring.empty());
+//   CHECK_NEAR(table.getAngle(t), expected, 0.01);
+//   return checkResult();
+//
+
+static int check_failures = 0;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      check_failures++; \
+    } \
+  } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+  do { \
+    double check_actual = (actual); \
+    double check_expected = (expected); \
+    if (!(std::fabs(check_actual - check_expected) <= (tolerance))) { \
+      printf("%s:%d: %s is %g, expected %g +/- %g\n", __FILE__, __LINE__, \
+             #actual, check_actual, check_expected, (double) (tolerance)); \
+      check_failures++; \
+    } \
+  } while (0)
+
+static int checkResult()
+{
+  if (check_failures > 0) {
+    printf("%d checks failed\n", check_failures);
+    return 1;
+  }
+
+  return 0;
+}
+
+#endif
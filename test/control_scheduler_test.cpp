@@ -0,0 +1,45 @@
+// Host tests for ControlScheduler, with the timer ticked by hand
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "motion/ControlScheduler.h"
+#include "check.h"
+
+#include "motion/ControlScheduler.cpp"
+
+static void testTimeStep()
+{
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  const uint32_t period = scheduler.getPeriod();
+
+  scheduler.start();
+
+  IntervalTimer::fire();
+  CHECK(scheduler.waitForCycle() == 0);
+  CHECK(scheduler.getTimeStep() == period);
+
+  IntervalTimer::fire();
+  CHECK(scheduler.waitForCycle() == period);
+  CHECK(scheduler.getTimeStep() == period);
+
+  // a cycle that ran long enough to miss a tick
+  IntervalTimer::fire();
+  IntervalTimer::fire();
+  CHECK(scheduler.waitForCycle() == 3 * period);
+  CHECK(scheduler.getTimeStep() == 2 * period);
+  CHECK(scheduler.getOverruns() == 1);
+
+  IntervalTimer::fire();
+  CHECK(scheduler.waitForCycle() == 4 * period);
+  CHECK(scheduler.getTimeStep() == period);
+  CHECK(scheduler.getCycles() == 4);
+
+  scheduler.stop();
+}
+
+int main()
+{
+  testTimeStep();
+  return checkResult();
+}
@@ -0,0 +1,132 @@
+// Host tests for FastMath, checking the error bounds documented in
+// FastMath.h against libm in double precision
+
+#include <Arduino.h>
+#include <cmath>
+#include <cstdint>
+
+#include "legacy_motion/FastMath.h"
+#include "check.h"
+
+#include "legacy_motion/FastMath.cpp"
+
+static void testSin()
+{
+  double worst = 0;
+
+  // every radian input the firmware is likely to see, in float
+  for (int i = 0; i <= 2000000; i++) {
+    float x = -10 + 20.0 * i / 2000000;
+    worst = max(worst, std::fabs(FastMath::sin(x) - std::sin((double) x)));
+    worst = max(worst, std::fabs(FastMath::cos(x) - std::cos((double) x)));
+  }
+
+  // and every 1024th phase around the whole turn
+  const double kRadiansPerPhase = 2 * M_PI / 4294967296.0;
+  for (uint64_t phase = 0; phase < ((uint64_t) 1 << 32); phase += 1024) {
+    double x = phase * kRadiansPerPhase;
+    worst = max(worst, std::fabs(FastMath::sinPhase(phase) - std::sin(x)));
+    worst = max(worst, std::fabs(FastMath::cosPhase(phase) - std::cos(x)));
+  }
+
+  printf("sin, cos    worst error %.2g\n", worst);
+  CHECK(worst <= 2e-5);
+
+  // a double argument picks the radian version
+  CHECK_NEAR(FastMath::sin(M_PI / 4), std::sqrt(0.5), 2e-5);
+  CHECK_NEAR(FastMath::cos(M_PI / 4), std::sqrt(0.5), 2e-5);
+  CHECK_NEAR(FastMath::sin(-M_PI / 2), -1, 2e-5);
+}
+
+// The generated table has to match sin, to float precision
+static void testSineTable()
+{
+  double worst = 0;
+  for (size_t i = 0; i <= FastMath::kSineTableSize; i++) {
+    FastMath::Phase phase = (FastMath::Phase) ((uint64_t) i << 32
+                                               >> FastMath::kSineTableBits);
+    double x = 2 * M_PI * i / FastMath::kSineTableSize;
+    worst = max(worst, std::fabs(FastMath::sinPhase(phase) - std::sin(x)));
+  }
+  CHECK(worst <= 1e-7);
+}
+
+static void testAtan2()
+{
+  double worst = 0;
+
+  // all the way around, at radii from tiny to huge
+  for (int i = 0; i < 100000; i++) {
+    double angle = -M_PI + 2 * M_PI * i / 100000;
+    for (double radius = 1e-6; radius < 1e7; radius *= 10) {
+      float y = radius * std::sin(angle);
+      float x = radius * std::cos(angle);
+      double expected = std::atan2((double) y, (double) x);
+      double error = std::fabs(FastMath::atan2(y, x) - expected);
+
+      // -pi and pi are the same angle
+      worst = max(worst, min(error, 2 * M_PI - error));
+    }
+  }
+
+  printf("atan2       worst error %.2g rad\n", worst);
+  CHECK(worst <= 1.2e-5);
+  CHECK(FastMath::atan2(0, 0) == 0);
+}
+
+static void testSqrt()
+{
+  double worst = 0;
+
+  for (double x = 1e-6; x < 1e6; x *= 1.0001) {
+    float value = x;
+    double expected = std::sqrt((double) value);
+    worst = max(worst, std::fabs(FastMath::sqrt(value) - expected) / expected);
+  }
+
+  for (int i = -100000; i <= 100000; i++) {
+    float x = i / 1000.0;
+    float y = 3;
+    double expected = std::hypot((double) x, (double) y);
+    worst = max(worst, std::fabs(FastMath::hypot(x, y) - expected) / expected);
+  }
+
+  printf("sqrt, hypot worst error %.2g relative\n", worst);
+  CHECK(worst <= 5e-6);
+  CHECK(FastMath::sqrt(0) == 0);
+  CHECK(FastMath::sqrt(-1) == 0);
+}
+
+static void testPow()
+{
+  const float kExponents[] = { -13.7, -8, -6.3, -2.5, -1, -0.5, 0, 0.1234567,
+                               0.5, 1, 2, 2.5, 3, 6.3, 8, 13.7 };
+  double worst = 0;
+
+  for (float y : kExponents) {
+    for (double x = 1e-3; x < 1e3; x *= 1.0001) {
+      float value = x;
+      if (std::fabs(y * std::log2(value)) >= 64)
+        continue;
+
+      double expected = std::pow((double) value, (double) y);
+      double error = std::fabs(FastMath::pow(value, y) - expected) / expected;
+      worst = max(worst, error);
+    }
+  }
+
+  printf("pow         worst error %.2g relative\n", worst);
+  CHECK(worst <= 3e-6);
+  CHECK(FastMath::pow(0, 2) == 0);
+  CHECK(FastMath::pow(-2, 2) == 0);
+}
+
+int main()
+{
+  testSin();
+  testSineTable();
+  testAtan2();
+  testSqrt();
+  testPow();
+  return checkResult();
+}
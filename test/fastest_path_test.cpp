@@ -0,0 +1,152 @@
+// Host tests for FastestPath, which must never pick a path that is expected
+// to be slower than the KnownPath route that speed runs used before it
+
+#include <Arduino.h>
+
+#include "fastest_path.cpp"
+#include "parser.cpp"
+#include "legacy_motion/MotionCalc.cpp"
+#include "legacy_motion/SCurveProfile.cpp"
+#include "legacy_motion/SweptTurnProfile.cpp"
+#include "check.h"
+
+static SpeedRunSettings settings()
+{
+  SpeedRunSettings settings;
+  settings.forward_velocity = 2;
+  settings.diag_velocity = 1.5;
+  settings.turn_velocity = 0.84;
+  settings.accel = 6;
+  settings.decel = -6;
+  return settings;
+}
+
+static float knownPathTime(Maze<16, 16>& maze, size_t finish_x,
+                           size_t finish_y)
+{
+  FloodFillPath<16, 16> flood_path(maze, 0, 0, finish_x, finish_y);
+  KnownPath<16, 16> known_path(maze, 0, 0, finish_x, finish_y, flood_path);
+  PathParser parser(&known_path);
+  return estimateRunTime(parser.getMoveList(), settings());
+}
+
+static float pathTime(Path<16, 16>& path)
+{
+  PathParser parser(&path);
+  return estimateRunTime(parser.getMoveList(), settings());
+}
+
+// Marks every box along the directions as visited, except the finish
+static void visit(Maze<16, 16>& maze, const uint8_t directions[], size_t length)
+{
+  size_t x = 0;
+  size_t y = 0;
+
+  maze.visit(x, y);
+  for (size_t i = 0; i + 1 < length; i++) {
+    step(x, y, (Compass8) directions[i]);
+    maze.visit(x, y);
+  }
+}
+
+// Random fully visited mazes, with enough walls that the depth first search
+// sometimes runs out of candidates before it gets to the route KnownPath
+// takes
+static void testNeverSlowerThanKnownPath()
+{
+  uint32_t seed = 1;
+  int solved = 0;
+
+  for (int i = 0; i < 300; i++) {
+    Maze<16, 16> maze;
+    uint32_t density = 2 + i % 8;
+
+    for (size_t x = 0; x < 16; x++) {
+      for (size_t y = 0; y < 16; y++) {
+        seed = seed * 1103515245 + 12345;
+        maze.visit(x, y);
+        if ((seed >> 8) % density == 0)
+          maze.addWall(x, y, kNorth);
+        if ((seed >> 24) % density == 0)
+          maze.addWall(x, y, kEast);
+      }
+    }
+
+    size_t finish_x = 7 + i % 2;
+    size_t finish_y = 7 + (i / 2) % 2;
+    FastestPath path(maze, 0, 0, finish_x, finish_y, settings());
+    float time = path.getEstimatedTime();
+
+    CHECK(path.getCandidateCount() <= 48);
+    if (time < 0)
+      continue;
+
+    // the estimate is the time of the route that was actually chosen
+    CHECK_NEAR(pathTime(path), time, 1e-4);
+
+    FloodFillPath<16, 16> flood_path(maze, 0, 0, finish_x, finish_y);
+    KnownPath<16, 16> known_path(maze, 0, 0, finish_x, finish_y, flood_path);
+    size_t x = 0;
+    size_t y = 0;
+    while (!known_path.isEmpty()) {
+      step(x, y, known_path.nextDirection());
+    }
+    if (x == finish_x && y == finish_y) {
+      CHECK(time <= knownPathTime(maze, finish_x, finish_y) + 1e-4);
+      solved++;
+    }
+  }
+
+  printf("%d of 300 mazes had a KnownPath route to compare with\n", solved);
+  CHECK(solved > 200);
+}
+
+// Two routes to (6, 6) through otherwise unvisited boxes: the shortest is a
+// staircase with a turn every two boxes, the other is two boxes longer with
+// two turns. The long straights are worth more than the extra distance.
+static void testFewerTurns()
+{
+  const uint8_t staircase[] = {
+    kEast, kEast, kNorth, kNorth, kEast, kEast, kNorth, kNorth,
+    kEast, kEast, kNorth, kNorth
+  };
+  const uint8_t straights[] = {
+    kNorth, kNorth, kNorth, kNorth, kNorth, kNorth, kNorth,
+    kEast, kEast, kEast, kEast, kEast, kEast, kSouth
+  };
+  const size_t kStairs = sizeof(staircase);
+  const size_t kStraights = sizeof(straights);
+
+  Maze<16, 16> maze;
+  visit(maze, staircase, kStairs);
+  visit(maze, straights, kStraights);
+
+  FastestPath path(maze, 0, 0, 6, 6, settings());
+  CandidatePath stairs_path(maze, 0, 0, 6, 6, staircase, kStairs);
+  CandidatePath straights_path(maze, 0, 0, 6, 6, straights, kStraights);
+  float stairs_time = pathTime(stairs_path);
+  float straights_time = pathTime(straights_path);
+
+  printf("staircase %.3f s, straights %.3f s, chosen %.3f s\n", stairs_time,
+         straights_time, path.getEstimatedTime());
+
+  CHECK(path.getCandidateCount() == 2);
+  CHECK(straights_time < stairs_time);
+  CHECK_NEAR(path.getEstimatedTime(), straights_time, 1e-4);
+
+  size_t length = 0;
+  bool same = true;
+  while (!path.isEmpty()) {
+    Compass8 dir = path.nextDirection();
+    same = same && length < kStraights && dir == straights[length];
+    length++;
+  }
+  CHECK(same && length == kStraights);
+}
+
+int main()
+{
+  testNeverSlowerThanKnownPath();
+  testFewerTurns();
+  return checkResult();
+}
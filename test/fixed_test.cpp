@@ -0,0 +1,214 @@
+// Host tests for the Q16 control path: Fixed, FixedMultiplier, and the
+// PIDController built with CONTROL_FIXED_POINT on and off
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "conf.h"
+#include "motion/Fixed.h"
+#include "check.h"
+
+// Both versions of the controller in one binary. Everything they include is
+// already included above, so only the class itself goes into the namespace.
+namespace float_pid {
+#include "legacy_motion/PIDController.cpp"
+}
+
+#undef PID_CONTROLLER_H
+#undef CONTROL_FIXED_POINT
+#define CONTROL_FIXED_POINT true
+
+namespace fixed_pid {
+#include "legacy_motion/PIDController.cpp"
+}
+
+static void testSaturation()
+{
+  const Q16 kMax = Q16::fromRaw(INT32_MAX);
+  const Q16 kMin = Q16::fromRaw(INT32_MIN);
+  const Q16 kTiny = Q16::fromRaw(1);
+
+  CHECK((kMax + kTiny).raw() == INT32_MAX);
+  CHECK((kMax + kMax).raw() == INT32_MAX);
+  CHECK((kMin - kTiny).raw() == INT32_MIN);
+  CHECK((kMin + kMin).raw() == INT32_MIN);
+  CHECK((kMax - kMin).raw() == INT32_MAX);
+  CHECK((kMin - kMax).raw() == INT32_MIN);
+  CHECK((-kMin).raw() == INT32_MAX);
+  CHECK((-kMax).raw() == -INT32_MAX);
+
+  CHECK((kMax * Q16::fromInt(2)).raw() == INT32_MAX);
+  CHECK((kMax * Q16::fromInt(-2)).raw() == INT32_MIN);
+  CHECK((kMin * kMin).raw() == INT32_MAX);
+  CHECK((kMax * 3).raw() == INT32_MAX);
+  CHECK((kMin * 3).raw() == INT32_MIN);
+  CHECK((kMin * -1).raw() == INT32_MAX);
+
+  CHECK((kMax / Q16::fromRaw(1)).raw() == INT32_MAX);
+  CHECK((kMin / Q16::fromRaw(1)).raw() == INT32_MIN);
+  CHECK((Q16::fromInt(1) / Q16()).raw() == INT32_MAX);
+  CHECK((Q16::fromInt(-1) / Q16()).raw() == INT32_MIN);
+  CHECK((Q16::fromInt(-1) / 0).raw() == INT32_MIN);
+
+  CHECK(Q16::fromInt(32767).raw() == 32767 * 65536);
+  CHECK(Q16::fromInt(32768).raw() == INT32_MAX);
+  CHECK(Q16::fromInt(-32768).raw() == INT32_MIN);
+  CHECK(Q16::fromInt(-32769).raw() == INT32_MIN);
+  CHECK(Q16::fromFloat(1e6f).raw() == INT32_MAX);
+  CHECK(Q16::fromFloat(-1e6f).raw() == INT32_MIN);
+  CHECK(Q16::fromFloat(-0.5f / 65536).raw() == -1);
+
+  // narrowing to fewer fractional bits can not overflow, widening can
+  CHECK(kMax.convert<8>().raw() == (INT32_MAX >> 8) + 1);
+  CHECK(Q16::fromInt(1000).convert<24>().raw() == INT32_MAX);
+  CHECK(Q16::fromInt(-1000).convert<24>().raw() == INT32_MIN);
+}
+
+static void testRoundedShift()
+{
+  // halves round away from zero, on both sides
+  CHECK(fixed::roundedShift(3, 1) == 2);
+  CHECK(fixed::roundedShift(-3, 1) == -2);
+  CHECK(fixed::roundedShift(-1, 1) == -1);
+  CHECK(fixed::roundedShift(-5, 2) == -1);
+  CHECK(fixed::roundedShift(-6, 2) == -2);
+  CHECK(fixed::roundedShift(-7, 2) == -2);
+  CHECK(fixed::roundedShift(-1, 16) == 0);
+  CHECK(fixed::roundedShift(-32768, 16) == -1);
+  CHECK(fixed::roundedShift(-32767, 16) == 0);
+
+  // a plain arithmetic shift would round these toward negative infinity
+  int mismatches = 0;
+  for (int shift = 1; shift <= 20; shift++) {
+    for (int64_t value = -5000; value <= 5000; value++) {
+      double exact = std::round((double) value / ((int64_t) 1 << shift));
+      if (fixed::roundedShift(value, shift) != exact)
+        mismatches++;
+    }
+  }
+  CHECK(mismatches == 0);
+
+  CHECK(Q16::fromFloat(-2.5f).toRoundedInt() == -3);
+  CHECK(Q16::fromFloat(-2.49f).toRoundedInt() == -2);
+  CHECK(Q16::fromFloat(-2.5f).toInt() == -3);
+  CHECK(Q16::fromFloat(-2.25f).toInt() == -3);
+
+  // the 64 bit products from multiplying two Q16 values
+  CHECK((Q16::fromFloat(-1.5f) * Q16::fromRaw(1)).raw() == -2);
+  CHECK((Q16::fromFloat(-0.5f) * Q16::fromRaw(1)).raw() == -1);
+  CHECK((Q16::fromFloat(-0.25f) * Q16::fromRaw(1)).raw() == 0);
+
+  // left shifts saturate instead of overflowing
+  CHECK(fixed::roundedShiftWide((int64_t) 1 << 40, -30) == (int64_t) 1 << 62);
+  CHECK(fixed::roundedShiftWide(-((int64_t) 1 << 40), -30)
+        == -((int64_t) 1 << 62));
+  CHECK(fixed::roundedShift(-((int64_t) 1 << 40), -2) == INT32_MIN);
+}
+
+static void testFixedMultiplier()
+{
+  const int64_t kMaxInput = (int64_t) 1 << 40;
+
+  // inputs past the clip all give the same answer
+  FixedMultiplier one(1.0f);
+  CHECK(one.applyWide(kMaxInput) == kMaxInput);
+  CHECK(one.applyWide(kMaxInput + 1) == kMaxInput);
+  CHECK(one.applyWide(INT64_MAX / 2) == kMaxInput);
+  CHECK(one.applyWide(-kMaxInput) == -kMaxInput);
+  CHECK(one.applyWide(-kMaxInput - 1) == -kMaxInput);
+  CHECK(one.applyWide(INT64_MIN / 2) == -kMaxInput);
+  CHECK(one.apply(kMaxInput) == INT32_MAX);
+  CHECK(one.apply(-kMaxInput) == INT32_MIN);
+
+  // the biggest gains at the clip still do not wrap around
+  FixedMultiplier huge(1e9f);
+  CHECK(huge.applyWide(kMaxInput) == (int64_t) 1 << 62);
+  CHECK(huge.applyWide(-kMaxInput) == -((int64_t) 1 << 62));
+  CHECK(huge.apply(kMaxInput) == INT32_MAX);
+  CHECK(huge.apply(-kMaxInput) == INT32_MIN);
+
+  FixedMultiplier negative(-KD_POSITION);
+  CHECK(negative.apply(kMaxInput) == INT32_MIN);
+  CHECK(negative.apply(-kMaxInput) == INT32_MAX);
+
+  // ki * error * dt for the gyro loop: a small gain on a big product
+  FixedMultiplier ki(KI_GYRO);
+  int64_t product = (int64_t) Q16::fromFloat(-300).raw() * 5000;
+  CHECK_NEAR(ki.applyWide(product), (double) product * KI_GYRO,
+             std::fabs(product * KI_GYRO) / (1 << 21) + 1);
+  CHECK(ki.applyWide(kMaxInput) == ki.applyWide(kMaxInput * 4));
+
+  // full precision across the range of gains in conf.h
+  const float kGains[] = {KP_POSITION, KD_POSITION, KP_GYRO, KI_GYRO,
+                          KP_RANGE, KD_RANGE, 0.0005f, 1e-9f, 1e9f};
+  for (float gain : kGains) {
+    FixedMultiplier multiplier(gain);
+    for (int32_t raw = -1000000; raw <= 1000000; raw += 9973) {
+      double exact = (double) raw * gain;
+      CHECK_NEAR(multiplier.applyWide(raw), exact,
+                 std::fabs(exact) / (1 << 21) + 1);
+    }
+  }
+
+  CHECK(FixedMultiplier(0).apply(kMaxInput) == 0);
+  CHECK(FixedMultiplier().apply(-kMaxInput) == 0);
+}
+
+// Runs the same error trace through both controllers. There is no recorded
+// trace in the tree, so this is a deterministic stand-in shaped like the
+// position loop in motion_forward(): a step in the target, the response
+// settling onto it with some overshoot, quantization from the encoders, and
+// jitter on the time step.
+static void comparePid(const char* name, float kp, float ki, float kd,
+                       float i_bound, float scale, float tolerance)
+{
+  float_pid::PIDController reference(kp, ki, kd, i_bound);
+  fixed_pid::PIDController fixed(kp, ki, kd, i_bound);
+
+  uint32_t seed = 12345;
+  float worst = 0;
+  float largest = 0;
+
+  for (int i = 0; i < 4000; i++) {
+    seed = seed * 1103515245 + 12345;
+    uint32_t dt = 950 + (seed >> 16) % 100;
+
+    float t = i * 0.001f;
+    float target = scale * (i < 200 ? 0 : i < 2200 ? 1 : -0.5f);
+    float settle = std::exp(-3 * std::fmod(t, 2.0f));
+    float current = target - scale * 0.8f * settle * std::cos(12 * t);
+    current = std::round(current * 20) / 20;
+
+    float expected = reference.Calculate(current, target, dt);
+    float actual = fixed.Calculate(current, target, dt);
+
+    float error = std::fabs(actual - expected);
+    if (error > worst)
+      worst = error;
+    if (std::fabs(expected) > largest)
+      largest = std::fabs(expected);
+  }
+
+  printf("%-8s largest output %10.3f, worst difference %.5f\n", name, largest,
+         worst);
+  CHECK(worst <= tolerance);
+}
+
+static void testPidController()
+{
+  // the output resolution is 1/65536, the rest is rounding in the gains
+  comparePid("position", KP_POSITION, KI_POSITION, KD_POSITION, 10000, 5,
+             0.002);
+  comparePid("gyro", KP_GYRO, KI_GYRO, KD_GYRO, 10000, 300, 0.001);
+  comparePid("range", KP_RANGE, KI_RANGE, KD_RANGE, 10000, 20, 0.002);
+  comparePid("bounded", KP_GYRO, KI_GYRO * 100, 0, 2, 300, 0.001);
+}
+
+int main()
+{
+  testSaturation();
+  testRoundedShift();
+  testFixedMultiplier();
+  testPidController();
+  return checkResult();
+}
@@ -0,0 +1,86 @@
+#ifndef MICROMOUSE_TEST_ARDUINO_H_
+#define MICROMOUSE_TEST_ARDUINO_H_
+
+// Just enough of the Teensy core for the host tests
+//
+// Only the calls that the code under test makes are here. Add to it as
+// tests need more. Pin writes do nothing and pin reads return 0, so tests
+// must feed hardware readings in some other way.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+using std::isnan;
+using std::max;
+using std::min;
+
+#define HIGH 1
+#define LOW 0
+
+#define A10 24
+#define A11 25
+#define A12 26
+#define A13 27
+#define A14 28
+
+#define constrain(amt, low, high) \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x) ((x) * (x))
+
+inline uint32_t micros()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void delayMicroseconds(uint32_t) {}
+inline int analogRead(uint8_t) { return 0; }
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+// Never fires on its own. Tests call fire() to run the callback of the
+// timer that was started last, as if it had ticked.
+class IntervalTimer
+{
+  private:
+    static void (*&callback())()
+    {
+      static void (*function)() = nullptr;
+      return function;
+    }
+
+  public:
+    bool begin(void (*function)(), float)
+    {
+      callback() = function;
+      return true;
+    }
+    void end() { callback() = nullptr; }
+    void priority(uint8_t) {}
+
+    static void fire()
+    {
+      if (callback())
+        callback()();
+    }
+};
+
+class elapsedMicros
+{
+  private:
+    uint32_t start_;
+
+  public:
+    elapsedMicros() : start_(micros()) {}
+    operator uint32_t() const { return micros() - start_; }
+    elapsedMicros& operator=(uint32_t value)
+    {
+      start_ = micros() - value;
+      return *this;
+    }
+};
+
+#endif
@@ -0,0 +1,81 @@
+// Host tests for PlaybackClock, driven by a ControlScheduler ticked by hand
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "motion/ControlScheduler.h"
+#include "motion/PlaybackClock.h"
+#include "check.h"
+
+#include "motion/ControlScheduler.cpp"
+#include "motion/PlaybackClock.cpp"
+
+// Runs cycles at the given rate, missing a tick every skip_every cycles,
+// and checks the playback time against the loop time after each one
+static void runCycles(float rate, int skip_every)
+{
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  PlaybackClock clock;
+  uint32_t worst_error = 0;
+
+  scheduler.start();
+
+  for (int cycle = 0; cycle < 5000; cycle++) {
+    IntervalTimer::fire();
+    if (skip_every > 0 && cycle % skip_every == skip_every - 1) {
+      IntervalTimer::fire();
+    }
+
+    uint32_t loop_time = scheduler.waitForCycle();
+    uint32_t playback_time = clock.advance(loop_time, rate);
+
+    uint32_t expected = (uint32_t) (loop_time * (double) rate);
+    uint32_t error = playback_time > expected ? playback_time - expected
+                                              : expected - playback_time;
+    worst_error = max(worst_error, error);
+  }
+
+  scheduler.stop();
+
+  printf("rate %.2f, a tick missed every %d cycles: %lu overruns, "
+         "worst error %lu us\n", rate, skip_every,
+         (unsigned long) scheduler.getOverruns(), (unsigned long) worst_error);
+
+  if (skip_every > 0) {
+    CHECK(scheduler.getOverruns() == (uint32_t) (5000 / skip_every));
+  }
+  CHECK(worst_error <= 1);
+}
+
+static void testFirstCycle()
+{
+  ControlScheduler& scheduler = ControlScheduler::getInstance();
+  PlaybackClock clock;
+
+  scheduler.start();
+
+  IntervalTimer::fire();
+  CHECK(clock.advance(scheduler.waitForCycle(), 1) == 0);
+
+  // an overrun on the second cycle
+  IntervalTimer::fire();
+  IntervalTimer::fire();
+  CHECK(clock.advance(scheduler.waitForCycle(), 1)
+        == 2 * scheduler.getPeriod());
+  CHECK(clock.getTime() == scheduler.getTime());
+
+  scheduler.stop();
+
+  clock.reset();
+  CHECK(clock.getTime() == 0);
+}
+
+int main()
+{
+  testFirstCycle();
+  runCycles(1, 0);
+  runCycles(1, 7);
+  runCycles(0.75, 7);
+  runCycles(0.33, 3);
+  return checkResult();
+}
@@ -0,0 +1,132 @@
+// Host test of the range table lookup against the formula it replaced
+//
+// Every raw reading goes through RangeSensor::translate() and is compared
+// with the a*(x-b)^c+d curve that RangeSensor evaluated before the tables,
+// clamped to 0-2880 mm the same way. Built twice: once against the
+// RangeTables.h in the tree, and once with RANGE_TEST_TABLES naming a table
+// generated by tools/make_range_table.py with a bigger step, to cover the
+// interpolation.
+
+#include <Arduino.h>
+#include <algorithm>
+#include <cmath>
+
+#ifdef RANGE_TEST_TABLES
+// takes the place of the RangeTables.h included by RangeSensor.cpp
+#include RANGE_TEST_TABLES
+#endif
+
+#include "device/RangeSensor.cpp"
+#include "check.h"
+
+// no background acquisition on the host, readings come from setRawReading()
+bool RangeAcquisition::getLatest(Sample& sample)
+{
+  return false;
+}
+
+int RangeAcquisition::channelForPin(int pin)
+{
+  return 0;
+}
+
+struct Translation {
+  float a1, b1, c1, d1;
+  float a2, b2, c2, d2;
+  float v0;
+  float e;
+};
+
+// RangeSensor::updateRange() before the tables, plus the clamp
+static int oldFormula(const Translation& constants, int raw)
+{
+  float sensed_distance;
+
+  if (raw < constants.v0) {
+    if (raw - constants.b1 < 0) {
+      sensed_distance = 2880;
+    } else {
+      sensed_distance = (constants.a1 * pow(raw - constants.b1, constants.c1)
+                         + constants.d1) + constants.e;
+    }
+  } else {
+    if (raw - constants.b2 < 0) {
+      sensed_distance = 2880;
+    } else {
+      sensed_distance = (constants.a2 * pow(raw - constants.b2, constants.c2)
+                         + constants.d2) + constants.e;
+    }
+  }
+
+  int distance = sensed_distance;
+  return constrain(distance, 0, 2880);
+}
+
+// mm per count of raw reading, above which the curve is too steep to
+// interpolate accurately
+static const int kSteep = 10;
+
+static int translate(RangeSensor& sensor, int raw)
+{
+  sensor.setRawReading(raw, 0);
+  return sensor.getRange();
+}
+
+static void testSensor(const char* name, int pin, const Translation& constants)
+{
+  RangeSensor sensor(pin, 0, 0);
+  int worst = 0;
+  int worst_flat = 0;
+
+  for (int raw = 0; raw <= RANGE_TABLE_MAX_READING; raw++) {
+    int expected = oldFormula(constants, raw);
+    int actual = translate(sensor, raw);
+    int error = abs(actual - expected);
+
+    if (error > worst)
+      worst = error;
+
+    int index = raw / RANGE_TABLE_STEP;
+    int low = oldFormula(constants, index * RANGE_TABLE_STEP);
+    int high = oldFormula(constants, (index + 1) * RANGE_TABLE_STEP);
+
+    if (raw % RANGE_TABLE_STEP == 0) {
+      // table entries are the formula itself, give or take float rounding
+      CHECK(error <= 1);
+    } else {
+      // between entries it is a straight line between the formula at the
+      // neighbouring entries
+      int fraction = raw % RANGE_TABLE_STEP;
+      double line = low + (double) (high - low) * fraction / RANGE_TABLE_STEP;
+      CHECK_NEAR(actual, line, 1);
+
+      // which is close to the curve, except at the low end where the curve
+      // is steep and bends too much for a straight line
+      if (abs(high - low) <= kSteep * RANGE_TABLE_STEP) {
+        if (error > worst_flat)
+          worst_flat = error;
+        CHECK(error <= 2);
+      }
+    }
+  }
+
+  // out of range readings pin to the ends of the table
+  CHECK(translate(sensor, -1) == translate(sensor, 0));
+  CHECK(translate(sensor, -1000) == translate(sensor, 0));
+  CHECK(translate(sensor, RANGE_TABLE_MAX_READING + 1)
+        == translate(sensor, RANGE_TABLE_MAX_READING));
+  CHECK(translate(sensor, 4096) == translate(sensor, RANGE_TABLE_MAX_READING));
+
+  printf("%-11s step %d, worst error %4d mm, %d mm where the curve is flat\n",
+         name, RANGE_TABLE_STEP, worst, worst_flat);
+}
+
+int main()
+{
+  testSensor("DIAG_LEFT", RANGE_DIAG_LEFT_PIN, RANGE_DIAG_LEFT_TRANSLATION);
+  testSensor("DIAG_RIGHT", RANGE_DIAG_RIGHT_PIN, RANGE_DIAG_RIGHT_TRANSLATION);
+  testSensor("FRONT_LEFT", RANGE_FRONT_LEFT_PIN, RANGE_FRONT_LEFT_TRANSLATION);
+  testSensor("FRONT_RIGHT", RANGE_FRONT_RIGHT_PIN,
+             RANGE_FRONT_RIGHT_TRANSLATION);
+  return checkResult();
+}
@@ -0,0 +1,166 @@
+// Host tests for SpscRing, including a producer and a consumer on two real
+// threads. Build with "make tsan" to run them under ThreadSanitizer.
+
+#include <cstdint>
+#include <thread>
+
+#include "device/SpscRing.h"
+#include "check.h"
+
+// Every field is derived from the sequence number, so a torn or stale item
+// shows up as a mismatch
+struct Item {
+  uint32_t sequence;
+  uint32_t words[7];
+
+  static Item make(uint32_t sequence)
+  {
+    Item item;
+    item.sequence = sequence;
+    for (int i = 0; i < 7; i++) {
+      item.words[i] = sequence * 2654435761u + i;
+    }
+    return item;
+  }
+
+  bool matches(uint32_t expected) const
+  {
+    if (sequence != expected)
+      return false;
+    for (int i = 0; i < 7; i++) {
+      if (words[i] != expected * 2654435761u + i)
+        return false;
+    }
+    return true;
+  }
+};
+
+static void testSingleThread()
+{
+  SpscRing<uint32_t, 8> ring;
+  uint32_t value;
+
+  CHECK(ring.capacity() == 8);
+  CHECK(ring.empty());
+  CHECK(!ring.pop(value));
+
+  // fills up and refuses the next item without overwriting
+  for (uint32_t i = 0; i < 8; i++) {
+    CHECK(ring.push(i));
+  }
+  CHECK(ring.size() == 8);
+  CHECK(!ring.push(100));
+
+  for (uint32_t i = 0; i < 8; i++) {
+    CHECK(ring.pop(value));
+    CHECK(value == i);
+  }
+  CHECK(ring.empty());
+
+  // indexes keep counting past the end of the storage
+  for (uint32_t i = 0; i < 1000; i++) {
+    CHECK(ring.push(i));
+    CHECK(ring.push(i + 1));
+    CHECK(ring.pop(value));
+    CHECK(value == i);
+    CHECK(ring.pop(value));
+    CHECK(value == i + 1);
+  }
+
+  ring.push(1);
+  ring.push(2);
+  ring.clear();
+  CHECK(ring.empty());
+  CHECK(!ring.pop(value));
+}
+
+// Producer and consumer as fast as they will go, with a small ring so that
+// it is full and empty many times over
+static void testTwoThreads()
+{
+  static SpscRing<Item, 16> ring;
+  const uint32_t kCount = 200000;
+  uint32_t full = 0;
+
+  std::thread producer([&] {
+    uint32_t next = 0;
+    while (next < kCount) {
+      if (ring.push(Item::make(next))) {
+        next++;
+      } else {
+        full++;
+        // the host may only have one core
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  uint32_t mismatches = 0;
+  Item item;
+  while (expected < kCount) {
+    if (ring.pop(item)) {
+      if (!item.matches(expected))
+        mismatches++;
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+
+  CHECK(mismatches == 0);
+  CHECK(ring.empty());
+  printf("%u items, ring full %u times\n", kCount, full);
+}
+
+// The consumer throws away the backlog now and then, like
+// ImuAcquisition::flush(). Items must still arrive in order and intact.
+static void testClearWhileProducing()
+{
+  static SpscRing<Item, 16> ring;
+  const uint32_t kCount = 100000;
+
+  std::thread producer([&] {
+    uint32_t next = 0;
+    while (next < kCount) {
+      if (ring.push(Item::make(next))) {
+        next++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t last = 0;
+  bool has_last = false;
+  uint32_t bad = 0;
+  uint32_t pops = 0;
+  Item item;
+  while (!has_last || last < kCount - 1) {
+    if (ring.pop(item)) {
+      uint32_t sequence = item.sequence;
+      if (!item.matches(sequence) || (has_last && sequence <= last))
+        bad++;
+      last = sequence;
+      has_last = true;
+      if (++pops % 97 == 0)
+        ring.clear();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+
+  CHECK(bad == 0);
+}
+
+int main()
+{
+  testSingleThread();
+  testTwoThreads();
+  testClearWhileProducing();
+  return checkResult();
+}
@@ -0,0 +1,148 @@
+// Host test of TrajectoryTable lookups between entries
+//
+// Two jerk limited straights are compiled into a table at the usual tick the
+// same way TrajectoryExecutor does it, with the boundary between them inside
+// a tick, and looked up every 100 us. Between entries the setpoints must stay
+// close to the profiles, and the acceleration and velocity fed forward to the
+// motors must not step.
+
+#include <Arduino.h>
+
+#include "legacy_motion/SCurveProfile.cpp"
+#include "motion/TrajectoryTable.cpp"
+#include "check.h"
+
+static TrajectoryTable table;
+
+static const float kAccel = 6;
+static const float kDecel = -6;
+static const float kJerk = MAX_JERK_STRAIGHT;
+
+// microseconds between lookups
+static const uint32_t kStep = 100;
+
+struct Straights {
+  SCurveProfile first;
+  SCurveProfile second;
+  float first_distance;
+
+  Straights()
+      : first(265, 2, 0, 1, kAccel, kDecel, kJerk),
+        second(450, 2, 1, 0, kAccel, kDecel, kJerk), first_distance(265)
+  {
+  }
+
+  void getState(uint32_t time, float* distance, float* velocity,
+                float* accel) const
+  {
+    if (time < first.getTotalTime()) {
+      first.getState(time, distance, velocity, accel);
+    } else {
+      second.getState(time - first.getTotalTime(), distance, velocity, accel);
+      *distance += first_distance;
+    }
+  }
+
+  uint32_t getTotalTime() const
+  {
+    return first.getTotalTime() + second.getTotalTime();
+  }
+};
+
+static void compile(const Straights& straights)
+{
+  uint32_t tick = TRAJECTORY_TICK_US;
+  table.clear(tick);
+
+  for (uint32_t time = 0; time < straights.getTotalTime() + tick;
+       time += tick) {
+    TrajectorySetpoint setpoint;
+    straights.getState(min(time, straights.getTotalTime()),
+                       &setpoint.distance, &setpoint.velocity,
+                       &setpoint.accel);
+    setpoint.offset = setpoint.distance / 4;
+    setpoint.offset_velocity = setpoint.velocity / 4;
+    setpoint.offset_accel = setpoint.accel / 4;
+    setpoint.heading = 0;
+    setpoint.type = 'f';
+    CHECK(table.add(setpoint));
+  }
+}
+
+static void testBetweenEntries()
+{
+  Straights straights;
+  compile(straights);
+
+  // the boundary between the straights is inside a tick
+  CHECK(straights.first.getTotalTime() % TRAJECTORY_TICK_US != 0);
+
+  TrajectorySetpoint last;
+  table.lookup(0, last);
+
+  float worst_distance = 0, worst_velocity = 0, worst_accel = 0;
+  float worst_velocity_step = 0, worst_accel_step = 0;
+  float worst_slope = 0;
+
+  for (uint32_t time = kStep; time <= table.getTotalTime(); time += kStep) {
+    TrajectorySetpoint setpoint;
+    table.lookup(time, setpoint);
+
+    float distance, velocity, accel;
+    straights.getState(min(time, straights.getTotalTime()), &distance,
+                       &velocity, &accel);
+
+    worst_distance = max(worst_distance, fabsf(setpoint.distance - distance));
+    worst_velocity = max(worst_velocity, fabsf(setpoint.velocity - velocity));
+    worst_accel = max(worst_accel, fabsf(setpoint.accel - accel));
+
+    worst_velocity_step = max(worst_velocity_step,
+                              fabsf(setpoint.velocity - last.velocity));
+    worst_accel_step = max(worst_accel_step,
+                           fabsf(setpoint.accel - last.accel));
+
+    CHECK_NEAR(setpoint.offset, setpoint.distance / 4, 0.01);
+    // velocities and accelerations are stored to 1 mm/s and 1 mm/s/s
+    CHECK_NEAR(setpoint.offset_velocity, setpoint.velocity / 4, 0.003);
+    CHECK_NEAR(setpoint.offset_accel, setpoint.accel / 4, 0.003);
+
+    last = setpoint;
+  }
+
+  // The velocity is the slope of the positions it is looked up with. Over a
+  // millisecond, so that positions rounded to 1/1024 mm do not matter.
+  table.lookup(0, last);
+  for (uint32_t time = 1000; time <= table.getTotalTime(); time += 1000) {
+    TrajectorySetpoint setpoint;
+    table.lookup(time, setpoint);
+
+    float slope = (setpoint.distance - last.distance) / 1000 * 1000;
+    float mean_velocity = (setpoint.velocity + last.velocity) / 2;
+    worst_slope = max(worst_slope, fabsf(slope - mean_velocity));
+
+    last = setpoint;
+  }
+
+  printf("worst error %.3f mm, %.4f m/s, %.3f m/s/s\n", worst_distance,
+         worst_velocity, worst_accel);
+  printf("worst change in %u us %.4f m/s, %.4f m/s/s\n", kStep,
+         worst_velocity_step, worst_accel_step);
+  printf("velocity off the position slope by %.4f m/s\n", worst_slope);
+
+  CHECK(worst_distance <= 0.05);
+  CHECK(worst_velocity <= 0.01);
+
+  // linear between entries, so off by at most half a tick of jerk
+  CHECK(worst_accel <= kJerk * TRAJECTORY_TICK_US / 1e6 / 2 + 0.01);
+
+  // no more than the jerk limit allows, plus rounding to 1 mm/s/s
+  CHECK(worst_accel_step <= kJerk * kStep / 1e6 + 0.002);
+  CHECK(worst_velocity_step <= kAccel * kStep / 1e6 + 0.002);
+  CHECK(worst_slope <= 0.005);
+}
+
+int main()
+{
+  testBetweenEntries();
+  return checkResult();
+}
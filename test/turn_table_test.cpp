@@ -0,0 +1,152 @@
+// Host test of the swept turn tables against the closed form in
+// doc/swept_turn_math
+//
+// The closed form is worked out again here in double precision, the same way
+// SweptTurnProfile did before the tables, and compared with the interpolated
+// tables at many times between each pair of entries.
+
+#include <algorithm>
+#include <cmath>
+
+#include "legacy_motion/SweptTurnProfile.cpp"
+#include "check.h"
+
+// tables are checked this many times finer than their step
+static const int kOversampling = 16;
+
+class ClosedForm {
+ public:
+  double turn_angle;
+  double inside_trigs;
+  double omega_max;
+  double acceleration_duration;
+  double const_velocity_duration;
+  double duration;
+
+  ClosedForm(double speed, double angle_deg)
+  {
+    turn_angle = angle_deg * M_PI / 180;
+    inside_trigs = ROBOT_MASS * (MM_BETWEEN_WHEELS / 2.0 / 1000.0) * speed
+                   / MOMENT_OF_INERTIA;
+    omega_max = MAX_COEFFICIENT_FRICTION * 9.81 / speed;
+
+    if (omega_max / inside_trigs > turn_angle / 2) {
+      // not long enough to reach omega_max
+      double temp = (turn_angle / 2) * inside_trigs / omega_max;
+      acceleration_duration = std::acos(1 - temp) / inside_trigs;
+      const_velocity_duration = 0;
+    } else {
+      acceleration_duration = (M_PI / 2) / inside_trigs;
+      const_velocity_duration = (turn_angle - 2 * omega_max / inside_trigs)
+                                / omega_max;
+    }
+
+    duration = 2 * acceleration_duration + const_velocity_duration;
+  }
+
+  // angle, angular velocity and angular acceleration at t
+  void evaluate(double t, double& angle, double& velocity, double& accel) const
+  {
+    t = std::max(0.0, std::min(duration, t));
+
+    if (t <= acceleration_duration) {
+      accelerating(t, angle, velocity, accel);
+    } else if (t <= acceleration_duration + const_velocity_duration) {
+      accelerating(acceleration_duration, angle, velocity, accel);
+      angle += velocity * (t - acceleration_duration);
+      accel = 0;
+    } else {
+      accelerating(duration - t, angle, velocity, accel);
+      angle = turn_angle - angle;
+      accel = -accel;
+    }
+  }
+
+ private:
+  void accelerating(double t, double& angle, double& velocity,
+                    double& accel) const
+  {
+    double k = inside_trigs;
+    angle = (1 - std::cos(k * t)) * omega_max / k;
+    velocity = omega_max * std::sin(k * t);
+    accel = omega_max * k * std::cos(k * t);
+  }
+};
+
+static void testTurn(const char* name, const SweptTurnProfile& profile,
+                     double speed, double angle_deg)
+{
+  ClosedForm exact(speed, angle_deg);
+
+  CHECK(profile.getTotalAngle() == (float) angle_deg);
+  CHECK_NEAR(profile.getTotalTime(), exact.duration, 1e-6);
+
+  double step = exact.duration / (SWEPT_TURN_TABLE_SIZE - 1);
+
+  // The acceleration has corners where the turn stops accelerating and
+  // starts decelerating, with or without a constant velocity section in
+  // between. Turns too short to reach omega_max, like the 45, also step from
+  // accelerating to decelerating in the middle. Within one table entry of
+  // these the interpolation cuts across the corner, so it can be off by as
+  // much as the step plus half of what the acceleration can change over one
+  // entry.
+  double corners[] = {
+    exact.acceleration_duration,
+    exact.acceleration_duration + exact.const_velocity_duration
+  };
+  double accel_step = 0;
+  if (exact.const_velocity_duration == 0) {
+    double angle, velocity, accel;
+    exact.evaluate(exact.acceleration_duration, angle, velocity, accel);
+    accel_step = 2 * accel;
+  }
+  double jerk = exact.omega_max * exact.inside_trigs * exact.inside_trigs;
+  double corner_tolerance = std::fabs(accel_step) + jerk * step / 2;
+
+  double worst_angle = 0, worst_velocity = 0, worst_accel = 0;
+  double worst_accel_at_corner = 0;
+
+  // a little past both ends as well, where the first and last entries hold
+  int samples = (SWEPT_TURN_TABLE_SIZE - 1) * kOversampling;
+  for (int i = -kOversampling; i <= samples + kOversampling; i++) {
+    double t = i * step / kOversampling;
+    double angle, velocity, accel;
+    exact.evaluate(t, angle, velocity, accel);
+
+    double angle_error = std::fabs(profile.getAngle(t) - angle);
+    double velocity_error = std::fabs(profile.getAngularVelocity(t) - velocity);
+    double accel_error = std::fabs(profile.getAngularAcceleration(t) - accel);
+
+    worst_angle = std::max(worst_angle, angle_error);
+    worst_velocity = std::max(worst_velocity, velocity_error);
+
+    if (std::fabs(t - corners[0]) < step || std::fabs(t - corners[1]) < step) {
+      worst_accel_at_corner = std::max(worst_accel_at_corner, accel_error);
+    } else {
+      worst_accel = std::max(worst_accel, accel_error);
+    }
+  }
+
+  printf("%-4s %.4f s, max error %.4f deg, %.4f rad/s, %.3f rad/s/s, "
+         "%.2f of %.2f rad/s/s at the corners\n", name, exact.duration,
+         worst_angle * 180 / M_PI, worst_velocity, worst_accel,
+         worst_accel_at_corner, corner_tolerance);
+
+  CHECK(worst_angle * 180 / M_PI <= 0.005);
+  CHECK(worst_velocity <= 0.003);
+  CHECK(worst_accel <= 0.1);
+  CHECK(worst_accel_at_corner <= corner_tolerance);
+}
+
+int main()
+{
+  testTurn("45", turn_45_table, SWEPT_TURN_45_FORWARD_SPEED,
+           SWEPT_TURN_45_ANGLE);
+  testTurn("90", turn_90_table, SWEPT_TURN_90_FORWARD_SPEED,
+           SWEPT_TURN_90_ANGLE);
+  testTurn("135", turn_135_table, SWEPT_TURN_135_FORWARD_SPEED,
+           SWEPT_TURN_135_ANGLE);
+  testTurn("180", turn_180_table, SWEPT_TURN_180_FORWARD_SPEED,
+           SWEPT_TURN_180_ANGLE);
+  return checkResult();
+}
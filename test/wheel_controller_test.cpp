@@ -0,0 +1,91 @@
+// Host tests for WheelController, with the encoder readings set by the test
+
+#include <Arduino.h>
+#include <cstdint>
+
+#include "conf.h"
+#include "motion/WheelController.h"
+#include "check.h"
+
+// mm, as the encoders would read them
+static float encoder_left = 0;
+static float encoder_right = 0;
+
+float enc_left_front_extrapolate() { return encoder_left; }
+float enc_left_back_extrapolate() { return encoder_left; }
+float enc_right_front_extrapolate() { return encoder_right; }
+float enc_right_back_extrapolate() { return encoder_right; }
+
+#include "motion/WheelController.cpp"
+
+static const uint32_t kTimeStep = 1000000 / CONTROL_LOOP_RATE_HZ;
+
+// Holds the wheels still on their setpoints, then shifts the encoders by one
+// count as Odometry::shiftEncoders() does and checks that the controllers
+// only answer with the proportional term. shift_first has the shift before
+// the encoders are read, as in the motion.cpp loops, otherwise after, as in
+// TrajectoryExecutor.
+static void testShift(bool shift_first)
+{
+  WheelController wheels(KP_POSITION, KI_POSITION, KD_POSITION);
+  WheelController unshifted(KP_POSITION, KI_POSITION, KD_POSITION);
+  const float setpoint = 100;
+
+  encoder_left = encoder_right = setpoint;
+  for (int i = 0; i < 3; i++) {
+    wheels.readEncoders();
+    wheels.update(setpoint, setpoint, kTimeStep);
+    unshifted.readEncoders();
+    unshifted.update(setpoint, setpoint, kTimeStep);
+  }
+  CHECK_NEAR(wheels.getCorrection(WheelController::kLeftFront), 0, 0.01);
+
+  const float shift = MM_PER_STEP;
+  const float proportional = -KP_POSITION * shift;
+  const float kick = -KD_POSITION * shift / kTimeStep;
+
+  for (int i = 0; i < 3; i++) {
+    if (i == 0 && shift_first) {
+      encoder_left += shift;
+      encoder_right += shift;
+      wheels.shift(shift, shift);
+    }
+
+    wheels.readEncoders();
+    unshifted.readEncoders();
+
+    if (i == 0 && !shift_first) {
+      encoder_left += shift;
+      encoder_right += shift;
+      wheels.shift(shift, shift);
+    }
+
+    wheels.update(setpoint, setpoint, kTimeStep);
+    unshifted.update(setpoint, setpoint, kTimeStep);
+
+    for (int wheel = 0; wheel < WheelController::kNumWheels; wheel++) {
+      CHECK_NEAR(wheels.getCorrection((WheelController::Wheel) wheel),
+                 proportional, 0.2);
+      CHECK_NEAR(wheels.getPosition((WheelController::Wheel) wheel),
+                 setpoint + shift, 1e-4);
+    }
+
+    // without shift() the derivative kicks on the first reading of the
+    // shifted encoders
+    if (i == (shift_first ? 0 : 1)) {
+      CHECK_NEAR(unshifted.getCorrection(WheelController::kLeftFront),
+                 proportional + kick, 0.2);
+    }
+  }
+
+  printf("shift %s reading: %.3f mm, correction %.3f, %.3f without shift()\n",
+         shift_first ? "before" : "after", shift, proportional,
+         proportional + kick);
+}
+
+int main()
+{
+  testShift(true);
+  testShift(false);
+  return checkResult();
+}
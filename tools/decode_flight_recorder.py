@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+
+'''
+Script for turning a flight recorder dump into CSV
+
+After freakOut the robot waits for the OK button and then writes the flight
+recorder to the USB serial port as binary (see Logger.h). Capture it to a file
+with anything that saves raw bytes, for example
+
+    cat /dev/ttyACM0 > crash.bin
+
+and decode it with this script. Anything before the "FREC" marker is skipped.
+Times are printed in milliseconds from the first record, and accelerations in
+m/s/s.
+
+Usage: python decode_flight_recorder.py <dump file name> [csv file name]
+'''
+
+from __future__ import print_function
+
+__license__ = 'GPLv2'
+
+import struct
+import sys
+
+MAGIC = b'FREC'
+VERSION = 1  # Logger::kVersion
+
+HEADER = struct.Struct('<4sBBI')
+# Logger::Record
+RECORD = struct.Struct('<IffffhhhB')
+CHECKSUM = struct.Struct('<H')
+
+COLUMNS = ['time', 'motion_type', 'forward_accel', 'radial_accel', 'gyro',
+           'heading', 'primary_pid', 'secondary_pid', 'tertiary_pid']
+
+def read_records(data):
+    '''Returns the records in a dump as tuples in COLUMNS order'''
+    start = data.find(MAGIC)
+    if start < 0:
+        raise ValueError('no flight recorder dump found')
+
+    magic, version, record_size, count = HEADER.unpack_from(data, start)
+    if version != VERSION:
+        raise ValueError('dump is version %d, expected %d' % (version, VERSION))
+    if record_size != RECORD.size:
+        raise ValueError('records are %d bytes, expected %d'
+                         % (record_size, RECORD.size))
+
+    body_start = start + HEADER.size
+    body_end = body_start + count * RECORD.size
+    if body_end + CHECKSUM.size > len(data):
+        raise ValueError('dump is cut short, %d of %d records'
+                         % ((len(data) - body_start) // RECORD.size, count))
+
+    body = bytearray(data[body_start:body_end])
+    checksum, = CHECKSUM.unpack_from(data, body_end)
+    if sum(body) & 0xffff != checksum:
+        raise ValueError('checksum does not match')
+
+    records = []
+    first_time = None
+    for i in range(count):
+        (time, heading, primary, secondary, tertiary, forward, radial, gyro,
+         motion_type) = RECORD.unpack_from(body, i * RECORD.size)
+        if first_time is None:
+            first_time = time
+        # micros() wraps around every 71 minutes
+        elapsed = ((time - first_time) & 0xffffffff) / 1000.0
+        records.append((elapsed, chr(motion_type), forward / 100.0,
+                        radial / 100.0, gyro, heading, primary, secondary,
+                        tertiary))
+    return records
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    with open(sys.argv[1], 'rb') as f:
+        records = read_records(f.read())
+
+    out = open(sys.argv[2], 'w') if len(sys.argv) > 2 else sys.stdout
+    print(','.join(COLUMNS), file=out)
+    for record in records:
+        print('%.3f,%s,%.2f,%.2f,%d,%.3f,%g,%g,%g' % record, file=out)
+    if out is not sys.stdout:
+        out.close()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+
+'''
+Script for fitting the motor feedforward to a drivetrain identification log
+
+Does the same fit as DrivetrainFit on the robot, to a log saved from the
+serial output of SYID in the options menu. Fits the voltage applied to each
+motor to
+
+    ks * sign(v) + kv * v + ka * a
+
+where v is the mean wheel velocity and a is its centered difference. Only
+samples where the motors are driven and faster than the minimum velocity are
+used. Prints ks, kv and ka along with the raw values PersistantStorage keeps.
+
+Usage: python fit_drivetrain.py <log file name> [min velocity]
+'''
+
+from __future__ import print_function
+
+__license__ = 'GPLv2'
+
+import sys
+
+import numpy as np
+
+STORAGE_DIGITS = 4  # PERSISTANT_STORAGE_DRIVETRAIN_DIGITS
+DEFAULT_MIN_VELOCITY = 0.05  # SYSID_MIN_VELOCITY, m/s
+
+def read_log(file_name):
+    rows = []
+    with open(file_name) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#') or line.startswith('time'):
+                continue
+            rows.append([float(field) for field in line.split(',')])
+    return np.array(rows)
+
+def fit_rows(log, min_velocity):
+    '''Returns the rows of the least squares problem and the voltages'''
+    time, duty, volts, velocity = log.T
+
+    rows = []
+    targets = []
+    start = 0
+    while start < len(log):
+        # one step, at a single duty cycle
+        end = start
+        while end < len(log) and duty[end] == duty[start]:
+            end += 1
+
+        if duty[start] != 0:
+            for i in range(start + 1, end - 1):
+                dt = (time[i + 1] - time[i - 1]) / 1e6
+                accel = (velocity[i + 1] - velocity[i - 1]) / dt
+                if abs(velocity[i]) >= min_velocity:
+                    rows.append([np.sign(velocity[i]), velocity[i], accel])
+                    targets.append(volts[i])
+        start = end
+
+    return np.array(rows), np.array(targets)
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    min_velocity = DEFAULT_MIN_VELOCITY
+    if len(sys.argv) > 2:
+        min_velocity = float(sys.argv[2])
+
+    rows, targets = fit_rows(read_log(sys.argv[1]), min_velocity)
+    (ks, kv, ka), _, _, _ = np.linalg.lstsq(rows, targets, rcond=None)
+    rms = np.sqrt(np.mean((rows.dot([ks, kv, ka]) - targets)**2))
+
+    print('samples:', len(targets))
+    print('static:   %.4f V' % ks)
+    print('velocity: %.4f V/(m/s)' % kv)
+    print('accel:    %.4f V/(m/s^2)' % ka)
+    print('rms:      %.4f V' % rms)
+    print('raw:', ' '.join(str(int(k * 10**STORAGE_DIGITS + 0.5))
+                           for k in (ks, kv, ka)))
+
+if __name__ == '__main__':
+    main()
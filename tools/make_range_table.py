@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+
+'''
+Script for generating rangefinder lookup tables
+
+Reads the RANGE_*_TRANSLATION constants from conf.h and evaluates the same
+piecewise a*(x-b)**c + d curve that fit_range.py fits, at every STEP counts of
+raw reading, clamped to 0-2880 mm. The tables are written to
+src/device/RangeTables.h, along with a copy of the constants they came from so
+that the firmware refuses to build against a stale table.
+
+Prints the worst case difference between the interpolated table and the
+formula, in mm, for every sensor.
+
+Run again after changing the translation constants. The step can be given on
+the command line to try a smaller table without editing the script, which is
+how test/range_sensor_test.cpp checks the interpolation.
+
+Usage: python make_range_table.py [path to conf.h] [path to RangeTables.h]
+                                  [step]
+'''
+
+from __future__ import print_function
+
+__license__ = 'GPLv2'
+
+import os
+import re
+import sys
+
+SENSORS = ['DIAG_LEFT', 'DIAG_RIGHT', 'FRONT_LEFT', 'FRONT_RIGHT']
+
+# raw readings are on minus off readings of a 10 bit ADC
+MAX_READING = 1023
+
+# table entries are this many counts apart, must be a power of two. Anything
+# above 1 makes RangeSensor interpolate, at the cost of accuracy at the low end
+# where the curve is steep.
+STEP = 1
+
+# distance for readings that do not make sense, same as RangeSensor
+NO_READING = 2880
+
+
+def load_constants(conf_path):
+    with open(conf_path) as conf_file:
+        conf = conf_file.read()
+
+    constants = {}
+    for sensor in SENSORS:
+        match = re.search(r'#define\s+RANGE_%s_TRANSLATION\s*\{([^}]*)\}'
+                          % sensor, conf)
+        if not match:
+            raise ValueError('RANGE_%s_TRANSLATION not found' % sensor)
+        text = [v.strip() for v in match.group(1).split(',')]
+        constants[sensor] = (text, [float(v) for v in text])
+
+    return constants
+
+
+def formula(x, constants):
+    a1, b1, c1, d1, a2, b2, c2, d2, v0, e = constants
+
+    if x < v0:
+        if x - b1 < 0:
+            return NO_READING
+        return a1 * (x - b1)**c1 + d1 + e
+    else:
+        if x - b2 < 0:
+            return NO_READING
+        return a2 * (x - b2)**c2 + d2 + e
+
+
+def clamp(distance):
+    # RangeSensor truncates the distance to an int
+    return int(max(0, min(NO_READING, distance)))
+
+
+def interpolate(table, x, step):
+    index = x // step
+    fraction = x % step
+    if fraction == 0:
+        return table[index]
+    # same as RangeSensor, which rounds toward zero
+    return table[index] + int(float((table[index + 1] - table[index])
+                                    * fraction) / step)
+
+
+def make_table(constants, step):
+    return [clamp(formula(x, constants))
+            for x in range(0, MAX_READING + step + 1, step)]
+
+
+def main(conf_path, header_path, step=STEP):
+    if step < 1 or step & (step - 1):
+        raise ValueError('step must be a power of two, not %d' % step)
+
+    constants = load_constants(conf_path)
+
+    lines = [
+        '#ifndef MICROMOUSE_RANGE_TABLES_H_',
+        '#define MICROMOUSE_RANGE_TABLES_H_',
+        '',
+        '// Generated by tools/make_range_table.py from conf.h, do not edit',
+        '',
+        '#include <Arduino.h>',
+        '',
+        '#define RANGE_TABLE_STEP %d' % step,
+        '#define RANGE_TABLE_MAX_READING %d' % MAX_READING,
+        '#define RANGE_TABLE_SIZE %d' % (MAX_READING // step + 2),
+        '',
+    ]
+
+    for sensor in SENSORS:
+        text, values = constants[sensor]
+        table = make_table(values, step)
+
+        worst = 0
+        for x in range(MAX_READING + 1):
+            exact = clamp(formula(x, values))
+            worst = max(worst, abs(interpolate(table, x, step) - exact))
+        print('%s: %d entries, max error %d mm' % (sensor, len(table), worst))
+
+        lines.append('#define RANGE_%s_TABLE_SOURCE { %s }'
+                     % (sensor, ', '.join(text)))
+        lines.append('static const uint16_t RANGE_%s_TABLE[RANGE_TABLE_SIZE] = {'
+                     % sensor)
+        for i in range(0, len(table), 12):
+            lines.append('  ' + ', '.join('%d' % d for d in table[i:i + 12])
+                         + ',')
+        lines.append('};')
+        lines.append('')
+
+    lines.append('#endif')
+
+    with open(header_path, 'w') as header:
+        header.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+    conf_path = os.path.join(root, 'src', 'conf.h')
+    header_path = os.path.join(root, 'src', 'device', 'RangeTables.h')
+
+    if len(sys.argv) > 1:
+        conf_path = sys.argv[1]
+    if len(sys.argv) > 2:
+        header_path = sys.argv[2]
+    step = STEP
+    if len(sys.argv) > 3:
+        step = int(sys.argv[3])
+
+    main(conf_path, header_path, step)
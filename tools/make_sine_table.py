@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+
+'''
+Script for generating the FastMath sine table
+
+Evaluates sin over one full turn at 2^BITS evenly spaced phases, with the
+first entry repeated at the end so that FastMath::sinPhase() can interpolate
+past the last one without wrapping the index. The values are rounded to
+single precision and written to src/legacy_motion/SineTable.h as the
+definition of FastMath::sine_table_, so that the table is const and stays in
+flash instead of being filled in RAM at startup.
+
+Prints the worst case difference between the interpolated table and sin.
+
+Run again after changing kSineTableBits in FastMath.h, which refuses to build
+against a table of another size.
+
+Usage: python make_sine_table.py [path to SineTable.h] [bits]
+'''
+
+from __future__ import print_function
+
+__license__ = 'GPLv2'
+
+import math
+import os
+import struct
+import sys
+
+# log2 of the number of entries in a full turn, same as kSineTableBits
+BITS = 9
+
+
+def to_float(value):
+    # round to the float the firmware will see
+    return struct.unpack('f', struct.pack('f', value))[0]
+
+
+def float_literal(value):
+    # enough digits to get the same float back
+    text = '%.9g' % value
+    if '.' not in text and 'e' not in text:
+        text += '.0'
+    return text + 'f'
+
+
+def make_table(bits):
+    size = 1 << bits
+    return [to_float(math.sin(2 * math.pi * i / size)) for i in range(size)] \
+        + [0.0]
+
+
+def worst_error(table, bits):
+    size = 1 << bits
+    worst = 0
+    for i in range(size):
+        for j in range(16):
+            fraction = j / 16.0
+            value = table[i] + (table[i + 1] - table[i]) * fraction
+            exact = math.sin(2 * math.pi * (i + fraction) / size)
+            worst = max(worst, abs(value - exact))
+    return worst
+
+
+def main(header_path, bits=BITS):
+    table = make_table(bits)
+    print('%d entries, max error %.2g' % (len(table),
+                                          worst_error(table, bits)))
+
+    lines = [
+        '#ifndef MICROMOUSE_SINE_TABLE_H_',
+        '#define MICROMOUSE_SINE_TABLE_H_',
+        '',
+        '// Generated by tools/make_sine_table.py, do not edit',
+        '//',
+        '// Defines FastMath::sine_table_, so only FastMath.cpp includes it',
+        '',
+        '#include "FastMath.h"',
+        '',
+        '#define SINE_TABLE_BITS %d' % bits,
+        '',
+        'const float FastMath::sine_table_[FastMath::kSineTableSize + 1] = {',
+    ]
+
+    for i in range(0, len(table), 4):
+        lines.append('  ' + ', '.join(float_literal(v)
+                                      for v in table[i:i + 4]) + ',')
+
+    lines.append('};')
+    lines.append('')
+    lines.append('#endif')
+
+    with open(header_path, 'w') as header:
+        header.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+    header_path = os.path.join(root, 'src', 'legacy_motion', 'SineTable.h')
+
+    if len(sys.argv) > 1:
+        header_path = sys.argv[1]
+    bits = BITS
+    if len(sys.argv) > 2:
+        bits = int(sys.argv[2])
+
+    main(header_path, bits)
@@ -0,0 +1,204 @@
+#!/usr/bin/env python
+
+'''
+Script for generating swept turn lookup tables
+
+Reads the robot and SWEPT_TURN_* constants from conf.h and evaluates the
+closed form turn profile from doc/swept_turn_math,
+
+    theta(t) = eta * (1 - cos(t / t0))
+
+with a constant angular velocity section in the middle when the turn is long
+enough to reach it, at SIZE evenly spaced times across each turn. The angle,
+angular velocity and angular acceleration tables are written to
+src/legacy_motion/SweptTurnTables.h, along with a copy of the constants they
+came from so that the firmware refuses to build against a stale table.
+
+Prints the worst case difference between the interpolated tables and the
+closed form for every turn. The acceleration steps in the middle of turns that
+are too short to reach full angular velocity, so its error there is as large
+as the step.
+
+Run again after changing any of the constants.
+
+Usage: python make_turn_tables.py [path to conf.h] [path to SweptTurnTables.h]
+'''
+
+from __future__ import print_function
+
+__license__ = 'GPLv2'
+
+import math
+import os
+import re
+import sys
+
+TURNS = ['45', '90', '135', '180']
+
+ROBOT_CONSTANTS = ['ROBOT_MASS', 'MOMENT_OF_INERTIA', 'MM_BETWEEN_WHEELS',
+                   'MAX_COEFFICIENT_FRICTION']
+
+# entries per table, odd so that the middle of the turn is an entry
+SIZE = 257
+
+# how many times finer than the table to check the interpolation
+CHECK_OVERSAMPLING = 16
+
+
+def load_constants(conf_path):
+    with open(conf_path) as conf_file:
+        conf = conf_file.read()
+
+    def define(name):
+        match = re.search(r'#define\s+%s\s+([^\s/]+)' % name, conf)
+        if not match:
+            raise ValueError('%s not found' % name)
+        return (match.group(1), float(match.group(1)))
+
+    robot = [define(name) for name in ROBOT_CONSTANTS]
+    turns = {}
+    for turn in TURNS:
+        turns[turn] = [define('SWEPT_TURN_%s_FORWARD_SPEED' % turn),
+                       define('SWEPT_TURN_%s_ANGLE' % turn)]
+
+    return robot, turns
+
+
+class ClosedForm(object):
+    '''Same derivation as SweptTurnProfile used to evaluate at run time'''
+
+    def __init__(self, robot, speed, angle_deg):
+        mass, inertia, wheel_base, friction = robot
+
+        self.turn_angle = math.radians(angle_deg)
+
+        # 1 / t0 and eta / t0 in the paper
+        self.inside_trigs = (mass * (wheel_base / 2.0 / 1000.0) * speed
+                             / inertia)
+        self.omega_max = friction * 9.81 / speed
+
+        angle_for_full_acceleration = self.omega_max / self.inside_trigs
+        if angle_for_full_acceleration > self.turn_angle / 2:
+            temp = (self.turn_angle / 2) * self.inside_trigs / self.omega_max
+            self.acceleration_duration = (math.acos(1 - temp)
+                                          / self.inside_trigs)
+            self.const_velocity_duration = 0
+        else:
+            self.acceleration_duration = (math.pi / 2) / self.inside_trigs
+            self.const_velocity_duration = (
+                (self.turn_angle - 2 * self.omega_max / self.inside_trigs)
+                / self.omega_max)
+
+        self.duration = (2 * self.acceleration_duration
+                         + self.const_velocity_duration)
+
+    def accelerating(self, t):
+        k = self.inside_trigs
+        w = self.omega_max
+        return ((1 - math.cos(k * t)) * w / k,
+                w * math.sin(k * t),
+                w * k * math.cos(k * t))
+
+    def evaluate(self, t):
+        '''Returns angle, angular velocity and angular acceleration'''
+        t = max(0, min(self.duration, t))
+        ta = self.acceleration_duration
+
+        if t <= ta:
+            return self.accelerating(t)
+        elif t <= ta + self.const_velocity_duration:
+            angle, velocity, _ = self.accelerating(ta)
+            return (angle + velocity * (t - ta), velocity, 0)
+        else:
+            angle, velocity, accel = self.accelerating(self.duration - t)
+            return (self.turn_angle - angle, velocity, -accel)
+
+
+def interpolate(table, step, t):
+    # same as SweptTurnProfile
+    position = t / step
+    if position <= 0:
+        return table[0]
+    if position >= len(table) - 1:
+        return table[-1]
+    index = int(position)
+    fraction = position - index
+    return table[index] + (table[index + 1] - table[index]) * fraction
+
+
+def format_table(name, values):
+    lines = ['static constexpr float %s[SWEPT_TURN_TABLE_SIZE] = {' % name]
+    for i in range(0, len(values), 6):
+        lines.append('  ' + ', '.join('%.9g' % v for v in values[i:i + 6])
+                     + ',')
+    lines.append('};')
+    return lines
+
+
+def main(conf_path, header_path):
+    robot, turns = load_constants(conf_path)
+    robot_values = [value for _, value in robot]
+
+    lines = [
+        '#ifndef SWEPT_TURN_TABLES_H',
+        '#define SWEPT_TURN_TABLES_H',
+        '',
+        '// Generated by tools/make_turn_tables.py from conf.h, do not edit',
+        '',
+        '// Angle in radians, angular velocity in rad/s and angular',
+        '// acceleration in rad/s/s at SWEPT_TURN_TABLE_SIZE evenly spaced',
+        '// times from 0 to the duration of the turn in seconds',
+        '#define SWEPT_TURN_TABLE_SIZE %d' % SIZE,
+        '',
+        '#define SWEPT_TURN_TABLE_SOURCE { %s }'
+        % ', '.join(text for text, _ in robot),
+        '',
+    ]
+
+    for turn in TURNS:
+        (speed_text, speed), (angle_text, angle) = turns[turn]
+        profile = ClosedForm(robot_values, speed, angle)
+        step = profile.duration / (SIZE - 1)
+
+        samples = [profile.evaluate(i * step) for i in range(SIZE)]
+        tables = [[sample[j] for sample in samples] for j in range(3)]
+
+        worst = [0, 0, 0]
+        for i in range((SIZE - 1) * CHECK_OVERSAMPLING + 1):
+            t = i * step / CHECK_OVERSAMPLING
+            exact = profile.evaluate(t)
+            for j in range(3):
+                worst[j] = max(worst[j],
+                               abs(interpolate(tables[j], step, t) - exact[j]))
+
+        print('%s: %.4f s, max error %.2g deg, %.2g rad/s, %.2g rad/s/s'
+              % (turn, profile.duration, math.degrees(worst[0]), worst[1],
+                 worst[2]))
+
+        prefix = 'SWEPT_TURN_%s' % turn
+        lines.append('#define %s_TABLE_SOURCE { %s, %s }'
+                     % (prefix, speed_text, angle_text))
+        lines.append('#define %s_DURATION %.9g' % (prefix, profile.duration))
+        lines.extend(format_table(prefix + '_ANGLE_TABLE', tables[0]))
+        lines.extend(format_table(prefix + '_VELOCITY_TABLE', tables[1]))
+        lines.extend(format_table(prefix + '_ACCEL_TABLE', tables[2]))
+        lines.append('')
+
+    lines.append('#endif')
+
+    with open(header_path, 'w') as header:
+        header.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+    conf_path = os.path.join(root, 'src', 'conf.h')
+    header_path = os.path.join(root, 'src', 'legacy_motion',
+                               'SweptTurnTables.h')
+
+    if len(sys.argv) > 1:
+        conf_path = sys.argv[1]
+    if len(sys.argv) > 2:
+        header_path = sys.argv[2]
+
+    main(conf_path, header_path)
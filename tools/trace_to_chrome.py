@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+
+'''
+Script for turning a trace dump into a Chrome trace file
+
+With TRACE_ENABLED set to true in Trace.h, the TRCE entry of the options menu
+writes the event timeline to the USB serial port as text (see Trace.h).
+Capture it to a file, for example
+
+    cat /dev/ttyACM0 > run.txt
+
+and convert it with this script. Open the result in chrome://tracing or at
+ui.perfetto.dev. Anything before the header line is skipped, so the capture
+can start early.
+
+Ends that come before their begin, because the begin was pushed out of the
+ring, are dropped. The argument of each event is shown in its args, and for
+segment events it is the motion type character sent to the logger.
+
+Usage: python trace_to_chrome.py <dump file name> [json file name]
+'''
+
+from __future__ import print_function
+
+__license__ = 'GPLv2'
+
+import json
+import sys
+
+HEADER = 'time\tphase\tname\targ'
+
+# events whose argument is a character
+CHARACTER_ARGS = set(['segment'])
+
+def read_events(lines):
+    '''Returns the events in a dump as (time, phase, name, arg) tuples, and
+    the number of events the robot dropped'''
+    lines = iter(lines)
+    for line in lines:
+        if line.rstrip('\r\n') == HEADER:
+            break
+    else:
+        raise ValueError('no trace dump found')
+
+    events = []
+    dropped = 0
+    for line in lines:
+        fields = line.rstrip('\r\n').split('\t')
+        if len(fields) == 4:
+            time, phase, name, arg = fields
+            events.append((int(time), phase, name, int(arg)))
+        elif fields[0].startswith('dropped '):
+            dropped = int(fields[0].split()[1])
+            break
+        else:
+            break
+    return events, dropped
+
+def to_chrome(events):
+    '''Returns a list of Chrome trace events, with times in microseconds from
+    the first event'''
+    trace = []
+    open_names = []
+    first_time = None
+    for time, phase, name, arg in events:
+        if first_time is None:
+            first_time = time
+        # micros() wraps around every 71 minutes
+        elapsed = (time - first_time) & 0xffffffff
+
+        if phase == 'E':
+            if name not in open_names:
+                continue
+            open_names.remove(name)
+        elif phase == 'B':
+            open_names.append(name)
+
+        event = {'name': name, 'ph': phase, 'ts': elapsed, 'pid': 1, 'tid': 1}
+        if phase == 'i':
+            event['s'] = 't'
+        if phase != 'E':
+            event['args'] = {'arg': chr(arg) if name in CHARACTER_ARGS
+                                    else arg}
+        trace.append(event)
+    return trace
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    with open(sys.argv[1]) as f:
+        events, dropped = read_events(f)
+
+    if dropped:
+        print('%d older events were dropped on the robot' % dropped,
+              file=sys.stderr)
+
+    out = open(sys.argv[2], 'w') if len(sys.argv) > 2 else sys.stdout
+    json.dump({'traceEvents': to_chrome(events), 'displayTimeUnit': 'ms'},
+              out, indent=1)
+    print(file=out)
+    if out is not sys.stdout:
+        out.close()
+
+if __name__ == '__main__':
+    main()